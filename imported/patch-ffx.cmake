@@ -24,6 +24,7 @@
 # Patches:
 # - Update Microsoft Agility SDK to 714
 # - patch camera component to allow for custom implementation
+# - let other render modules draw inside the raster pass of GBufferRenderModule
 
 # Update Agility SDK
 include(update-agilitysdk.cmake)
@@ -43,3 +44,71 @@ execute_process(COMMAND "${GIT_EXECUTABLE}" apply "${CMAKE_CURRENT_SOURCE_DIR}/d
                 WORKING_DIRECTORY "${FFX_ROOT}"
                 #ERROR_QUIET
                 OUTPUT_STRIP_TRAILING_WHITESPACE)
+
+message(STATUS "Patching GBuffer raster pass callback")
+# Add a callback to GBufferRenderModule, which is invoked inside its raster pass after all opaque geometry was drawn.
+# IvyRenderModule draws the generated ivy through it into the bound GBuffer targets, see IvyRenderModule::ExecuteGBufferPass.
+# The sources are edited in place, as the callback is inserted relative to EndRaster; files which already contain the callback are skipped.
+set(GBUFFER_RENDERMODULE_ROOT "${FFX_ROOT}/framework/rendermodules/gbuffer")
+
+file(READ "${GBUFFER_RENDERMODULE_ROOT}/gbufferrendermodule.h" GBUFFER_HEADER)
+string(FIND "${GBUFFER_HEADER}" "m_RasterPassCallback" GBUFFER_HEADER_PATCHED)
+if (GBUFFER_HEADER_PATCHED EQUAL -1)
+    string(FIND "${GBUFFER_HEADER}" "#pragma once\n" GBUFFER_PRAGMA_POSITION)
+    string(REGEX MATCH "class GBufferRenderModule[^{;]*{" GBUFFER_CLASS "${GBUFFER_HEADER}")
+    if ((GBUFFER_PRAGMA_POSITION EQUAL -1) OR (GBUFFER_CLASS STREQUAL ""))
+        message(FATAL_ERROR "Failed to patch gbufferrendermodule.h!")
+    endif()
+
+    string(REPLACE "#pragma once\n" "#pragma once\n\n#include <functional>\n" GBUFFER_HEADER "${GBUFFER_HEADER}")
+    string(REPLACE "${GBUFFER_CLASS}" "${GBUFFER_CLASS}
+public:
+    /**
+     * @brief   Sets a callback invoked inside the raster pass after all opaque geometry was drawn.
+     */
+    void SetRasterPassCallback(std::function<void(double, cauldron::CommandList*)> callback) { m_RasterPassCallback = callback; }
+
+private:
+    std::function<void(double, cauldron::CommandList*)> m_RasterPassCallback;
+" GBUFFER_HEADER "${GBUFFER_HEADER}")
+
+    file(WRITE "${GBUFFER_RENDERMODULE_ROOT}/gbufferrendermodule.h" "${GBUFFER_HEADER}")
+endif()
+
+file(READ "${GBUFFER_RENDERMODULE_ROOT}/gbufferrendermodule.cpp" GBUFFER_SOURCE)
+string(FIND "${GBUFFER_SOURCE}" "m_RasterPassCallback" GBUFFER_SOURCE_PATCHED)
+if (GBUFFER_SOURCE_PATCHED EQUAL -1)
+    # Parameter names of Execute are passed on to the callback
+    string(REGEX MATCH "void GBufferRenderModule::Execute\\(double[ ]+([A-Za-z_]+),[ ]*(cauldron::)?CommandList\\*[ ]*([A-Za-z_]+)\\)" GBUFFER_EXECUTE "${GBUFFER_SOURCE}")
+    if (GBUFFER_EXECUTE STREQUAL "")
+        message(FATAL_ERROR "Failed to patch gbufferrendermodule.cpp! GBufferRenderModule::Execute not found.")
+    endif()
+    set(GBUFFER_DELTA_TIME "${CMAKE_MATCH_1}")
+    set(GBUFFER_COMMAND_LIST "${CMAKE_MATCH_3}")
+
+    # Callback is inserted in front of the line ending the raster pass of Execute
+    string(FIND "${GBUFFER_SOURCE}" "${GBUFFER_EXECUTE}" GBUFFER_EXECUTE_POSITION)
+    string(SUBSTRING "${GBUFFER_SOURCE}" ${GBUFFER_EXECUTE_POSITION} -1 GBUFFER_EXECUTE_BODY)
+    string(FIND "${GBUFFER_EXECUTE_BODY}" "EndRaster(" GBUFFER_END_RASTER_OFFSET)
+    if (GBUFFER_END_RASTER_OFFSET EQUAL -1)
+        message(FATAL_ERROR "Failed to patch gbufferrendermodule.cpp! EndRaster not found in GBufferRenderModule::Execute.")
+    endif()
+    math(EXPR GBUFFER_END_RASTER_POSITION "${GBUFFER_EXECUTE_POSITION} + ${GBUFFER_END_RASTER_OFFSET}")
+
+    string(SUBSTRING "${GBUFFER_SOURCE}" 0 ${GBUFFER_END_RASTER_POSITION} GBUFFER_SOURCE_BEGIN)
+    string(SUBSTRING "${GBUFFER_SOURCE}" ${GBUFFER_END_RASTER_POSITION} -1 GBUFFER_SOURCE_END)
+    string(FIND "${GBUFFER_SOURCE_BEGIN}" "\n" GBUFFER_LINE_POSITION REVERSE)
+    math(EXPR GBUFFER_LINE_POSITION "${GBUFFER_LINE_POSITION} + 1")
+    string(SUBSTRING "${GBUFFER_SOURCE_BEGIN}" ${GBUFFER_LINE_POSITION} -1 GBUFFER_INDENT)
+    string(SUBSTRING "${GBUFFER_SOURCE_BEGIN}" 0 ${GBUFFER_LINE_POSITION} GBUFFER_SOURCE_BEGIN)
+
+    set(GBUFFER_SOURCE "${GBUFFER_SOURCE_BEGIN}${GBUFFER_INDENT}// Let other render modules draw into the bound targets, see SetRasterPassCallback
+${GBUFFER_INDENT}if (m_RasterPassCallback)
+${GBUFFER_INDENT}{
+${GBUFFER_INDENT}    m_RasterPassCallback(${GBUFFER_DELTA_TIME}, ${GBUFFER_COMMAND_LIST});
+${GBUFFER_INDENT}}
+
+${GBUFFER_INDENT}${GBUFFER_SOURCE_END}")
+
+    file(WRITE "${GBUFFER_RENDERMODULE_ROOT}/gbufferrendermodule.cpp" "${GBUFFER_SOURCE}")
+endif()
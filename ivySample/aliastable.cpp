@@ -0,0 +1,96 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "aliastable.h"
+
+std::vector<AliasTableEntry> BuildAliasTable(const std::vector<float>& weights)
+{
+    const uint32_t count = static_cast<uint32_t>(weights.size());
+
+    double weightSum = 0.0;
+    for (const float weight : weights)
+    {
+        weightSum += weight;
+    }
+
+    if ((count == 0) || !(weightSum > 0.0))
+    {
+        return {};
+    }
+
+    std::vector<AliasTableEntry> table(count);
+
+    // Weights scaled such that the average column has a probability of one
+    std::vector<double> scaledWeights(count);
+
+    // Work lists of columns with less (small) or at least (large) average probability
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    small.reserve(count);
+    large.reserve(count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        scaledWeights[i] = weights[i] * (count / weightSum);
+
+        if (scaledWeights[i] < 1.0)
+        {
+            small.push_back(i);
+        }
+        else
+        {
+            large.push_back(i);
+        }
+    }
+
+    // Fill every small column with the remaining probability of a large column
+    while (!small.empty() && !large.empty())
+    {
+        const uint32_t smallIndex = small.back();
+        const uint32_t largeIndex = large.back();
+        small.pop_back();
+
+        table[smallIndex].probability = static_cast<float>(scaledWeights[smallIndex]);
+        table[smallIndex].alias       = largeIndex;
+
+        scaledWeights[largeIndex] = (scaledWeights[largeIndex] + scaledWeights[smallIndex]) - 1.0;
+
+        if (scaledWeights[largeIndex] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(largeIndex);
+        }
+    }
+
+    // Remaining columns are (up to rounding errors) full
+    for (const uint32_t index : large)
+    {
+        table[index].probability = 1.f;
+        table[index].alias       = index;
+    }
+    for (const uint32_t index : small)
+    {
+        table[index].probability = 1.f;
+        table[index].alias       = index;
+    }
+
+    return table;
+}
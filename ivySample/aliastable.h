@@ -0,0 +1,39 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct AliasTableEntry
+{
+    // Probability of keeping the sampled column; otherwise alias is chosen
+    float    probability;
+    uint32_t alias;
+};
+
+/**
+ * @brief   Builds a Walker alias table for sampling indices proportional to the given weights in O(1).
+ *          Uses Vose's construction, which runs in O(n) and is numerically stable.
+ *          Returns an empty table if the weights don't sum up to a positive value.
+ */
+std::vector<AliasTableEntry> BuildAliasTable(const std::vector<float>& weights);
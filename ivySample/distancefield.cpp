@@ -0,0 +1,351 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "distancefield.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace
+{
+    struct Float3
+    {
+        float x, y, z;
+    };
+
+    Float3 operator+(const Float3& a, const Float3& b)
+    {
+        return {a.x + b.x, a.y + b.y, a.z + b.z};
+    }
+
+    Float3 operator-(const Float3& a, const Float3& b)
+    {
+        return {a.x - b.x, a.y - b.y, a.z - b.z};
+    }
+
+    Float3 operator*(const Float3& a, float b)
+    {
+        return {a.x * b, a.y * b, a.z * b};
+    }
+
+    float Dot(const Float3& a, const Float3& b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    // Closest point on triangle abc to p, see Ericson, Real-Time Collision Detection, 5.1.5
+    Float3 ClosestPointOnTriangle(const Float3& p, const Float3& a, const Float3& b, const Float3& c)
+    {
+        const Float3 ab = b - a;
+        const Float3 ac = c - a;
+        const Float3 ap = p - a;
+
+        const float d1 = Dot(ab, ap);
+        const float d2 = Dot(ac, ap);
+        if ((d1 <= 0.f) && (d2 <= 0.f))
+        {
+            return a;
+        }
+
+        const Float3 bp = p - b;
+        const float  d3 = Dot(ab, bp);
+        const float  d4 = Dot(ac, bp);
+        if ((d3 >= 0.f) && (d4 <= d3))
+        {
+            return b;
+        }
+
+        const float vc = d1 * d4 - d3 * d2;
+        if ((vc <= 0.f) && (d1 >= 0.f) && (d3 <= 0.f))
+        {
+            return a + ab * (d1 / (d1 - d3));
+        }
+
+        const Float3 cp = p - c;
+        const float  d5 = Dot(ab, cp);
+        const float  d6 = Dot(ac, cp);
+        if ((d6 >= 0.f) && (d5 <= d6))
+        {
+            return c;
+        }
+
+        const float vb = d5 * d2 - d1 * d6;
+        if ((vb <= 0.f) && (d2 >= 0.f) && (d6 <= 0.f))
+        {
+            return a + ac * (d2 / (d2 - d6));
+        }
+
+        const float va = d3 * d6 - d5 * d4;
+        if ((va <= 0.f) && ((d4 - d3) >= 0.f) && ((d5 - d6) >= 0.f))
+        {
+            return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+        }
+
+        const float denominator = 1.f / (va + vb + vc);
+        return a + ab * (vb * denominator) + ac * (vc * denominator);
+    }
+
+    Float3 GetVertex(const std::vector<float>& triangleVertices, size_t triangleIndex, size_t vertexIndex)
+    {
+        const float* vertex = triangleVertices.data() + triangleIndex * 9 + vertexIndex * 3;
+        return {vertex[0], vertex[1], vertex[2]};
+    }
+}  // namespace
+
+SparseDistanceField BakeSparseDistanceField(const std::vector<float>& triangleVertices, uint32_t threadCount)
+{
+    SparseDistanceField field;
+
+    const size_t triangleCount = triangleVertices.size() / 9;
+
+    if (triangleCount == 0)
+    {
+        return field;
+    }
+
+    // Bounds of all triangles, extended such that every surface is at least IVY_SDF_EMPTY_BRICK_MARGIN inside
+    float boundsMin[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+    float boundsMax[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+    {
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            boundsMin[axis] = std::min(boundsMin[axis], triangleVertices[i * 3 + axis]);
+            boundsMax[axis] = std::max(boundsMax[axis], triangleVertices[i * 3 + axis]);
+        }
+    }
+
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+        field.boundsMin[axis]     = boundsMin[axis] - IVY_SDF_EMPTY_BRICK_MARGIN;
+        field.brickGridSize[axis] = static_cast<uint32_t>(std::ceil((boundsMax[axis] + IVY_SDF_EMPTY_BRICK_MARGIN - field.boundsMin[axis]) / IVY_SDF_BRICK_EXTENT));
+        field.brickGridSize[axis] = std::max(field.brickGridSize[axis], 1u);
+    }
+
+    const size_t cellCount = static_cast<size_t>(field.brickGridSize[0]) * field.brickGridSize[1] * field.brickGridSize[2];
+
+    const auto GetCellIndex = [&](uint32_t x, uint32_t y, uint32_t z) { return (static_cast<size_t>(z) * field.brickGridSize[1] + y) * field.brickGridSize[0] + x; };
+
+    // Calls function(cellIndex) for every cell whose bounds are within IVY_SDF_MAX_DISTANCE of the bounds of a triangle
+    const auto ForEachCandidateCell = [&](size_t triangleIndex, const auto& function) {
+        uint32_t cellMin[3], cellMax[3];
+
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            const float* vertex = triangleVertices.data() + triangleIndex * 9 + axis;
+
+            const float triangleMin = std::min({vertex[0], vertex[3], vertex[6]}) - IVY_SDF_MAX_DISTANCE - field.boundsMin[axis];
+            const float triangleMax = std::max({vertex[0], vertex[3], vertex[6]}) + IVY_SDF_MAX_DISTANCE - field.boundsMin[axis];
+
+            cellMin[axis] = static_cast<uint32_t>(std::max(std::floor(triangleMin / IVY_SDF_BRICK_EXTENT), 0.f));
+            cellMax[axis] = std::min(static_cast<uint32_t>(std::max(std::floor(triangleMax / IVY_SDF_BRICK_EXTENT), 0.f)), field.brickGridSize[axis] - 1);
+        }
+
+        for (uint32_t z = cellMin[2]; z <= cellMax[2]; ++z)
+        {
+            for (uint32_t y = cellMin[1]; y <= cellMax[1]; ++y)
+            {
+                for (uint32_t x = cellMin[0]; x <= cellMax[0]; ++x)
+                {
+                    function(GetCellIndex(x, y, z));
+                }
+            }
+        }
+    };
+
+    // Bin triangles into candidate cells (compressed rows: count, prefix sum, fill)
+    std::vector<uint32_t> cellTriangleOffsets(cellCount + 1, 0);
+
+    for (size_t i = 0; i < triangleCount; ++i)
+    {
+        ForEachCandidateCell(i, [&](size_t cellIndex) { ++cellTriangleOffsets[cellIndex + 1]; });
+    }
+
+    for (size_t i = 0; i < cellCount; ++i)
+    {
+        cellTriangleOffsets[i + 1] += cellTriangleOffsets[i];
+    }
+
+    std::vector<uint32_t> cellTriangles(cellTriangleOffsets[cellCount]);
+    std::vector<uint32_t> cellFillCounts(cellCount, 0);
+
+    for (size_t i = 0; i < triangleCount; ++i)
+    {
+        ForEachCandidateCell(i, [&](size_t cellIndex) {
+            cellTriangles[cellTriangleOffsets[cellIndex] + cellFillCounts[cellIndex]++] = static_cast<uint32_t>(i);
+        });
+    }
+
+    cellFillCounts.clear();
+    cellFillCounts.shrink_to_fit();
+
+    std::vector<uint32_t> candidateCells;
+    for (size_t i = 0; i < cellCount; ++i)
+    {
+        if (cellTriangleOffsets[i + 1] > cellTriangleOffsets[i])
+        {
+            candidateCells.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    field.brickIndices.assign(cellCount, IVY_SDF_EMPTY_BRICK);
+
+    // Every point inside a brick is at most half a voxel diagonal away from one of its samples.
+    // Bricks whose samples are all further away than this from any surface thus keep all points at least IVY_SDF_EMPTY_BRICK_MARGIN away.
+    const float brickThreshold = IVY_SDF_EMPTY_BRICK_MARGIN + 0.5f * std::sqrt(3.f) * IVY_SDF_VOXEL_SIZE;
+
+    std::atomic<size_t> nextCandidate = 0;
+    std::mutex          brickMutex;
+
+    const auto BakeBricks = [&]() {
+        std::vector<uint8_t> samples(IVY_SDF_BRICK_SAMPLES * IVY_SDF_BRICK_SAMPLES * IVY_SDF_BRICK_SAMPLES);
+
+        for (size_t candidate = nextCandidate++; candidate < candidateCells.size(); candidate = nextCandidate++)
+        {
+            const uint32_t cellIndex = candidateCells[candidate];
+            const uint32_t cellX     = cellIndex % field.brickGridSize[0];
+            const uint32_t cellY     = (cellIndex / field.brickGridSize[0]) % field.brickGridSize[1];
+            const uint32_t cellZ     = cellIndex / (field.brickGridSize[0] * field.brickGridSize[1]);
+
+            const Float3 brickOrigin = {field.boundsMin[0] + cellX * IVY_SDF_BRICK_EXTENT,
+                                        field.boundsMin[1] + cellY * IVY_SDF_BRICK_EXTENT,
+                                        field.boundsMin[2] + cellZ * IVY_SDF_BRICK_EXTENT};
+
+            float minDistance = FLT_MAX;
+
+            for (uint32_t z = 0; z < IVY_SDF_BRICK_SAMPLES; ++z)
+            {
+                for (uint32_t y = 0; y < IVY_SDF_BRICK_SAMPLES; ++y)
+                {
+                    for (uint32_t x = 0; x < IVY_SDF_BRICK_SAMPLES; ++x)
+                    {
+                        const Float3 position = brickOrigin + Float3{float(x), float(y), float(z)} * IVY_SDF_VOXEL_SIZE;
+
+                        // Triangles further away than IVY_SDF_MAX_DISTANCE aren't binned, thus clamping keeps the distance conservative
+                        float distanceSquared = IVY_SDF_MAX_DISTANCE * IVY_SDF_MAX_DISTANCE;
+
+                        for (uint32_t i = cellTriangleOffsets[cellIndex]; i < cellTriangleOffsets[cellIndex + 1]; ++i)
+                        {
+                            const uint32_t triangle = cellTriangles[i];
+                            const Float3   closest  = ClosestPointOnTriangle(position,
+                                                                          GetVertex(triangleVertices, triangle, 0),
+                                                                          GetVertex(triangleVertices, triangle, 1),
+                                                                          GetVertex(triangleVertices, triangle, 2));
+                            const Float3   offset   = position - closest;
+
+                            distanceSquared = std::min(distanceSquared, Dot(offset, offset));
+                        }
+
+                        const float distance = std::sqrt(distanceSquared);
+                        minDistance          = std::min(minDistance, distance);
+
+                        // Round down to keep quantized distances conservative
+                        samples[(z * IVY_SDF_BRICK_SAMPLES + y) * IVY_SDF_BRICK_SAMPLES + x] =
+                            static_cast<uint8_t>(std::floor(distance / IVY_SDF_MAX_DISTANCE * 255.f));
+                    }
+                }
+            }
+
+            if (minDistance > brickThreshold)
+            {
+                continue;
+            }
+
+            std::lock_guard<std::mutex> lock(brickMutex);
+
+            const size_t brickIndex = field.brickData.size() / IVY_SDF_BRICK_WORD_COUNT;
+
+            field.brickIndices[cellIndex] = static_cast<uint32_t>(brickIndex);
+            field.brickData.resize(field.brickData.size() + IVY_SDF_BRICK_WORD_COUNT);
+            memcpy(field.brickData.data() + brickIndex * IVY_SDF_BRICK_WORD_COUNT, samples.data(), samples.size());
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (uint32_t i = 1; i < std::max(threadCount, 1u); ++i)
+    {
+        workers.emplace_back(BakeBricks);
+    }
+
+    BakeBricks();
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    // Chessboard distance of empty cells to the nearest brick, by breadth-first search from all bricks
+    std::vector<uint32_t> cellDistances(cellCount, UINT32_MAX);
+    std::queue<size_t>    cellQueue;
+
+    for (size_t i = 0; i < cellCount; ++i)
+    {
+        if ((field.brickIndices[i] & IVY_SDF_EMPTY_BRICK) == 0)
+        {
+            cellDistances[i] = 0;
+            cellQueue.push(i);
+        }
+    }
+
+    while (!cellQueue.empty())
+    {
+        const size_t   cellIndex = cellQueue.front();
+        const uint32_t cellX     = cellIndex % field.brickGridSize[0];
+        const uint32_t cellY     = (cellIndex / field.brickGridSize[0]) % field.brickGridSize[1];
+        const uint32_t cellZ     = static_cast<uint32_t>(cellIndex / (field.brickGridSize[0] * field.brickGridSize[1]));
+        cellQueue.pop();
+
+        for (int32_t z = std::max(int32_t(cellZ) - 1, 0); z <= std::min(int32_t(cellZ) + 1, int32_t(field.brickGridSize[2]) - 1); ++z)
+        {
+            for (int32_t y = std::max(int32_t(cellY) - 1, 0); y <= std::min(int32_t(cellY) + 1, int32_t(field.brickGridSize[1]) - 1); ++y)
+            {
+                for (int32_t x = std::max(int32_t(cellX) - 1, 0); x <= std::min(int32_t(cellX) + 1, int32_t(field.brickGridSize[0]) - 1); ++x)
+                {
+                    const size_t neighborIndex = GetCellIndex(x, y, z);
+
+                    if (cellDistances[neighborIndex] == UINT32_MAX)
+                    {
+                        cellDistances[neighborIndex] = cellDistances[cellIndex] + 1;
+                        cellQueue.push(neighborIndex);
+                    }
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < cellCount; ++i)
+    {
+        if (field.brickIndices[i] & IVY_SDF_EMPTY_BRICK)
+        {
+            // Without any brick, all cells are infinitely far away from surfaces
+            field.brickIndices[i] = IVY_SDF_EMPTY_BRICK | std::min(cellDistances[i], ~IVY_SDF_EMPTY_BRICK);
+        }
+    }
+
+    return field;
+}
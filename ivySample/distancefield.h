@@ -0,0 +1,45 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "shaders/ivycommon.h"
+
+#include <cstdint>
+#include <vector>
+
+// Unsigned distance field of the scene in a sparse brick layout, see IVY_SDF_*.
+// Only bricks near surfaces store distances; empty bricks only store a conservative distance to the nearest brick.
+struct SparseDistanceField
+{
+    float    boundsMin[3]     = {};
+    uint32_t brickGridSize[3] = {};
+
+    // One entry per brick grid cell, x fastest
+    std::vector<uint32_t> brickIndices;
+    // IVY_SDF_BRICK_WORD_COUNT words per brick
+    std::vector<uint32_t> brickData;
+};
+
+/**
+ * @brief   Voxelizes world-space triangles (nine floats per triangle) into a sparse distance field, using threadCount worker threads.
+ */
+SparseDistanceField BakeSparseDistanceField(const std::vector<float>& triangleVertices, uint32_t threadCount);
@@ -0,0 +1,196 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "hitcache.h"
+
+#include "misc/assert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace cauldron;
+
+// Same as Hash(uint) in utils.hlsl
+static uint32_t Hash(uint32_t seed)
+{
+    seed = (seed ^ 61u) ^ (seed >> 16u);
+    seed *= 9u;
+    seed = seed ^ (seed >> 4u);
+    seed *= 0x27d4eb2du;
+    seed = seed ^ (seed >> 15u);
+    return seed;
+}
+
+// Same as CombineSeed in utils.hlsl
+static uint32_t CombineSeed(uint32_t a, uint32_t b)
+{
+    return a ^ (Hash(b) + 0x9e3779b9 + (a << 6) + (a >> 2));
+}
+
+static uint32_t CombineSeed(uint32_t a, uint32_t b, uint32_t c)
+{
+    return CombineSeed(CombineSeed(a, b), c);
+}
+
+static uint32_t CombineSeed(uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+{
+    return CombineSeed(CombineSeed(a, b), c, d);
+}
+
+static uint32_t AsUint(float value)
+{
+    uint32_t result;
+    memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+// Same as Hash(float3) in utils.hlsl
+static uint32_t Hash(const float vec[3])
+{
+    return CombineSeed(Hash(AsUint(vec[0])), Hash(AsUint(vec[1])), Hash(AsUint(vec[2])));
+}
+
+// Same as GetHitCacheDirectionBin in hitcache.hlsl
+static uint32_t GetDirectionBin(const Vec3& direction)
+{
+    const float length = std::abs(direction.getX()) + std::abs(direction.getY()) + std::abs(direction.getZ());
+
+    float x = direction.getX() / length;
+    float y = direction.getY() / length;
+
+    if (direction.getZ() < 0)
+    {
+        const float foldedX = (1.f - std::abs(y)) * (x >= 0 ? 1.f : -1.f);
+        const float foldedY = (1.f - std::abs(x)) * (y >= 0 ? 1.f : -1.f);
+
+        x = foldedX;
+        y = foldedY;
+    }
+
+    const uint32_t binX = std::min(static_cast<uint32_t>((x * 0.5f + 0.5f) * IVY_HIT_CACHE_DIRECTION_RESOLUTION), IVY_HIT_CACHE_DIRECTION_RESOLUTION - 1u);
+    const uint32_t binY = std::min(static_cast<uint32_t>((y * 0.5f + 0.5f) * IVY_HIT_CACHE_DIRECTION_RESOLUTION), IVY_HIT_CACHE_DIRECTION_RESOLUTION - 1u);
+
+    return binX + binY * IVY_HIT_CACHE_DIRECTION_RESOLUTION;
+}
+
+// Same as GetHitCacheKey in hitcache.hlsl
+static uint32_t GetKey(const Vec3& origin, const Vec3& direction, float tMax, uint32_t epoch)
+{
+    const int32_t cellX = static_cast<int32_t>(std::floor(origin.getX() / IVY_HIT_CACHE_CELL_SIZE));
+    const int32_t cellY = static_cast<int32_t>(std::floor(origin.getY() / IVY_HIT_CACHE_CELL_SIZE));
+    const int32_t cellZ = static_cast<int32_t>(std::floor(origin.getZ() / IVY_HIT_CACHE_CELL_SIZE));
+
+    const uint32_t cellKey = CombineSeed(Hash(static_cast<uint32_t>(cellX)), static_cast<uint32_t>(cellY), static_cast<uint32_t>(cellZ));
+    const uint32_t key     = CombineSeed(cellKey, GetDirectionBin(direction), AsUint(tMax), epoch);
+
+    // zero marks empty entries
+    return key | 1;
+}
+
+// Same as GetHitCacheChecksum in hitcache.hlsl
+static uint32_t GetChecksum(const IvyHitCacheEntry& entry)
+{
+    return CombineSeed(entry.key, Hash(entry.position), Hash(entry.normal));
+}
+
+HitCache::HitCache(uint32_t capacity)
+    : m_Entries(capacity, IvyHitCacheEntry{})
+{
+    // Slots are computed by masking the key hash
+    CauldronAssert(ASSERT_CRITICAL, (capacity & (capacity - 1)) == 0, L"Hit cache capacity must be a power of two.");
+}
+
+bool HitCache::Lookup(const Vec3& origin, const Vec3& direction, float tMax, uint32_t epoch, bool& hit, Vec3& hitPosition, Vec3& hitNormal)
+{
+    const uint32_t key  = GetKey(origin, direction, tMax, epoch);
+    const uint32_t slot = Hash(key) & (static_cast<uint32_t>(m_Entries.size()) - 1);
+
+    const IvyHitCacheEntry& entry = m_Entries[slot];
+
+    ++m_LookupCount;
+
+    if ((entry.key != key) || (entry.checksum != GetChecksum(entry)))
+    {
+        return false;
+    }
+
+    ++m_HitCount;
+
+    hit = (entry.normal[0] != 0.f) || (entry.normal[1] != 0.f) || (entry.normal[2] != 0.f);
+
+    hitPosition = hit ? Vec3(entry.position[0], entry.position[1], entry.position[2]) : origin + direction * tMax;
+    hitNormal   = hit ? Vec3(entry.normal[0], entry.normal[1], entry.normal[2]) : Vec3(0, 1, 0);
+
+    return true;
+}
+
+void HitCache::Insert(const Vec3& origin, const Vec3& direction, float tMax, uint32_t epoch, bool hit, const Vec3& hitPosition, const Vec3& hitNormal)
+{
+    const uint32_t key  = GetKey(origin, direction, tMax, epoch);
+    const uint32_t slot = Hash(key) & (static_cast<uint32_t>(m_Entries.size()) - 1);
+
+    IvyHitCacheEntry entry = {};
+    entry.key              = key;
+    entry.position[0]      = hitPosition.getX();
+    entry.position[1]      = hitPosition.getY();
+    entry.position[2]      = hitPosition.getZ();
+    entry.normal[0]        = hit ? hitNormal.getX() : 0.f;
+    entry.normal[1]        = hit ? hitNormal.getY() : 0.f;
+    entry.normal[2]        = hit ? hitNormal.getZ() : 0.f;
+    entry.checksum         = GetChecksum(entry);
+
+    m_Entries[slot] = entry;
+}
+
+void HitCache::Load(const IvyHitCacheEntry* pEntries, size_t entryCount)
+{
+    CauldronAssert(ASSERT_CRITICAL, entryCount == m_Entries.size(), L"Hit cache capacity mismatch.");
+
+    std::copy(pEntries, pEntries + entryCount, m_Entries.begin());
+}
+
+HitCacheOccupancy HitCache::GetOccupancy() const
+{
+    HitCacheOccupancy occupancy;
+
+    for (const auto& entry : m_Entries)
+    {
+        if (entry.key == 0)
+        {
+            ++occupancy.emptyEntryCount;
+        }
+        else if (entry.checksum != GetChecksum(entry))
+        {
+            ++occupancy.tornEntryCount;
+        }
+        else if ((entry.normal[0] != 0.f) || (entry.normal[1] != 0.f) || (entry.normal[2] != 0.f))
+        {
+            ++occupancy.hitEntryCount;
+        }
+        else
+        {
+            ++occupancy.missEntryCount;
+        }
+    }
+
+    return occupancy;
+}
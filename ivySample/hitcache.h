@@ -0,0 +1,74 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "shaders/ivycommon.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Occupancy of a hit cache
+struct HitCacheOccupancy
+{
+    uint32_t emptyEntryCount = 0;
+    uint32_t hitEntryCount   = 0;
+    uint32_t missEntryCount  = 0;
+    // Entries whose checksum doesn't match, e.g. because two GPU threads wrote the same entry concurrently
+    uint32_t tornEntryCount  = 0;
+};
+
+// CPU implementation of the spatial hit cache used by IvyBranch, see hitcache.hlsl.
+// Keys, slots & checksums are computed the same way as on the GPU, thus it can also inspect a cache read back from the GPU.
+// Float rounding of GPU & CPU can differ, thus rays very close to a cell or direction bin border might map to different keys.
+class HitCache
+{
+public:
+    HitCache(uint32_t capacity = IVY_HIT_CACHE_CAPACITY);
+
+    /**
+     * @brief   Looks up the cached result of a ray. Returns false if no ray with the same origin cell, direction bin & tMax is cached.
+     */
+    bool Lookup(const Vec3& origin, const Vec3& direction, float tMax, uint32_t epoch, bool& hit, Vec3& hitPosition, Vec3& hitNormal);
+    /**
+     * @brief   Stores the result of a ray, replacing any ray cached in the same slot.
+     */
+    void Insert(const Vec3& origin, const Vec3& direction, float tMax, uint32_t epoch, bool hit, const Vec3& hitPosition, const Vec3& hitNormal);
+
+    /**
+     * @brief   Replaces all entries, e.g. with the contents of the GPU hit cache.
+     */
+    void Load(const IvyHitCacheEntry* pEntries, size_t entryCount);
+    /**
+     * @brief   Counts empty, hit, miss & torn entries.
+     */
+    HitCacheOccupancy GetOccupancy() const;
+
+    uint64_t GetLookupCount() const { return m_LookupCount; }
+    uint64_t GetHitCount() const { return m_HitCount; }
+
+private:
+    std::vector<IvyHitCacheEntry> m_Entries;
+
+    uint64_t m_LookupCount = 0;
+    uint64_t m_HitCount    = 0;
+};
@@ -0,0 +1,143 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "hiz.h"
+
+#include <algorithm>
+#include <cmath>
+
+uint32_t HiZPyramid::GetMipCount(uint32_t depthWidth, uint32_t depthHeight)
+{
+    uint32_t width, height;
+    GetMipSize(depthWidth, depthHeight, 0, width, height);
+
+    uint32_t mipCount = 1;
+    while ((width > 1) || (height > 1))
+    {
+        width  = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+        ++mipCount;
+    }
+
+    return mipCount;
+}
+
+void HiZPyramid::GetMipSize(uint32_t depthWidth, uint32_t depthHeight, uint32_t mip, uint32_t& width, uint32_t& height)
+{
+    width  = depthWidth;
+    height = depthHeight;
+
+    for (uint32_t level = 0; level <= mip; ++level)
+    {
+        width  = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+    }
+}
+
+// Same as DownsampleHiZ in hiz.hlsl
+void HiZPyramid::Build(const float* pDepth, uint32_t depthWidth, uint32_t depthHeight, bool invertedDepth)
+{
+    m_DepthWidth    = depthWidth;
+    m_DepthHeight   = depthHeight;
+    m_InvertedDepth = invertedDepth;
+    m_Mips.assign(GetMipCount(depthWidth, depthHeight), Mip{});
+
+    const float* pSource      = pDepth;
+    uint32_t     sourceWidth  = depthWidth;
+    uint32_t     sourceHeight = depthHeight;
+
+    for (uint32_t mip = 0; mip < m_Mips.size(); ++mip)
+    {
+        Mip& destination = m_Mips[mip];
+        GetMipSize(depthWidth, depthHeight, mip, destination.width, destination.height);
+        destination.depth.resize(destination.width * destination.height);
+
+        for (uint32_t y = 0; y < destination.height; ++y)
+        {
+            // Last row & column also cover the remaining texel of an odd-sized source
+            const uint32_t sourceBeginY = y * 2;
+            const uint32_t sourceEndY   = (y == destination.height - 1) ? sourceHeight : std::min(sourceBeginY + 2, sourceHeight);
+
+            for (uint32_t x = 0; x < destination.width; ++x)
+            {
+                const uint32_t sourceBeginX = x * 2;
+                const uint32_t sourceEndX   = (x == destination.width - 1) ? sourceWidth : std::min(sourceBeginX + 2, sourceWidth);
+
+                float depth = invertedDepth ? 1.f : 0.f;
+                for (uint32_t sourceY = sourceBeginY; sourceY < sourceEndY; ++sourceY)
+                {
+                    for (uint32_t sourceX = sourceBeginX; sourceX < sourceEndX; ++sourceX)
+                    {
+                        depth = GetFarthestDepth(depth, pSource[sourceY * sourceWidth + sourceX]);
+                    }
+                }
+
+                destination.depth[y * destination.width + x] = depth;
+            }
+        }
+
+        pSource      = destination.depth.data();
+        sourceWidth  = destination.width;
+        sourceHeight = destination.height;
+    }
+}
+
+// Same as IsHiZOccluded in common.hlsl
+bool HiZPyramid::IsOccluded(float uvMinX, float uvMinY, float uvMaxX, float uvMaxY, float nearestDepth) const
+{
+    if (m_Mips.empty())
+    {
+        return false;
+    }
+
+    // Rectangle in texels of the depth region
+    const float minX = std::clamp(uvMinX, 0.f, 1.f) * m_DepthWidth;
+    const float minY = std::clamp(uvMinY, 0.f, 1.f) * m_DepthHeight;
+    const float maxX = std::clamp(uvMaxX, 0.f, 1.f) * m_DepthWidth;
+    const float maxY = std::clamp(uvMaxY, 0.f, 1.f) * m_DepthHeight;
+
+    // Texels of mip m cover 2^(m+1) depth texels, thus the rectangle overlaps at most 2x2 texels of the selected mip
+    const float    extent = std::max(std::max(maxX - minX, maxY - minY), 1.f);
+    const uint32_t mip    = std::min(static_cast<uint32_t>(std::max(std::ceil(std::log2(extent)) - 1.f, 0.f)), GetMipCount() - 1);
+    const Mip&     level  = m_Mips[mip];
+
+    const uint32_t texelMinX = std::min(static_cast<uint32_t>(minX) >> (mip + 1), level.width - 1);
+    const uint32_t texelMinY = std::min(static_cast<uint32_t>(minY) >> (mip + 1), level.height - 1);
+    const uint32_t texelMaxX = std::min(static_cast<uint32_t>(maxX) >> (mip + 1), level.width - 1);
+    const uint32_t texelMaxY = std::min(static_cast<uint32_t>(maxY) >> (mip + 1), level.height - 1);
+
+    const float farthestDepth = GetFarthestDepth(GetFarthestDepth(GetDepth(mip, texelMinX, texelMinY), GetDepth(mip, texelMaxX, texelMinY)),
+                                                 GetFarthestDepth(GetDepth(mip, texelMinX, texelMaxY), GetDepth(mip, texelMaxX, texelMaxY)));
+
+    return m_InvertedDepth ? (nearestDepth < farthestDepth) : (nearestDepth > farthestDepth);
+}
+
+float HiZPyramid::GetDepth(uint32_t mip, uint32_t x, uint32_t y) const
+{
+    const Mip& level = m_Mips[mip];
+
+    return level.depth[y * level.width + x];
+}
+
+float HiZPyramid::GetFarthestDepth(float a, float b) const
+{
+    return m_InvertedDepth ? std::min(a, b) : std::max(a, b);
+}
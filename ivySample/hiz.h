@@ -0,0 +1,69 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// CPU implementation of the HiZ pyramid built by hiz.hlsl & read by occlusion culling, see IVY_HIZ.
+// Mips are built & looked up the same way as on the GPU, thus it can reproduce culling decisions from a depth buffer read back from the GPU.
+class HiZPyramid
+{
+public:
+    /**
+     * @brief   Returns the number of mips of the pyramid of a depth region, down to a single texel.
+     */
+    static uint32_t GetMipCount(uint32_t depthWidth, uint32_t depthHeight);
+    /**
+     * @brief   Returns the size of a mip of the pyramid of a depth region.
+     */
+    static void GetMipSize(uint32_t depthWidth, uint32_t depthHeight, uint32_t mip, uint32_t& width, uint32_t& height);
+
+    /**
+     * @brief   Builds all mips from a row-major depth region.
+     */
+    void Build(const float* pDepth, uint32_t depthWidth, uint32_t depthHeight, bool invertedDepth);
+
+    /**
+     * @brief   Returns true if a screen-space rectangle in [0; 1] uv coordinates, whose nearest depth is nearestDepth,
+     *          is entirely behind the pyramid.
+     */
+    bool IsOccluded(float uvMinX, float uvMinY, float uvMaxX, float uvMaxY, float nearestDepth) const;
+
+    uint32_t GetMipCount() const { return static_cast<uint32_t>(m_Mips.size()); }
+    float    GetDepth(uint32_t mip, uint32_t x, uint32_t y) const;
+
+private:
+    struct Mip
+    {
+        uint32_t           width  = 0;
+        uint32_t           height = 0;
+        std::vector<float> depth;
+    };
+
+    float GetFarthestDepth(float a, float b) const;
+
+    uint32_t         m_DepthWidth    = 0;
+    uint32_t         m_DepthHeight   = 0;
+    bool             m_InvertedDepth = false;
+    std::vector<Mip> m_Mips;
+};
@@ -24,7 +24,9 @@
 #include "core/framework.h"
 #include "core/scene.h"
 #include "misc/assert.h"
+#include "misc/helpers.h"
 
+#include "core/components/lightcomponent.h"
 #include "core/components/meshcomponent.h"
 
 // Render components
@@ -38,6 +40,7 @@
 #include "render/rasterview.h"
 #include "render/rootsignature.h"
 #include "render/rootsignaturedesc.h"
+#include "render/shadowmapresourcepool.h"
 #include "render/texture.h"
 
 // D3D12 Cauldron implementation
@@ -47,21 +50,185 @@
 #include "render/dx12/gpuresource_dx12.h"
 #include "render/dx12/rootsignature_dx12.h"
 
+// GBuffer pass ivy is drawn in, see imported/patch-ffx.cmake
+#include "gbuffer/gbufferrendermodule.h"
+
 // shader compiler
 #include "shadercompiler.h"
 
+// area sampling point set
+#include "aliastable.h"
+#include "lineagetrace.h"
+#include "outputdigest.h"
+#include "poissondisk.h"
+#include "proxygeometry.h"
+#include "readbackring.h"
+#include "uploadring.h"
+
 // ImGuizmo
 #include "imgui.h"
 #include "imgui_internal.h"
 #include "ImGuizmo.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 
 using namespace cauldron;
 
 // Name for work graph program inside the state object
 static const wchar_t* WorkGraphProgramName = L"WorkGraph";
+// Name for depth-only work graph program inside the shadow state object
+static const wchar_t* ShadowWorkGraphProgramName = L"ShadowWorkGraph";
+// Depth format of the shadow map atlases of RasterShadowRenderModule
+static const ResourceFormat ShadowMapFormat = ResourceFormat::D32_FLOAT;
+// Number of entry nodes that receive input records (IvyBranch & IvyArea)
+static const UINT WorkGraphEntryPointCount = 2;
+// Smallest input record limit the work graph backing memory is sized for
+static const UINT WorkGraphMinInputRecordCapacity = 64;
+// Alignment of the record arrays inside the GPU entry record buffer
+static const uint32_t EntryRecordBufferRecordAlignment = 256;
+// Resource state of the GPU entry record buffer while it is read by DispatchGraph
+static const ResourceState EntryRecordBufferReadState = ResourceState::NonPixelShaderResource | ResourceState::IndirectArgument;
+// Number of candidates per point for generating the Poisson-disk point set
+static const uint32_t AreaPoissonDiskCandidateCount = 32;
+// Number of frames a retired resource is kept alive. Must be larger than the number of frames in flight.
+static const uint64_t RetiredResourceFrameLatency = 4;
+// CSV file growth statistics are logged to
+static const char* StatisticsLogFileName = "IvyStatistics.csv";
+// Number of most expensive roots listed in the statistics window
+static const uint32_t StatisticsTopRootCount = 10;
+// Binary file lineage traces are written to, see lineagetrace.h
+static const char* LineageTraceFileName = "IvyLineage.trace";
+// Text file golden output digests are loaded from & saved to, see outputdigest.h
+static const char* GoldenOutputDigestFileName = "IvyGoldenDigests.txt";
+// Number of mismatching roots listed in the output digest window
+static const uint32_t OutputDigestMismatchListCount = 10;
+// Largest number of roots temporal regeneration regenerates per frame
+static const int RegenerationMaxRootsPerFrame = 1024;
+// Factor the roots per frame are scaled by when the frame time exceeds the budget
+static const float RegenerationBackoffFactor = 0.75f;
+// Fraction of the frame time budget below which the roots per frame are increased
+static const float RegenerationGrowthThreshold = 0.9f;
+// Conversion factor from degrees, as shown in the UI, to radians
+static const float DegreesToRadians = 3.14159265f / 180.f;
+// Longest frame time the wind animation is advanced by
+static const float WindMaxFrameTimeMs = 100.f;
+// Thread group size of DownsampleHiZ in hiz.hlsl, in each dimension
+static const uint32_t HiZThreadGroupSize = 8;
+// Maximum size of a single allocation from the dynamic upload buffer
+static const uint32_t DynamicUploadChunkSize = 64 * 1024;
+// Size of the staging ring RT info tables are uploaded through; larger uploads wait for earlier copies to complete
+static const size_t RTInfoUploadRingSize = 1024 * 1024;
+// Maximum number of bytes of a baked distance field uploaded per frame, such that large fields don't stall a single frame
+static const uint32_t DistanceFieldUploadSizePerFrame = 1024 * 1024;
+// Consecutive sampling triangles of a scene mesh sharing one bounding box, which is tested against ivy areas before the triangles
+static const size_t SurfaceSamplingChunkSize = 64;
+
+// Cauldron doesn't expose the name of a mesh, thus we access it through the memory layout of cauldron::Mesh
+static const std::wstring& GetMeshName(const Mesh* pMesh)
+{
+    struct MeshData
+    {
+        BLAS*                 m_pBlas;
+        uint32_t              m_Index;
+        std::wstring          m_Name;
+        std::vector<Surface*> m_Surfaces;
+    };
+
+    return reinterpret_cast<const MeshData*>(pMesh)->m_Name;
+}
+
+// Records copies of pData through the dynamic upload buffer. pDestination has to be in CopyDest state.
+static void UploadBufferRegion(CommandList* pCmdList, const GPUResource* pDestination, uint64_t destinationOffset, const void* pData, uint32_t size)
+{
+    ID3D12Resource* uploadBuffer = GetDynamicBufferPool()->GetResource()->GetImpl()->DX12Resource();
+
+    for (uint32_t offset = 0; offset < size; offset += DynamicUploadChunkSize)
+    {
+        const uint32_t chunkSize = std::min(size - offset, DynamicUploadChunkSize);
+
+        const BufferAddressInfo uploadInfo   = GetDynamicBufferPool()->AllocConstantBuffer(chunkSize, static_cast<const uint8_t*>(pData) + offset);
+        const UINT64            uploadOffset = uploadInfo.GetImpl()->GPUBufferView - uploadBuffer->GetGPUVirtualAddress();
+
+        pCmdList->GetImpl()->DX12CmdList()->CopyBufferRegion(
+            pDestination->GetImpl()->DX12Resource(), destinationOffset + offset, uploadBuffer, uploadOffset, chunkSize);
+    }
+}
+
+// Continues a 64-bit FNV-1a hash over size bytes of pData
+static uint64_t HashBytes(uint64_t hash, const void* pData, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ static_cast<const uint8_t*>(pData)[i]) * 1099511628211ull;
+    }
+
+    return hash;
+}
+
+// Octahedral encoding of a normalized face normal as two 16-bit values in [1; 65535], see IVY_FACE_NORMALS
+static uint32_t EncodeFaceNormal(const Vec3& normal)
+{
+    const float l1Norm = std::abs(normal.getX()) + std::abs(normal.getY()) + std::abs(normal.getZ());
+
+    float x = normal.getX() / l1Norm;
+    float y = normal.getY() / l1Norm;
+
+    // Fold lower hemisphere over the diagonals
+    if (normal.getZ() < 0.f)
+    {
+        const float foldedX = (1.f - std::abs(y)) * ((x >= 0.f) ? 1.f : -1.f);
+        const float foldedY = (1.f - std::abs(x)) * ((y >= 0.f) ? 1.f : -1.f);
+
+        x = foldedX;
+        y = foldedY;
+    }
+
+    const uint32_t u = static_cast<uint32_t>(std::lround(std::clamp(x, -1.f, 1.f) * 32767.f) + 32768);
+    const uint32_t v = static_cast<uint32_t>(std::lround(std::clamp(y, -1.f, 1.f) * 32767.f) + 32768);
+
+    return u | (v << 16);
+}
+
+// Byte ranges of the elements of pData which differ from previousData, followed by all elements beyond previousData. Adjacent ranges are merged.
+static std::vector<std::pair<size_t, size_t>> GetChangedRanges(const uint8_t* pData, size_t size, const std::vector<uint8_t>& previousData, size_t stride)
+{
+    std::vector<std::pair<size_t, size_t>> ranges;
+
+    const auto addRange = [&](size_t begin, size_t end) {
+        if (!ranges.empty() && (ranges.back().second == begin))
+        {
+            ranges.back().second = end;
+        }
+        else
+        {
+            ranges.emplace_back(begin, end);
+        }
+    };
+
+    const size_t commonSize = std::min(size, previousData.size());
+
+    for (size_t offset = 0; offset < commonSize; offset += stride)
+    {
+        const size_t elementSize = std::min(stride, commonSize - offset);
+
+        if (memcmp(pData + offset, previousData.data() + offset, elementSize) != 0)
+        {
+            addRange(offset, offset + elementSize);
+        }
+    }
+
+    if (size > commonSize)
+    {
+        addRange(commonSize, size);
+    }
+
+    return ranges;
+}
 
 IvyRenderModule::IvyRenderModule()
     : RenderModule(L"IvyRenderModule")
@@ -71,6 +238,8 @@ IvyRenderModule::IvyRenderModule()
 IvyRenderModule::~IvyRenderModule()
 {
     // Delete work graph
+    if (m_pWorkGraphProperties)
+        m_pWorkGraphProperties->Release();
     if (m_pWorkGraphStateObject)
         m_pWorkGraphStateObject->Release();
     if (m_pWorkGraphParameterSet)
@@ -79,12 +248,116 @@ IvyRenderModule::~IvyRenderModule()
         delete m_pWorkGraphRootSignature;
     if (m_pWorkGraphBackingMemoryBuffer)
         delete m_pWorkGraphBackingMemoryBuffer;
+    if (m_pShadowStateObject)
+        m_pShadowStateObject->Release();
+    if (m_pShadowParameterSet)
+        delete m_pShadowParameterSet;
+    if (m_pShadowRootSignature)
+        delete m_pShadowRootSignature;
+    if (m_pShadowBackingMemoryBuffer)
+        delete m_pShadowBackingMemoryBuffer;
+    if (m_pHiZPipelineState)
+        m_pHiZPipelineState->Release();
+    if (m_pHiZParameterSet)
+        delete m_pHiZParameterSet;
+    if (m_pHiZRootSignature)
+        delete m_pHiZRootSignature;
+    if (m_pEntryRecordBuffer)
+        delete m_pEntryRecordBuffer;
+    if (m_pAreaPoissonDiskPointBuffer)
+        delete m_pAreaPoissonDiskPointBuffer;
+    if (m_pAreaSurfaceTriangleBuffer)
+        delete m_pAreaSurfaceTriangleBuffer;
+    if (m_pStatisticsBuffer)
+        delete m_pStatisticsBuffer;
+    if (m_pStatisticsReadback)
+        delete m_pStatisticsReadback;
+    if (m_pRootStatisticsBuffer)
+        delete m_pRootStatisticsBuffer;
+    if (m_pRootStatisticsReadback)
+        delete m_pRootStatisticsReadback;
+    if (m_pZeroBuffer)
+        delete m_pZeroBuffer;
+    if (m_pLineageTraceBuffer)
+        delete m_pLineageTraceBuffer;
+    if (m_pLineageTraceReadback)
+        delete m_pLineageTraceReadback;
+    if (m_pOutputDigestBuffer)
+        delete m_pOutputDigestBuffer;
+    if (m_pOutputDigestReadback)
+        delete m_pOutputDigestReadback;
+    if (m_pHitCacheBuffer)
+        delete m_pHitCacheBuffer;
+    if (m_pMeshletBuffer)
+        delete m_pMeshletBuffer;
+    if (m_pHitCacheReadback)
+        delete m_pHitCacheReadback;
+    if (m_pFrontierCounterReadback)
+        delete m_pFrontierCounterReadback;
+    if (m_pGrowthCacheCounterReadback)
+        delete m_pGrowthCacheCounterReadback;
+    if (m_pSdfBrickIndexBuffer)
+        delete m_pSdfBrickIndexBuffer;
+    if (m_pSdfBrickBuffer)
+        delete m_pSdfBrickBuffer;
+    if (m_pUploadingSdfBrickIndexBuffer)
+        delete m_pUploadingSdfBrickIndexBuffer;
+    if (m_pUploadingSdfBrickBuffer)
+        delete m_pUploadingSdfBrickBuffer;
+    if (m_pFaceNormalBuffer)
+        delete m_pFaceNormalBuffer;
+    if (m_pFaceNormalOffsetBuffer)
+        delete m_pFaceNormalOffsetBuffer;
+    // Upload ring waits for pending copies into the table buffers
+    if (m_pRTInfoUploadRing)
+        delete m_pRTInfoUploadRing;
+    if (m_pBoundRTInfoTables)
+        delete m_pBoundRTInfoTables;
+    if (m_pUploadingRTInfoTables)
+        delete m_pUploadingRTInfoTables;
+    if (m_pPendingRTInfoTables.load())
+        delete m_pPendingRTInfoTables.load();
+    for (auto* pTableBuffer : {&m_materialTableBuffer, &m_surfaceTableBuffer, &m_surfaceIDsTableBuffer, &m_instanceTableBuffer})
+    {
+        if (pTableBuffer->pBuffer)
+            delete pTableBuffer->pBuffer;
+    }
+    for (auto* pFrontierBuffer : m_pFrontierBuffers)
+    {
+        if (pFrontierBuffer)
+            delete pFrontierBuffer;
+    }
+    for (auto* pGrowthCacheBuffer : m_pGrowthCacheBuffers)
+    {
+        if (pGrowthCacheBuffer)
+            delete pGrowthCacheBuffer;
+    }
+
+    for (auto& readback : m_pendingGeometryReadbacks)
+    {
+        if (readback.pReadbackResource)
+            readback.pReadbackResource->Release();
+    }
+
+    for (auto& retiredBuffer : m_RetiredBuffers)
+    {
+        delete retiredBuffer.second;
+    }
 }
 
 void IvyRenderModule::Init(const json& initData)
 {
     InitTextures();
     InitWorkGraphProgram();
+    InitShadowWorkGraphProgram();
+    InitAreaSamplingPoints();
+    InitStatistics();
+    InitHitCache();
+    InitProgressiveGrowth();
+    InitHiZ();
+    InitLeafCards();
+    InitMeshlets();
+    InitRTInfoTables();
 
     // Use ImGui hooks to render 3D user interface
     ImGuiContextHook hook = {};
@@ -100,16 +373,128 @@ void IvyRenderModule::Init(const json& initData)
     m_ivyBranchRecords.emplace_back(IvyBranchRecord{Mat4::translation(Vec3(0, 0.1f, 0))});
 
     m_ivyAreaRecords.emplace_back(IvyAreaRecord{Mat4::translation(Vec3(0, 17, 7)) * Mat4::scale(Vec3(15, 1, 4)), 4050, 0.14f});
+    m_ivyAreaSurfaceSampling.resize(m_ivyAreaRecords.size());
+
+    for (auto& record : m_ivyBranchRecords)
+    {
+        record.rootIndex = m_rootCount++;
+    }
+    for (auto& record : m_ivyAreaRecords)
+    {
+        record.rootIndex = m_rootCount++;
+    }
+
+    // Register general ivy settings
+    m_SettingsUISection.SectionName = "Ivy Generation";
+    m_SettingsUISection.AddCheckBox("GPU-resident entry records", &m_useGpuEntryRecords);
+    m_SettingsUISection.AddCheckBox("Poisson-disk area sampling", &m_usePoissonAreaSampling);
+    m_SettingsUISection.AddCheckBox("Adaptive probing", &m_useAdaptiveProbing);
+    m_SettingsUISection.AddCheckBox("Hit cache", &m_useHitCache);
+    m_SettingsUISection.AddButton("Clear hit cache", [this]() { ++m_hitCacheEpoch; });
+    m_SettingsUISection.AddButton("Inspect hit cache", [this]() { m_hitCacheInspectionRequested = true; });
+    if (m_rayQueriesSupported)
+    {
+        m_SettingsUISection.AddCheckBox("SDF growth queries", &m_useSdfQueries);
+    }
+    m_SettingsUISection.AddCheckBox("SDF proxy geometry", &m_useProxyGeometry);
+    m_SettingsUISection.AddCheckBox("Progressive growth", &m_useProgressiveGrowth);
+    m_SettingsUISection.AddIntSlider("Growth levels per frame", &m_progressiveLevelsPerFrame, 1, IVY_MAX_RECURSION);
+    m_SettingsUISection.AddButton("Restart growth", [this]() { m_restartProgressiveGrowth = true; });
+    m_SettingsUISection.AddCheckBox("Temporal regeneration", &m_useTemporalRegeneration);
+    m_SettingsUISection.AddIntSlider("Roots per frame", &m_regenerationRootsPerFrame, 1, RegenerationMaxRootsPerFrame);
+    m_SettingsUISection.AddCheckBox("Adapt to frame budget", &m_adaptRegenerationToBudget);
+    m_SettingsUISection.AddFloatSlider("Frame budget (ms)", &m_regenerationFrameBudgetMs, 4.f, 100.f);
+    m_SettingsUISection.AddCheckBox("Wind", &m_useWind);
+    m_SettingsUISection.AddFloatSlider("Wind strength", &m_windStrength, 0.f, 0.5f);
+    m_SettingsUISection.AddFloatSlider("Wind direction", &m_windDirectionDegrees, 0.f, 360.f);
+    m_SettingsUISection.AddCheckBox("Ivy shadows", &m_useIvyShadows);
+    m_SettingsUISection.AddCheckBox("Occlusion culling", &m_useOcclusionCulling);
+    m_SettingsUISection.AddCheckBox("Leaf cards", &m_useLeafCards);
+    m_SettingsUISection.AddFloatSlider("Leaf card distance", &m_leafCardDistance, 5.f, 200.f);
+    m_SettingsUISection.AddCheckBox("Meshlet culling", &m_useMeshletCulling);
+    m_SettingsUISection.AddCheckBox("Growth statistics", &m_useStatistics);
+    m_SettingsUISection.AddCheckBox("Log statistics to CSV", &m_logStatistics);
+    m_SettingsUISection.AddButton("Record lineage trace", [this]() { m_lineageTraceRequested = true; });
+    m_SettingsUISection.AddCheckBox("Output digests", &m_useOutputDigests);
+    m_SettingsUISection.AddButton("Save golden digests", [this]() { m_saveGoldenOutputDigests = true; });
+    m_SettingsUISection.AddIntSlider("Records to add", &m_ivyRecordAddCount, 1, 1000);
+    m_SettingsUISection.AddButton("Add Ivy Branch", [this]() { m_pendingIvyBranchAdds += m_ivyRecordAddCount; });
+    m_SettingsUISection.AddButton("Add Ivy Area", [this]() { m_pendingIvyAreaAdds += m_ivyRecordAddCount; });
+    GetUIManager()->RegisterUIElements(m_SettingsUISection);
 
     // Register for content change updates
     GetContentManager()->AddContentListener(this);
 
+    // Ivy is drawn inside the raster pass of GBufferRenderModule, see imported/patch-ffx.cmake
+    GBufferRenderModule* pGBufferRenderModule = static_cast<GBufferRenderModule*>(GetFramework()->GetRenderModule("GBufferRenderModule"));
+    CauldronAssert(ASSERT_CRITICAL, pGBufferRenderModule != nullptr, L"IvyRenderModule requires GBufferRenderModule.");
+    pGBufferRenderModule->SetRasterPassCallback([this](double deltaTime, CommandList* pCmdList) {
+        if (ModuleEnabled())
+        {
+            ExecuteGBufferPass(deltaTime, pCmdList);
+        }
+    });
+
     SetModuleReady(true);
 }
 
-void IvyRenderModule::Execute(double deltaTime, cauldron::CommandList* pCmdList)
+void IvyRenderModule::ExecuteGBufferPass(double deltaTime, cauldron::CommandList* pCmdList)
 {
-    std::lock_guard<std::mutex> pipelineLock(m_CriticalSection);
+    ReleaseRetiredBuffers();
+
+    // Bind tables published by content loads since the previous frame
+    UpdateRTInfoTables(pCmdList);
+
+    const auto frameTime = std::chrono::steady_clock::now();
+    m_frameTimeMs        = std::chrono::duration<float, std::milli>(frameTime - m_previousFrameTime).count();
+    m_previousFrameTime  = frameTime;
+
+    // Advance wind animation. Long frames are clamped, such that stalls don't cause jumps.
+    m_previousWindTime = m_windTime;
+    m_windTime         = std::fmod(m_windTime + std::min(m_frameTimeMs, WindMaxFrameTimeMs) / 1000.f, IVY_WIND_TIME_PERIOD);
+
+    // Add records requested through the UI
+    if ((m_pendingIvyBranchAdds > 0) || (m_pendingIvyAreaAdds > 0))
+    {
+        for (; m_pendingIvyBranchAdds > 0; --m_pendingIvyBranchAdds)
+        {
+            AddIvyBranch();
+        }
+        for (; m_pendingIvyAreaAdds > 0; --m_pendingIvyAreaAdds)
+        {
+            AddIvyArea();
+        }
+
+        m_updateIvyUI = true;
+    }
+
+    // Read back scene geometry & rebuild alias tables for surface sampling of ivy areas
+    UpdateSceneGeometryReadback(pCmdList);
+    UpdateFaceNormals(pCmdList);
+    UpdateAreaSurfaceSampling(pCmdList);
+    UpdateDistanceField(pCmdList);
+
+    // Grow work graph input record limit if needed
+    UpdateWorkGraphInputCapacity();
+    UpdateRootStatisticsCapacity();
+
+    // Update mesh options for surface sampling once new geometry is available
+    if (m_sceneMeshNames.size() != m_sceneMeshes.size())
+    {
+        m_sceneMeshNames.clear();
+        for (const auto& sceneMesh : m_sceneMeshes)
+        {
+            m_sceneMeshNames.push_back(sceneMesh.name);
+        }
+
+        m_sceneMeshOptions = {"All Meshes"};
+        for (const auto& name : m_sceneMeshNames)
+        {
+            m_sceneMeshOptions.push_back(name.c_str());
+        }
+
+        m_updateIvyUI = true;
+    }
 
     // Update Ivy UI if needed
     if (m_updateIvyUI)
@@ -127,7 +512,9 @@ void IvyRenderModule::Execute(double deltaTime, cauldron::CommandList* pCmdList)
             // Register new UI section
             m_UISection             = {};
             m_UISection.SectionName = std::string("IvyBranch[") + std::to_string(m_selectedIvyBranch) + "] Settings";
-            m_UISection.AddIntSlider("Seed", reinterpret_cast<int*>(&ivyData.seed), 0, 10000);
+            m_UISection.AddIntSlider("Seed", reinterpret_cast<int*>(&ivyData.seed), 0, 10000, [this, branchIndex = m_selectedIvyBranch](int32_t, int32_t) {
+                MarkIvyBranchEdited(branchIndex);
+            });
 
             GetUIManager()->RegisterUIElements(m_UISection);
         }
@@ -138,8 +525,14 @@ void IvyRenderModule::Execute(double deltaTime, cauldron::CommandList* pCmdList)
             // Register new UI section
             m_UISection             = {};
             m_UISection.SectionName = std::string("IvyArea[") + std::to_string(m_selectedIvyArea) + "] Settings";
-            m_UISection.AddIntSlider("Seed", reinterpret_cast<int*>(&ivyData.seed), 0, 10000);
-            m_UISection.AddFloatSlider("Density", &ivyData.density, 0.f, 1.f);
+            const int areaIndex = m_selectedIvyArea;
+            m_UISection.AddIntSlider("Seed", reinterpret_cast<int*>(&ivyData.seed), 0, 10000, [this, areaIndex](int32_t, int32_t) { MarkIvyAreaEdited(areaIndex); });
+            m_UISection.AddFloatSlider("Density", &ivyData.density, 0.f, 1.f, [this, areaIndex](float, float) { MarkIvyAreaEdited(areaIndex); });
+
+            auto& surfaceSampling = m_ivyAreaSurfaceSampling[m_selectedIvyArea];
+            m_UISection.AddCheckBox("Surface Sampling", &surfaceSampling.enabled, [this, areaIndex](bool, bool) { MarkIvyAreaEdited(areaIndex); });
+            m_UISection.AddCombo(
+                "Surface Mesh", &surfaceSampling.meshOption, &m_sceneMeshOptions, [this, areaIndex](int32_t, int32_t) { MarkIvyAreaEdited(areaIndex); });
 
             GetUIManager()->RegisterUIElements(m_UISection);
         }
@@ -163,96 +556,423 @@ void IvyRenderModule::Execute(double deltaTime, cauldron::CommandList* pCmdList)
 
     GPUScopedProfileCapture shadingMarker(pCmdList, L"Ivy Generation");
 
-    std::vector<Barrier> barriers;
-    barriers.push_back(Barrier::Transition(m_pGBufferAlbedoOutput->GetResource(),
-                                           ResourceState::NonPixelShaderResource | ResourceState::PixelShaderResource,
-                                           ResourceState::RenderTargetResource));
-    barriers.push_back(Barrier::Transition(m_pGBufferNormalOutput->GetResource(),
-                                           ResourceState::NonPixelShaderResource | ResourceState::PixelShaderResource,
-                                           ResourceState::RenderTargetResource));
-    barriers.push_back(Barrier::Transition(m_pGBufferAoRoughnessMetallicOutput->GetResource(),
-                                           ResourceState::NonPixelShaderResource | ResourceState::PixelShaderResource,
-                                           ResourceState::RenderTargetResource));
-    barriers.push_back(Barrier::Transition(m_pGBufferMotionOutput->GetResource(),
-                                           ResourceState::NonPixelShaderResource | ResourceState::PixelShaderResource,
-                                           ResourceState::RenderTargetResource));
-    barriers.push_back(Barrier::Transition(
-        m_pGBufferDepthOutput->GetResource(), ResourceState::NonPixelShaderResource | ResourceState::PixelShaderResource, ResourceState::DepthWrite));
+    if (m_useGpuEntryRecords)
+    {
+        UpdateEntryRecordBuffer(pCmdList);
+    }
+    else
+    {
+        // Force full upload once GPU-resident records are enabled again
+        m_entryRecordBufferCapacity = 0;
+        m_dirtyIvyBranchRecords.clear();
+        m_dirtyIvyAreaRecords.clear();
+    }
+
+    // Lineage trace is recorded for a single frame
+    const bool recordLineageTrace = m_lineageTraceRequested && !m_lineageTracePending;
+
+    if (recordLineageTrace)
+    {
+        // Reset entry counter. Trace buffer is kept in copy destination state in between frames.
+        const std::array<uint32_t, IVY_LINEAGE_TRACE_HEADER_SIZE> zeroHeader = {};
+        UploadBufferRegion(pCmdList, m_pLineageTraceBuffer->GetResource(), 0, zeroHeader.data(), sizeof(zeroHeader));
+    }
+
+    // Progressive growth continues from the frontier of the previous frame, unless it restarts from the entry records
+    const bool restartProgressiveGrowth = UpdateProgressiveGrowth(pCmdList);
+    UpdateTemporalRegeneration();
+
+    // Growth cache of the previous frame is only drawn if it was written, and discarded if progressive growth restarts.
+    // Ivy shadows only draw the cache written in this frame, which then holds the growth of this frame.
+    const bool useTemporalRegeneration = m_regenerationCount > 0;
+    const bool useGrowthCache          = m_useProgressiveGrowth || useTemporalRegeneration || m_useIvyShadows;
+    const bool drawGrowthCache         = (m_useProgressiveGrowth || useTemporalRegeneration) && m_growthCacheWritten && !restartProgressiveGrowth;
+
+    // Leaf card mask is baked in the first frame cards are used after the leaf mesh was loaded
+    const bool useLeafCards     = m_useLeafCards && (m_ivyLeafSurfaceIndex >= 0);
+    const bool bakeLeafCardMask = useLeafCards && !m_leafCardMaskBaked;
+    // Meshlets are baked in the first frame after both ivy meshes were loaded
+    const bool bakeMeshlets = (m_ivyStemSurfaceIndex >= 0) && (m_ivyLeafSurfaceIndex >= 0) && !m_meshletsBaked;
+
+    if (useGrowthCache)
+    {
+        // Reset counts of the growth cache written in this frame
+        const std::array<uint32_t, IVY_GROWTH_CACHE_STEMS> zeroCounts = {};
+        UploadBufferRegion(pCmdList, m_pGrowthCacheBuffers[1 - m_growthCacheReadIndex]->GetResource(), 0, zeroCounts.data(), sizeof(zeroCounts));
+    }
+
+    if (m_useOcclusionCulling)
+    {
+        // GBufferDepth only holds scene geometry at this point, which occludes ivy drawn in this frame.
+        // It stays bound as depth target, which is not written while the pyramid is built.
+        Barrier depthBarrier = Barrier::Transition(
+            m_pGBufferDepthOutput->GetResource(), ResourceState::DepthWrite, ResourceState::NonPixelShaderResource | ResourceState::PixelShaderResource);
+        ResourceBarrier(pCmdList, 1, &depthBarrier);
+
+        UpdateHiZ(pCmdList, width, height);
+
+        std::swap(depthBarrier.DestState, depthBarrier.SourceState);
+        ResourceBarrier(pCmdList, 1, &depthBarrier);
+    }
+
+    // Buffers written by growth are transitioned back by Execute
+    std::vector<Barrier>& barriers = m_gbufferPass.barriers;
+    barriers.clear();
+    // Statistics counters are kept in copy destination state in between frames, see UpdateStatistics
+    barriers.push_back(Barrier::Transition(m_pStatisticsBuffer->GetResource(), ResourceState::CopyDest, ResourceState::UnorderedAccess));
+    barriers.push_back(Barrier::Transition(m_pRootStatisticsBuffer->GetResource(), ResourceState::CopyDest, ResourceState::UnorderedAccess));
+    barriers.push_back(Barrier::Transition(m_pLineageTraceBuffer->GetResource(), ResourceState::CopyDest, ResourceState::UnorderedAccess));
+    barriers.push_back(Barrier::Transition(m_pOutputDigestBuffer->GetResource(), ResourceState::CopyDest, ResourceState::UnorderedAccess));
+    barriers.push_back(Barrier::Transition(m_pHitCacheBuffer->GetResource(), ResourceState::CopyDest, ResourceState::UnorderedAccess));
+    // Frontiers & growth caches are kept in copy destination state in between frames, see UpdateProgressiveGrowth
+    barriers.push_back(Barrier::Transition(m_pFrontierBuffers[1 - m_frontierReadIndex]->GetResource(), ResourceState::CopyDest, ResourceState::UnorderedAccess));
+    barriers.push_back(Barrier::Transition(m_pFrontierBuffers[m_frontierReadIndex]->GetResource(), ResourceState::CopyDest, EntryRecordBufferReadState));
+    barriers.push_back(Barrier::Transition(m_pGrowthCacheBuffers[0]->GetResource(), ResourceState::CopyDest, ResourceState::UnorderedAccess));
+    barriers.push_back(Barrier::Transition(m_pGrowthCacheBuffers[1]->GetResource(), ResourceState::CopyDest, ResourceState::UnorderedAccess));
+    // Meshlets are kept in copy destination state in between frames, see InitMeshlets
+    barriers.push_back(Barrier::Transition(m_pMeshletBuffer->GetResource(), ResourceState::CopyDest, ResourceState::UnorderedAccess));
 
     ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
 
-    // Begin raster with render targets
-    BeginRaster(pCmdList, static_cast<uint32_t>(m_pGBufferRasterViews.size()), m_pGBufferRasterViews.data(), m_pGBufferDepthRasterView, nullptr);
+    // GBuffer targets are bound by GBufferRenderModule
     SetViewportScissorRect(pCmdList, 0, 0, width, height, 0.f, 1.f);
 
     const auto* currentCamera = GetScene()->GetCurrentCamera();
 
-    WorkGraphCBData workGraphData        = {};
-    workGraphData.ViewProjection         = currentCamera->GetProjectionJittered() * currentCamera->GetView();
-    workGraphData.PreviousViewProjection = currentCamera->GetPrevProjectionJittered() * currentCamera->GetPreviousView();
-    workGraphData.InverseViewProjection  = InverseMatrix(workGraphData.ViewProjection);
-    workGraphData.CameraPosition         = currentCamera->GetCameraTranslation();
-    workGraphData.PreviousCameraPosition = InverseMatrix(currentCamera->GetPreviousView()).getCol3();
-    workGraphData.IvyStemSurfaceIndex    = m_ivyStemSurfaceIndex;
-    workGraphData.IvyLeafSurfaceIndex    = m_ivyLeafSurfaceIndex;
+    const float windDirection = m_windDirectionDegrees * DegreesToRadians;
+
+    WorkGraphCBData workGraphData          = {};
+    workGraphData.ViewProjection           = currentCamera->GetProjectionJittered() * currentCamera->GetView();
+    workGraphData.PreviousViewProjection   = currentCamera->GetPrevProjectionJittered() * currentCamera->GetPreviousView();
+    workGraphData.InverseViewProjection    = InverseMatrix(workGraphData.ViewProjection);
+    workGraphData.CameraPosition           = currentCamera->GetCameraTranslation();
+    workGraphData.PreviousCameraPosition   = InverseMatrix(currentCamera->GetPreviousView()).getCol3();
+    workGraphData.IvyStemSurfaceIndex      = m_ivyStemSurfaceIndex;
+    workGraphData.IvyLeafSurfaceIndex      = m_ivyLeafSurfaceIndex;
+    workGraphData.IvyFlags                 = 0;
+    workGraphData.IvyHitCacheEpoch         = m_hitCacheEpoch;
+    workGraphData.SdfBoundsMin             = m_sdfBoundsMin;
+    workGraphData.SdfBrickGridSize[0]      = m_sdfBrickGridSize[0];
+    workGraphData.SdfBrickGridSize[1]      = m_sdfBrickGridSize[1];
+    workGraphData.SdfBrickGridSize[2]      = m_sdfBrickGridSize[2];
+    workGraphData.IvyProgressiveLevels     = static_cast<uint32_t>(m_progressiveLevelsPerFrame);
+    workGraphData.IvyFrontierWriteIndex    = 1 - m_frontierReadIndex;
+    workGraphData.IvyGrowthCacheWriteIndex = 1 - m_growthCacheReadIndex;
+    workGraphData.IvyRootCount             = static_cast<uint32_t>(m_ivyBranchRecords.size() + m_ivyAreaRecords.size());
+    workGraphData.IvyRegenerationStart     = m_regenerationStart;
+    workGraphData.IvyRegenerationCount     = m_regenerationCount;
+    workGraphData.IvyWindTime              = m_windTime;
+    workGraphData.IvyPreviousWindTime      = m_previousWindTime;
+    workGraphData.IvyWindStrength          = m_windStrength;
+    workGraphData.IvyWindDirection         = Vec4(std::cos(windDirection), 0.f, std::sin(windDirection), 0.f);
+    workGraphData.IvyStemBoundsCenter      = m_ivyStemBoundsCenter;
+    workGraphData.IvyStemBoundsExtents     = m_ivyStemBoundsExtents;
+    workGraphData.IvyLeafBoundsCenter      = m_ivyLeafBoundsCenter;
+    workGraphData.IvyLeafBoundsExtents     = m_ivyLeafBoundsExtents;
+    workGraphData.HiZDepthSize[0]          = width;
+    workGraphData.HiZDepthSize[1]          = height;
+    workGraphData.HiZMipCount              = HiZPyramid::GetMipCount(width, height);
+    workGraphData.IvyLeafCardDistance      = m_leafCardDistance;
+
+    UpdateShadowViews(workGraphData);
+
+    if (m_usePoissonAreaSampling)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_POISSON_AREA_SAMPLING;
+    }
+    if (m_useStatistics)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_STATISTICS;
+    }
+    if (m_useAdaptiveProbing)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_ADAPTIVE_PROBING;
+    }
+    if (m_useHitCache)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_HIT_CACHE;
+    }
+    if (m_useSdfQueries || !m_rayQueriesSupported)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_SDF_QUERIES;
+    }
+    if (recordLineageTrace)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_LINEAGE_TRACE;
+    }
+    if (m_useOutputDigests)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_OUTPUT_DIGEST;
+    }
+    if (m_useProgressiveGrowth)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_PROGRESSIVE_GROWTH;
+    }
+    if (useTemporalRegeneration)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_TEMPORAL_REGENERATION;
+    }
+    if (m_useWind)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_WIND;
+    }
+    if (useGrowthCache)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_GROWTH_CACHE;
+    }
+    if (m_useOcclusionCulling)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_OCCLUSION_CULLING;
+    }
+    if (GetConfig()->InvertedDepth)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_INVERTED_DEPTH;
+    }
+    if (useLeafCards)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_LEAF_CARDS;
+    }
+    if (m_useMeshletCulling)
+    {
+        workGraphData.IvyFlags |= IVY_FLAG_MESHLET_CULLING;
+    }
 
     BufferAddressInfo workGraphDataInfo = GetDynamicBufferPool()->AllocConstantBuffer(sizeof(WorkGraphCBData), &workGraphData);
     m_pWorkGraphParameterSet->UpdateRootConstantBuffer(&workGraphDataInfo, 0);
 
-    m_pWorkGraphParameterSet->SetAccelerationStructure(GetScene()->GetASManager()->GetTLAS(), 0);
+    if (m_rayQueriesSupported)
+    {
+        m_pWorkGraphParameterSet->SetAccelerationStructure(GetScene()->GetASManager()->GetTLAS(), 0);
+    }
 
     // Bind all the parameters
     m_pWorkGraphParameterSet->Bind(pCmdList, nullptr);
 
-    // Dispatch the work graph
+    // Get ID3D12GraphicsCommandList10 from Cauldron command list
+    ID3D12GraphicsCommandList10* commandList;
+    CauldronThrowOnFail(pCmdList->GetImpl()->DX12CmdList()->QueryInterface(IID_PPV_ARGS(&commandList)));
+
+    const auto DispatchGraph = [&](const D3D12_DISPATCH_GRAPH_DESC& dispatchDesc) {
+        commandList->SetProgram(&m_WorkGraphProgramDesc);
+        commandList->DispatchGraph(&dispatchDesc);
+
+        // Clear backing memory initialization flag, as the graph has run at least once now
+        m_WorkGraphProgramDesc.WorkGraph.Flags &= ~D3D12_SET_WORK_GRAPH_FLAG_INITIALIZE;
+    };
+
+    if (bakeLeafCardMask)
+    {
+        Barrier barrier = Barrier::Transition(m_pLeafCardMaskTexture->GetResource(),
+                                              ResourceState::NonPixelShaderResource | ResourceState::PixelShaderResource,
+                                              ResourceState::UnorderedAccess);
+        ResourceBarrier(pCmdList, 1, &barrier);
+
+        // The bake entry node has no input record
+        D3D12_DISPATCH_GRAPH_DESC dispatchDesc        = {};
+        dispatchDesc.Mode                             = D3D12_DISPATCH_MODE_NODE_CPU_INPUT;
+        dispatchDesc.NodeCPUInput.EntrypointIndex     = m_WorkGraphEntryPoints.IvyLeafCardMaskBake;
+        dispatchDesc.NodeCPUInput.NumRecords          = 1;
+        dispatchDesc.NodeCPUInput.pRecords            = nullptr;
+        dispatchDesc.NodeCPUInput.RecordStrideInBytes = 0;
+
+        DispatchGraph(dispatchDesc);
+
+        // Cards drawn by the following dispatches read the mask
+        std::swap(barrier.DestState, barrier.SourceState);
+        ResourceBarrier(pCmdList, 1, &barrier);
+
+        m_leafCardMaskBaked = true;
+    }
+
+    if (bakeMeshlets)
+    {
+        // The bake entry node has no input record
+        D3D12_DISPATCH_GRAPH_DESC dispatchDesc        = {};
+        dispatchDesc.Mode                             = D3D12_DISPATCH_MODE_NODE_CPU_INPUT;
+        dispatchDesc.NodeCPUInput.EntrypointIndex     = m_WorkGraphEntryPoints.IvyMeshletBake;
+        dispatchDesc.NodeCPUInput.NumRecords          = 1;
+        dispatchDesc.NodeCPUInput.pRecords            = nullptr;
+        dispatchDesc.NodeCPUInput.RecordStrideInBytes = 0;
+
+        DispatchGraph(dispatchDesc);
+
+        // Stems & leaves drawn by the following dispatches read the meshlets
+        Barrier barrier = Barrier::UAV(m_pMeshletBuffer->GetResource());
+        ResourceBarrier(pCmdList, 1, &barrier);
+
+        m_meshletsBaked = true;
+    }
+
+    if (drawGrowthCache)
+    {
+        // Draw stems & leaves grown in previous frames. The cache draw entry node has no input record.
+        D3D12_DISPATCH_GRAPH_DESC dispatchDesc        = {};
+        dispatchDesc.Mode                             = D3D12_DISPATCH_MODE_NODE_CPU_INPUT;
+        dispatchDesc.NodeCPUInput.EntrypointIndex     = m_WorkGraphEntryPoints.IvyGrowthCacheDraw;
+        dispatchDesc.NodeCPUInput.NumRecords          = 1;
+        dispatchDesc.NodeCPUInput.pRecords            = nullptr;
+        dispatchDesc.NodeCPUInput.RecordStrideInBytes = 0;
+
+        // Growth only appends to the cache written in this frame, thus no barrier is needed in between
+        DispatchGraph(dispatchDesc);
+    }
+
+    if (m_useProgressiveGrowth && !restartProgressiveGrowth)
+    {
+        // Continue growth from the records deferred in the previous frame
+        D3D12_DISPATCH_GRAPH_DESC dispatchDesc = {};
+        dispatchDesc.Mode                      = D3D12_DISPATCH_MODE_NODE_GPU_INPUT;
+        dispatchDesc.NodeGPUInput              = m_pFrontierBuffers[m_frontierReadIndex]->GetAddressInfo().GetImpl()->GPUBufferView;
+
+        DispatchGraph(dispatchDesc);
+    }
+    else if (useTemporalRegeneration)
     {
-        D3D12_NODE_CPU_INPUT inputs[3];
+        // Regenerate the window of roots. Its records are passed as CPU input, as only a bounded number of records is uploaded.
+        // Records of each type are sorted by root index, thus the window covers a consecutive range of each record type.
+        const uint32_t regenerationEnd = m_regenerationStart + m_regenerationCount;
+
+        const auto FindRecord = [](const auto& records, uint32_t rootIndex) {
+            return static_cast<uint32_t>(
+                std::lower_bound(records.begin(), records.end(), rootIndex, [](const auto& record, uint32_t index) { return record.rootIndex < index; }) -
+                records.begin());
+        };
+
+        const uint32_t branchRecordBegin = FindRecord(m_ivyBranchRecords, m_regenerationStart);
+        const uint32_t branchRecordEnd   = FindRecord(m_ivyBranchRecords, regenerationEnd);
+        const uint32_t areaRecordBegin   = FindRecord(m_ivyAreaRecords, m_regenerationStart);
+        const uint32_t areaRecordEnd     = FindRecord(m_ivyAreaRecords, regenerationEnd);
+
+        D3D12_NODE_CPU_INPUT inputs[WorkGraphEntryPointCount];
 
-        // IvyBranch records
         inputs[0].EntrypointIndex     = m_WorkGraphEntryPoints.IvyBranch;
-        inputs[0].NumRecords          = static_cast<UINT>(m_ivyBranchRecords.size());
-        inputs[0].pRecords            = m_ivyBranchRecords.data();
+        inputs[0].NumRecords          = branchRecordEnd - branchRecordBegin;
+        inputs[0].pRecords            = m_ivyBranchRecords.data() + branchRecordBegin;
         inputs[0].RecordStrideInBytes = sizeof(IvyBranchRecord);
 
         inputs[1].EntrypointIndex     = m_WorkGraphEntryPoints.IvyArea;
-        inputs[1].NumRecords          = static_cast<UINT>(m_ivyAreaRecords.size());
-        inputs[1].pRecords            = m_ivyAreaRecords.data();
+        inputs[1].NumRecords          = areaRecordEnd - areaRecordBegin;
+        inputs[1].pRecords            = m_ivyAreaRecords.data() + areaRecordBegin;
         inputs[1].RecordStrideInBytes = sizeof(IvyAreaRecord);
 
         D3D12_DISPATCH_GRAPH_DESC dispatchDesc                = {};
         dispatchDesc.Mode                                     = D3D12_DISPATCH_MODE_MULTI_NODE_CPU_INPUT;
-        dispatchDesc.MultiNodeCPUInput                        = {};
-        dispatchDesc.MultiNodeCPUInput.NumNodeInputs          = 2;
+        dispatchDesc.MultiNodeCPUInput.NumNodeInputs          = WorkGraphEntryPointCount;
         dispatchDesc.MultiNodeCPUInput.pNodeInputs            = inputs;
         dispatchDesc.MultiNodeCPUInput.NodeInputStrideInBytes = sizeof(D3D12_NODE_CPU_INPUT);
 
-        // Get ID3D12GraphicsCommandList10 from Cauldron command list
-        ID3D12GraphicsCommandList10* commandList;
-        CauldronThrowOnFail(pCmdList->GetImpl()->DX12CmdList()->QueryInterface(IID_PPV_ARGS(&commandList)));
+        DispatchGraph(dispatchDesc);
+    }
+    else
+    {
+        D3D12_NODE_CPU_INPUT      inputs[WorkGraphEntryPointCount];
+        D3D12_DISPATCH_GRAPH_DESC dispatchDesc = {};
+
+        if (m_useGpuEntryRecords)
+        {
+            // Records & input descriptions are already resident in GPU memory
+            dispatchDesc.Mode              = D3D12_DISPATCH_MODE_MULTI_NODE_GPU_INPUT;
+            dispatchDesc.MultiNodeGPUInput = m_pEntryRecordBuffer->GetAddressInfo().GetImpl()->GPUBufferView;
+        }
+        else
+        {
+            // IvyBranch records
+            inputs[0].EntrypointIndex     = m_WorkGraphEntryPoints.IvyBranch;
+            inputs[0].NumRecords          = static_cast<UINT>(m_ivyBranchRecords.size());
+            inputs[0].pRecords            = m_ivyBranchRecords.data();
+            inputs[0].RecordStrideInBytes = sizeof(IvyBranchRecord);
+
+            inputs[1].EntrypointIndex     = m_WorkGraphEntryPoints.IvyArea;
+            inputs[1].NumRecords          = static_cast<UINT>(m_ivyAreaRecords.size());
+            inputs[1].pRecords            = m_ivyAreaRecords.data();
+            inputs[1].RecordStrideInBytes = sizeof(IvyAreaRecord);
+
+            dispatchDesc.Mode                                     = D3D12_DISPATCH_MODE_MULTI_NODE_CPU_INPUT;
+            dispatchDesc.MultiNodeCPUInput                        = {};
+            dispatchDesc.MultiNodeCPUInput.NumNodeInputs          = WorkGraphEntryPointCount;
+            dispatchDesc.MultiNodeCPUInput.pNodeInputs            = inputs;
+            dispatchDesc.MultiNodeCPUInput.NodeInputStrideInBytes = sizeof(D3D12_NODE_CPU_INPUT);
+        }
 
-        commandList->SetProgram(&m_WorkGraphProgramDesc);
-        commandList->DispatchGraph(&dispatchDesc);
+        DispatchGraph(dispatchDesc);
+    }
 
-        // Release command list (only releases additional reference created by QueryInterface)
-        commandList->Release();
+    // Release command list (only releases additional reference created by QueryInterface)
+    commandList->Release();
 
-        // Clear backing memory initialization flag, as the graph has run at least once now
-        m_WorkGraphProgramDesc.WorkGraph.Flags &= ~D3D12_SET_WORK_GRAPH_FLAG_INITIALIZE;
+    m_gbufferPass.executed           = true;
+    m_gbufferPass.recordLineageTrace = recordLineageTrace;
+    m_gbufferPass.useGrowthCache     = useGrowthCache;
+    m_gbufferPass.workGraphData      = workGraphData;
+}
+
+void IvyRenderModule::Execute(double deltaTime, cauldron::CommandList* pCmdList)
+{
+    // Nothing was grown if GBufferRenderModule didn't run its raster pass in this frame
+    if (!m_gbufferPass.executed)
+    {
+        return;
     }
 
-    EndRaster(pCmdList, nullptr);
+    m_gbufferPass.executed = false;
 
-    // Transition render targets back to readable state
+    const bool useGrowthCache = m_gbufferPass.useGrowthCache;
+
+    if (m_useIvyShadows)
+    {
+        // Wait for growth to complete appending to the growth cache
+        Barrier cacheBarrier = Barrier::UAV(m_pGrowthCacheBuffers[1 - m_growthCacheReadIndex]->GetResource());
+        ResourceBarrier(pCmdList, 1, &cacheBarrier);
+
+        ExecuteShadowPass(pCmdList, m_gbufferPass.workGraphData);
+    }
+
+    // Transition buffers written by growth back to their states in between frames
+    auto& barriers = m_gbufferPass.barriers;
     for (auto& barrier : barriers)
     {
         std::swap(barrier.DestState, barrier.SourceState);
     }
 
     ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+    if (m_useStatistics)
+    {
+        UpdateStatistics(pCmdList);
+    }
+
+    UpdateLineageTrace(pCmdList, m_gbufferPass.recordLineageTrace);
+
+    if (m_useOutputDigests)
+    {
+        UpdateOutputDigests(pCmdList);
+    }
+
+    UpdateHitCacheInspection(pCmdList);
+
+    if (useGrowthCache)
+    {
+        UpdateGrowthOverflow(pCmdList);
+    }
+
+    // Frontier & growth cache written in this frame are read in the next frame
+    if (m_useProgressiveGrowth)
+    {
+        m_frontierReadIndex = 1 - m_frontierReadIndex;
+    }
+    if (useGrowthCache)
+    {
+        m_growthCacheReadIndex = 1 - m_growthCacheReadIndex;
+    }
+    m_growthCacheWritten = useGrowthCache;
+
+    ++m_FrameIndex;
 }
 
 void IvyRenderModule::OnResize(const cauldron::ResolutionInfo& resInfo)
 {
+    // HiZ pyramid & GBufferDepth were recreated, thus their views have to be updated
+    BindHiZ();
 }
 
 void IvyRenderModule::InitTextures()
@@ -262,13 +982,6 @@ void IvyRenderModule::InitTextures()
     m_pGBufferAoRoughnessMetallicOutput = GetFramework()->GetRenderTexture(L"GBufferAoRoughnessMetallicRT");
     m_pGBufferMotionOutput              = GetFramework()->GetRenderTexture(L"GBufferMotionVectorRT");
     m_pGBufferDepthOutput               = GetFramework()->GetRenderTexture(L"GBufferDepth");
-
-    m_pGBufferRasterViews[0] = GetRasterViewAllocator()->RequestRasterView(m_pGBufferAlbedoOutput, ViewDimension::Texture2D);
-    m_pGBufferRasterViews[1] = GetRasterViewAllocator()->RequestRasterView(m_pGBufferNormalOutput, ViewDimension::Texture2D);
-    m_pGBufferRasterViews[2] = GetRasterViewAllocator()->RequestRasterView(m_pGBufferAoRoughnessMetallicOutput, ViewDimension::Texture2D);
-    m_pGBufferRasterViews[3] = GetRasterViewAllocator()->RequestRasterView(m_pGBufferMotionOutput, ViewDimension::Texture2D);
-
-    m_pGBufferDepthRasterView = GetRasterViewAllocator()->RequestRasterView(m_pGBufferDepthOutput, ViewDimension::Texture2D);
 }
 
 void IvyRenderModule::InitWorkGraphProgram()
@@ -283,6 +996,25 @@ void IvyRenderModule::InitWorkGraphProgram()
     workGraphRootSigDesc.AddBufferSRVSet(RAYTRACING_INFO_BEGIN_SLOT + 2, ShaderBindStage::Compute, 1);
     workGraphRootSigDesc.AddBufferSRVSet(RAYTRACING_INFO_BEGIN_SLOT + 3, ShaderBindStage::Compute, 1);
 
+    workGraphRootSigDesc.AddBufferSRVSet(AREA_POISSON_DISK_POINTS, ShaderBindStage::Compute, 1);
+    workGraphRootSigDesc.AddBufferSRVSet(AREA_SURFACE_SAMPLING_TRIANGLES, ShaderBindStage::Compute, 1);
+    workGraphRootSigDesc.AddBufferSRVSet(IVY_SDF_BRICK_INDICES, ShaderBindStage::Compute, 1);
+    workGraphRootSigDesc.AddBufferSRVSet(IVY_SDF_BRICKS, ShaderBindStage::Compute, 1);
+    workGraphRootSigDesc.AddBufferSRVSet(IVY_FACE_NORMAL_OFFSETS, ShaderBindStage::Compute, 1);
+    workGraphRootSigDesc.AddBufferSRVSet(IVY_FACE_NORMALS, ShaderBindStage::Compute, 1);
+    workGraphRootSigDesc.AddTextureSRVSet(IVY_HIZ, ShaderBindStage::Compute, 1);
+    workGraphRootSigDesc.AddTextureSRVSet(IVY_LEAF_CARD_MASK, ShaderBindStage::Compute, 1);
+
+    workGraphRootSigDesc.AddBufferUAVSet(IVY_STATISTICS, ShaderBindStage::Compute, 1);
+    workGraphRootSigDesc.AddBufferUAVSet(IVY_ROOT_STATISTICS, ShaderBindStage::Compute, 1);
+    workGraphRootSigDesc.AddBufferUAVSet(IVY_LINEAGE_TRACE, ShaderBindStage::Compute, 1);
+    workGraphRootSigDesc.AddBufferUAVSet(IVY_OUTPUT_DIGESTS, ShaderBindStage::Compute, 1);
+    workGraphRootSigDesc.AddBufferUAVSet(IVY_HIT_CACHE, ShaderBindStage::Compute, 1);
+    workGraphRootSigDesc.AddBufferUAVSet(IVY_FRONTIER, ShaderBindStage::Compute, 2);
+    workGraphRootSigDesc.AddBufferUAVSet(IVY_GROWTH_CACHE, ShaderBindStage::Compute, 2);
+    workGraphRootSigDesc.AddTextureUAVSet(IVY_LEAF_CARD_MASK_BAKE, ShaderBindStage::Compute, 1);
+    workGraphRootSigDesc.AddBufferUAVSet(IVY_MESHLETS, ShaderBindStage::Compute, 1);
+
     workGraphRootSigDesc.AddTextureSRVSet(TEXTURE_BEGIN_SLOT, ShaderBindStage::Compute, MAX_TEXTURES_COUNT);
 
     workGraphRootSigDesc.AddBufferSRVSet(INDEX_BUFFER_BEGIN_SLOT, ShaderBindStage::Compute, MAX_BUFFER_COUNT);
@@ -315,6 +1047,19 @@ void IvyRenderModule::InitWorkGraphProgram()
         }
     }
 
+    // Check if ray queries are supported, otherwise growth queries fall back to the baked distance field
+    {
+        D3D12_FEATURE_DATA_D3D12_OPTIONS5 options = {};
+        CauldronThrowOnFail(d3dDevice->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS5, &options, sizeof(options)));
+
+        m_rayQueriesSupported = (options.RaytracingTier >= D3D12_RAYTRACING_TIER_1_1);
+
+        if (!m_rayQueriesSupported)
+        {
+            CauldronWarning(L"Ray queries are not supported on the current device. Ivy growth uses SDF queries.");
+        }
+    }
+
     // Create work graph
     CD3DX12_STATE_OBJECT_DESC stateObjectDesc(D3D12_STATE_OBJECT_TYPE_EXECUTABLE);
 
@@ -336,10 +1081,17 @@ void IvyRenderModule::InitWorkGraphProgram()
     // list of compiled shaders to be released once the work graph is created
     std::vector<IDxcBlob*> compiledShaders;
 
+    // compile out all ray queries if the device doesn't support them
+    std::vector<DxcDefine> shaderDefines;
+    if (!m_rayQueriesSupported)
+    {
+        shaderDefines.push_back({L"IVY_SDF_QUERIES_ONLY", L"1"});
+    }
+
     // Helper function for adding a shader library to the work graph state object
     const auto AddShaderLibrary = [&](const wchar_t* shaderFileName) {
         // compile shader as library
-        auto* blob           = shaderCompiler.CompileShader(shaderFileName, L"lib_6_9", nullptr);
+        auto* blob           = shaderCompiler.CompileShader(shaderFileName, L"lib_6_9", nullptr, shaderDefines);
         auto  shaderBytecode = CD3DX12_SHADER_BYTECODE(blob->GetBufferPointer(), blob->GetBufferSize());
 
         // add blob to state object
@@ -355,7 +1107,7 @@ void IvyRenderModule::InitWorkGraphProgram()
     // for the pixel shader (exportName) with which the generic program can reference the pixel shader
     const auto AddPixelShader = [&](const wchar_t* shaderFileName, const wchar_t* entryPoint, const wchar_t* exportName) {
         // compile shader as pixel shader
-        auto* blob           = shaderCompiler.CompileShader(shaderFileName, L"ps_6_9", entryPoint);
+        auto* blob           = shaderCompiler.CompileShader(shaderFileName, L"ps_6_9", entryPoint, shaderDefines);
         auto  shaderBytecode = CD3DX12_SHADER_BYTECODE(blob->GetBufferPointer(), blob->GetBufferSize());
 
         // add blob to state object
@@ -431,6 +1183,8 @@ void IvyRenderModule::InitWorkGraphProgram()
     // Shader libraries for ivy generation
     AddShaderLibrary(L"area.hlsl");
     AddShaderLibrary(L"ivy.hlsl");
+    AddShaderLibrary(L"growthcache.hlsl");
+    AddShaderLibrary(L"meshletbake.hlsl");
 
     AddShaderLibrary(L"ivystemrenderer.hlsl");
     AddPixelShader(L"ivystemrenderer.hlsl", L"PixelShader", L"IvyStemPixelShader");
@@ -440,6 +1194,11 @@ void IvyRenderModule::InitWorkGraphProgram()
     AddPixelShader(L"ivyleafrenderer.hlsl", L"PixelShader", L"IvyLeafPixelShader");
     AddMeshNode(L"IvyLeafMeshShader", L"IvyLeafPixelShader", true);
 
+    // Cards are visible from both sides of the surface
+    AddShaderLibrary(L"ivyleafcard.hlsl");
+    AddPixelShader(L"ivyleafcard.hlsl", L"PixelShader", L"IvyLeafCardPixelShader");
+    AddMeshNode(L"IvyLeafCardMeshShader", L"IvyLeafCardPixelShader", false);
+
     // Create work graph state object
     CauldronThrowOnFail(d3dDevice->CreateStateObject(stateObjectDesc, IID_PPV_ARGS(&m_pWorkGraphStateObject)));
 
@@ -454,55 +1213,1841 @@ void IvyRenderModule::InitWorkGraphProgram()
 
     // Get work graph properties
     ID3D12StateObjectProperties1* stateObjectProperties;
-    ID3D12WorkGraphProperties1*   workGraphProperties;
 
     CauldronThrowOnFail(m_pWorkGraphStateObject->QueryInterface(IID_PPV_ARGS(&stateObjectProperties)));
-    CauldronThrowOnFail(m_pWorkGraphStateObject->QueryInterface(IID_PPV_ARGS(&workGraphProperties)));
+    // Work graph properties are kept to update the input record limit when records are added
+    CauldronThrowOnFail(m_pWorkGraphStateObject->QueryInterface(IID_PPV_ARGS(&m_pWorkGraphProperties)));
 
     // Get the index of our work graph inside the state object (state object can contain multiple work graphs)
-    const auto workGraphIndex = workGraphProperties->GetWorkGraphIndex(WorkGraphProgramName);
-
-    // Set the input record limit. This is required for work graphs with mesh nodes.
-    workGraphProperties->SetMaximumInputRecords(workGraphIndex, static_cast<UINT>(m_ivyBranchRecords.size() + m_ivyAreaRecords.size()), 2);
-
-    // Create backing memory buffer
-    D3D12_WORK_GRAPH_MEMORY_REQUIREMENTS memoryRequirements = {};
-    workGraphProperties->GetWorkGraphMemoryRequirements(workGraphIndex, &memoryRequirements);
-    if (memoryRequirements.MaxSizeInBytes > 0)
-    {
-        BufferDesc bufferDesc = BufferDesc::Data(L"MeshNodeSample_WorkGraphBackingMemory",
-                                                 static_cast<uint32_t>(memoryRequirements.MaxSizeInBytes),
-                                                 1,
-                                                 D3D12_WORK_GRAPHS_BACKING_MEMORY_ALIGNMENT_IN_BYTES,
-                                                 ResourceFlags::AllowUnorderedAccess);
-
-        m_pWorkGraphBackingMemoryBuffer = Buffer::CreateBufferResource(&bufferDesc, ResourceState::UnorderedAccess);
-    }
+    m_WorkGraphIndex = m_pWorkGraphProperties->GetWorkGraphIndex(WorkGraphProgramName);
 
     // Prepare work graph desc
     m_WorkGraphProgramDesc.Type                        = D3D12_PROGRAM_TYPE_WORK_GRAPH;
     m_WorkGraphProgramDesc.WorkGraph.ProgramIdentifier = stateObjectProperties->GetProgramIdentifier(WorkGraphProgramName);
-    // Set flag to initialize backing memory.
-    // We'll clear this flag once we've run the work graph for the first time.
-    m_WorkGraphProgramDesc.WorkGraph.Flags = D3D12_SET_WORK_GRAPH_FLAG_INITIALIZE;
-    // Set backing memory
-    if (m_pWorkGraphBackingMemoryBuffer)
-    {
-        const auto addressInfo                                      = m_pWorkGraphBackingMemoryBuffer->GetAddressInfo();
-        m_WorkGraphProgramDesc.WorkGraph.BackingMemory.StartAddress = addressInfo.GetImpl()->GPUBufferView;
+
+    // Set input record limit & create backing memory buffer
+    UpdateWorkGraphInputCapacity();
+
+    // Query entry point indices
+    m_WorkGraphEntryPoints.IvyBranch           = m_pWorkGraphProperties->GetEntrypointIndex(m_WorkGraphIndex, {L"IvyBranch", 0});
+    m_WorkGraphEntryPoints.IvyArea             = m_pWorkGraphProperties->GetEntrypointIndex(m_WorkGraphIndex, {L"IvyArea", 0});
+    m_WorkGraphEntryPoints.IvyGrowthCacheDraw  = m_pWorkGraphProperties->GetEntrypointIndex(m_WorkGraphIndex, {L"IvyGrowthCacheDraw", 0});
+    m_WorkGraphEntryPoints.IvyLeafCardMaskBake = m_pWorkGraphProperties->GetEntrypointIndex(m_WorkGraphIndex, {L"IvyLeafCardMaskBake", 0});
+    m_WorkGraphEntryPoints.IvyMeshletBake      = m_pWorkGraphProperties->GetEntrypointIndex(m_WorkGraphIndex, {L"IvyMeshletBake", 0});
+
+    // Release state object properties
+    stateObjectProperties->Release();
+
+    // Release ID3D12Device9 (only releases additional reference created by QueryInterface)
+    d3dDevice->Release();
+}
+
+void IvyRenderModule::InitShadowWorkGraphProgram()
+{
+    // Shadow work graph only reads constants & the growth caches
+    RootSignatureDesc shadowRootSigDesc;
+    shadowRootSigDesc.AddConstantBufferView(0, ShaderBindStage::Compute, 1);
+    shadowRootSigDesc.AddConstantBufferView(1, ShaderBindStage::Compute, 1);
+    shadowRootSigDesc.AddBufferUAVSet(IVY_GROWTH_CACHE, ShaderBindStage::Compute, 2);
+
+    shadowRootSigDesc.m_PipelineType = PipelineType::Graphics;
+
+    m_pShadowRootSignature = RootSignature::CreateRootSignature(L"IvySample_ShadowRootSignature", shadowRootSigDesc);
+
+    m_pShadowParameterSet = ParameterSet::CreateParameterSet(m_pShadowRootSignature);
+    m_pShadowParameterSet->SetRootConstantBufferResource(GetDynamicBufferPool()->GetResource(), sizeof(WorkGraphCBData), 0);
+    m_pShadowParameterSet->SetRootConstantBufferResource(GetDynamicBufferPool()->GetResource(), sizeof(IvyShadowCBData), 1);
+
+    ID3D12Device9* d3dDevice = nullptr;
+    CauldronThrowOnFail(GetDevice()->GetImpl()->DX12Device()->QueryInterface(IID_PPV_ARGS(&d3dDevice)));
+
+    // Shadow maps need different graphics state than the GBuffer, thus the shadow work graph lives in its own state object
+    CD3DX12_STATE_OBJECT_DESC stateObjectDesc(D3D12_STATE_OBJECT_TYPE_EXECUTABLE);
+
+    auto configSubobject = stateObjectDesc.CreateSubobject<CD3DX12_STATE_OBJECT_CONFIG_SUBOBJECT>();
+    configSubobject->SetFlags(D3D12_STATE_OBJECT_FLAG_WORK_GRAPHS_USE_GRAPHICS_STATE_FOR_GLOBAL_ROOT_SIGNATURE);
+
+    auto rootSignatureSubobject = stateObjectDesc.CreateSubobject<CD3DX12_GLOBAL_ROOT_SIGNATURE_SUBOBJECT>();
+    rootSignatureSubobject->SetRootSignature(m_pShadowRootSignature->GetImpl()->DX12RootSignature());
+
+    auto workgraphSubobject = stateObjectDesc.CreateSubobject<CD3DX12_WORK_GRAPH_SUBOBJECT>();
+    workgraphSubobject->IncludeAllAvailableNodes();
+    workgraphSubobject->SetProgramName(ShadowWorkGraphProgramName);
+
+    ShaderCompiler shaderCompiler;
+
+    auto* blob           = shaderCompiler.CompileShader(L"ivyshadow.hlsl", L"lib_6_9", nullptr);
+    auto  shaderBytecode = CD3DX12_SHADER_BYTECODE(blob->GetBufferPointer(), blob->GetBufferSize());
+
+    auto librarySubobject = stateObjectDesc.CreateSubobject<CD3DX12_DXIL_LIBRARY_SUBOBJECT>();
+    librarySubobject->SetDXILLibrary(&shaderBytecode);
+
+    // Stems are thin & leaves are single-sided, thus both cast shadows from either side
+    auto rasterizerSubobject = stateObjectDesc.CreateSubobject<CD3DX12_RASTERIZER_SUBOBJECT>();
+    rasterizerSubobject->SetFrontCounterClockwise(true);
+    rasterizerSubobject->SetFillMode(D3D12_FILL_MODE_SOLID);
+    rasterizerSubobject->SetCullMode(D3D12_CULL_MODE_NONE);
+
+    auto primitiveTopologySubobject = stateObjectDesc.CreateSubobject<CD3DX12_PRIMITIVE_TOPOLOGY_SUBOBJECT>();
+    primitiveTopologySubobject->SetPrimitiveTopologyType(D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE);
+
+    auto depthStencilFormatSubobject = stateObjectDesc.CreateSubobject<CD3DX12_DEPTH_STENCIL_FORMAT_SUBOBJECT>();
+    depthStencilFormatSubobject->SetDepthStencilFormat(GetDXGIFormat(ShadowMapFormat));
+
+    auto renderTargetFormatSubobject = stateObjectDesc.CreateSubobject<CD3DX12_RENDER_TARGET_FORMATS_SUBOBJECT>();
+    renderTargetFormatSubobject->SetNumRenderTargets(0);
+
+    // Depth-only mesh nodes don't have a pixel shader
+    for (const wchar_t* meshShaderExportName : {L"IvyStemShadowMeshShader", L"IvyLeafShadowMeshShader"})
+    {
+        auto genericProgramSubobject = stateObjectDesc.CreateSubobject<CD3DX12_GENERIC_PROGRAM_SUBOBJECT>();
+        genericProgramSubobject->AddExport(meshShaderExportName);
+        genericProgramSubobject->AddSubobject(*rasterizerSubobject);
+        genericProgramSubobject->AddSubobject(*primitiveTopologySubobject);
+        genericProgramSubobject->AddSubobject(*depthStencilFormatSubobject);
+        genericProgramSubobject->AddSubobject(*renderTargetFormatSubobject);
+    }
+
+    CauldronThrowOnFail(d3dDevice->CreateStateObject(stateObjectDesc, IID_PPV_ARGS(&m_pShadowStateObject)));
+
+    blob->Release();
+
+    ID3D12StateObjectProperties1* stateObjectProperties;
+    ID3D12WorkGraphProperties1*   workGraphProperties;
+    CauldronThrowOnFail(m_pShadowStateObject->QueryInterface(IID_PPV_ARGS(&stateObjectProperties)));
+    CauldronThrowOnFail(m_pShadowStateObject->QueryInterface(IID_PPV_ARGS(&workGraphProperties)));
+
+    const UINT workGraphIndex = workGraphProperties->GetWorkGraphIndex(ShadowWorkGraphProgramName);
+
+    // Each shadow map render target is drawn with a single record of the cache draw entry node
+    workGraphProperties->SetMaximumInputRecords(workGraphIndex, 1, 1);
+
+    D3D12_WORK_GRAPH_MEMORY_REQUIREMENTS memoryRequirements = {};
+    workGraphProperties->GetWorkGraphMemoryRequirements(workGraphIndex, &memoryRequirements);
+
+    BufferDesc bufferDesc = BufferDesc::Data(L"IvySample_ShadowBackingMemory",
+                                             static_cast<uint32_t>(memoryRequirements.MaxSizeInBytes),
+                                             1,
+                                             D3D12_WORK_GRAPHS_BACKING_MEMORY_ALIGNMENT_IN_BYTES,
+                                             ResourceFlags::AllowUnorderedAccess);
+
+    m_pShadowBackingMemoryBuffer = Buffer::CreateBufferResource(&bufferDesc, ResourceState::UnorderedAccess);
+
+    const auto addressInfo                                   = m_pShadowBackingMemoryBuffer->GetAddressInfo();
+    m_ShadowProgramDesc.Type                                 = D3D12_PROGRAM_TYPE_WORK_GRAPH;
+    m_ShadowProgramDesc.WorkGraph.ProgramIdentifier          = stateObjectProperties->GetProgramIdentifier(ShadowWorkGraphProgramName);
+    m_ShadowProgramDesc.WorkGraph.Flags                      = D3D12_SET_WORK_GRAPH_FLAG_INITIALIZE;
+    m_ShadowProgramDesc.WorkGraph.BackingMemory.StartAddress = addressInfo.GetImpl()->GPUBufferView;
+    m_ShadowProgramDesc.WorkGraph.BackingMemory.SizeInBytes  = addressInfo.GetImpl()->SizeInBytes;
+
+    m_ShadowEntryPoint = workGraphProperties->GetEntrypointIndex(workGraphIndex, {L"IvyShadowCacheDraw", 0});
+
+    workGraphProperties->Release();
+    stateObjectProperties->Release();
+    d3dDevice->Release();
+}
+
+void IvyRenderModule::InitAreaSamplingPoints()
+{
+    // Every tile of an ivy area uses a random offset into the same tileable point set
+    const auto points = GeneratePoissonDiskPoints(AREA_POISSON_DISK_POINT_COUNT, AreaPoissonDiskCandidateCount, 0);
+
+    BufferDesc bufferDesc = BufferDesc::Data(L"IvySample_AreaPoissonDiskPoints",
+                                             static_cast<uint32_t>(points.size() * sizeof(PoissonDiskPoint)),
+                                             sizeof(PoissonDiskPoint),
+                                             0,
+                                             ResourceFlags::None);
+
+    m_pAreaPoissonDiskPointBuffer = Buffer::CreateBufferResource(&bufferDesc, ResourceState::CopyDest);
+    m_pAreaPoissonDiskPointBuffer->CopyData(points.data(), points.size() * sizeof(PoissonDiskPoint));
+
+    m_pWorkGraphParameterSet->SetBufferSRV(m_pAreaPoissonDiskPointBuffer, AREA_POISSON_DISK_POINTS);
+}
+
+void IvyRenderModule::InitStatistics()
+{
+    const std::array<uint32_t, IVY_STATISTIC_COUNT> zeroStatistics = {};
+
+    BufferDesc bufferDesc =
+        BufferDesc::Data(L"IvySample_StatisticsBuffer", sizeof(zeroStatistics), sizeof(uint32_t), 0, ResourceFlags::AllowUnorderedAccess);
+
+    m_pStatisticsBuffer = Buffer::CreateBufferResource(&bufferDesc, ResourceState::CopyDest);
+    m_pStatisticsBuffer->CopyData(zeroStatistics.data(), sizeof(zeroStatistics));
+
+    m_pStatisticsReadback = new ReadbackRing(sizeof(zeroStatistics), RetiredResourceFrameLatency);
+
+    m_pWorkGraphParameterSet->SetBufferUAV(m_pStatisticsBuffer, IVY_STATISTICS);
+
+    UpdateRootStatisticsCapacity();
+
+    // Lineage trace; readback ring is only created once a trace is recorded
+    const std::vector<uint32_t> zeroLineageTrace(IVY_LINEAGE_TRACE_HEADER_SIZE + IVY_LINEAGE_TRACE_CAPACITY * IVY_LINEAGE_TRACE_ENTRY_SIZE, 0);
+    const uint32_t              lineageTraceSize = static_cast<uint32_t>(zeroLineageTrace.size() * sizeof(uint32_t));
+
+    BufferDesc lineageTraceDesc =
+        BufferDesc::Data(L"IvySample_LineageTraceBuffer", lineageTraceSize, sizeof(uint32_t), 0, ResourceFlags::AllowUnorderedAccess);
+
+    m_pLineageTraceBuffer = Buffer::CreateBufferResource(&lineageTraceDesc, ResourceState::CopyDest);
+    m_pLineageTraceBuffer->CopyData(zeroLineageTrace.data(), lineageTraceSize);
+
+    m_pWorkGraphParameterSet->SetBufferUAV(m_pLineageTraceBuffer, IVY_LINEAGE_TRACE);
+
+    // Golden output digests are optional
+    m_hasGoldenOutputDigests = ReadOutputDigests(GoldenOutputDigestFileName, m_goldenOutputDigests);
+}
+
+void IvyRenderModule::InitHitCache()
+{
+    const std::vector<IvyHitCacheEntry> emptyEntries(IVY_HIT_CACHE_CAPACITY, IvyHitCacheEntry{});
+    const uint32_t                      bufferSize = static_cast<uint32_t>(emptyEntries.size() * sizeof(IvyHitCacheEntry));
+
+    BufferDesc bufferDesc = BufferDesc::Data(L"IvySample_HitCacheBuffer", bufferSize, sizeof(IvyHitCacheEntry), 0, ResourceFlags::AllowUnorderedAccess);
+
+    // Hit cache is kept in copy destination state in between frames, like the statistics counters
+    m_pHitCacheBuffer = Buffer::CreateBufferResource(&bufferDesc, ResourceState::CopyDest);
+    m_pHitCacheBuffer->CopyData(emptyEntries.data(), bufferSize);
+
+    m_pWorkGraphParameterSet->SetBufferUAV(m_pHitCacheBuffer, IVY_HIT_CACHE);
+}
+
+void IvyRenderModule::InitProgressiveGrowth()
+{
+    // Frontier headers are written in UpdateProgressiveGrowth before each use
+    const uint32_t              frontierSize = (IVY_FRONTIER_RECORDS + IVY_FRONTIER_CAPACITY * IVY_FRONTIER_RECORD_SIZE) * sizeof(uint32_t);
+    const std::vector<uint32_t> zeroFrontier(frontierSize / sizeof(uint32_t), 0);
+
+    for (uint32_t frontierIndex = 0; frontierIndex < m_pFrontierBuffers.size(); ++frontierIndex)
+    {
+        const std::wstring name       = L"IvySample_FrontierBuffer" + std::to_wstring(frontierIndex);
+        BufferDesc         bufferDesc = BufferDesc::Data(name.c_str(), frontierSize, sizeof(uint32_t), 0, ResourceFlags::AllowUnorderedAccess);
+
+        // Frontiers are kept in copy destination state in between frames, like the statistics counters
+        m_pFrontierBuffers[frontierIndex] = Buffer::CreateBufferResource(&bufferDesc, ResourceState::CopyDest);
+        m_pFrontierBuffers[frontierIndex]->CopyData(zeroFrontier.data(), frontierSize);
+
+        m_pWorkGraphParameterSet->SetBufferUAV(m_pFrontierBuffers[frontierIndex], IVY_FRONTIER + frontierIndex);
+    }
+
+    // Zero stem & leaf counts mark a growth cache as empty
+    const uint32_t              growthCacheSize = IVY_GROWTH_CACHE_SIZE * sizeof(uint32_t);
+    const std::vector<uint32_t> zeroGrowthCache(IVY_GROWTH_CACHE_SIZE, 0);
+
+    for (uint32_t cacheIndex = 0; cacheIndex < m_pGrowthCacheBuffers.size(); ++cacheIndex)
+    {
+        const std::wstring name       = L"IvySample_GrowthCacheBuffer" + std::to_wstring(cacheIndex);
+        BufferDesc         bufferDesc = BufferDesc::Data(name.c_str(), growthCacheSize, sizeof(uint32_t), 0, ResourceFlags::AllowUnorderedAccess);
+
+        m_pGrowthCacheBuffers[cacheIndex] = Buffer::CreateBufferResource(&bufferDesc, ResourceState::CopyDest);
+        m_pGrowthCacheBuffers[cacheIndex]->CopyData(zeroGrowthCache.data(), growthCacheSize);
+
+        m_pWorkGraphParameterSet->SetBufferUAV(m_pGrowthCacheBuffers[cacheIndex], IVY_GROWTH_CACHE + cacheIndex);
+        m_pShadowParameterSet->SetBufferUAV(m_pGrowthCacheBuffers[cacheIndex], IVY_GROWTH_CACHE + cacheIndex);
+    }
+}
+
+void IvyRenderModule::InitHiZ()
+{
+    // Pyramid is sized for the display resolution; with upscaling, only the mips of the render region are built
+    const auto& resInfo = GetFramework()->GetResolutionInfo();
+
+    uint32_t mipWidth, mipHeight;
+    HiZPyramid::GetMipSize(resInfo.DisplayWidth, resInfo.DisplayHeight, 0, mipWidth, mipHeight);
+
+    TextureDesc textureDesc = TextureDesc::Tex2D(L"IvySample_HiZ",
+                                                 ResourceFormat::R32_FLOAT,
+                                                 mipWidth,
+                                                 mipHeight,
+                                                 1,
+                                                 HiZPyramid::GetMipCount(resInfo.DisplayWidth, resInfo.DisplayHeight),
+                                                 ResourceFlags::AllowUnorderedAccess);
+
+    m_pHiZTexture = GetDynamicResourcePool()->CreateRenderTexture(
+        &textureDesc, [](TextureDesc& desc, uint32_t displayWidth, uint32_t displayHeight, uint32_t renderingWidth, uint32_t renderingHeight) {
+            HiZPyramid::GetMipSize(displayWidth, displayHeight, 0, desc.Width, desc.Height);
+            desc.MipLevels = HiZPyramid::GetMipCount(displayWidth, displayHeight);
+        });
+
+    RootSignatureDesc hizRootSigDesc;
+    hizRootSigDesc.AddConstantBufferView(2, ShaderBindStage::Compute, 1);
+    hizRootSigDesc.AddTextureSRVSet(IVY_HIZ_BUILD_DEPTH, ShaderBindStage::Compute, 1);
+    hizRootSigDesc.AddTextureUAVSet(IVY_HIZ_BUILD_MIPS, ShaderBindStage::Compute, IVY_HIZ_MAX_MIPS);
+
+    hizRootSigDesc.m_PipelineType = PipelineType::Compute;
+
+    m_pHiZRootSignature = RootSignature::CreateRootSignature(L"IvySample_HiZRootSignature", hizRootSigDesc);
+
+    m_pHiZParameterSet = ParameterSet::CreateParameterSet(m_pHiZRootSignature);
+    m_pHiZParameterSet->SetRootConstantBufferResource(GetDynamicBufferPool()->GetResource(), sizeof(HiZCBData), 0);
+
+    ShaderCompiler shaderCompiler;
+
+    auto* blob = shaderCompiler.CompileShader(L"hiz.hlsl", L"cs_6_6", L"DownsampleHiZ");
+
+    D3D12_COMPUTE_PIPELINE_STATE_DESC pipelineStateDesc = {};
+    pipelineStateDesc.pRootSignature                    = m_pHiZRootSignature->GetImpl()->DX12RootSignature();
+    pipelineStateDesc.CS                                = CD3DX12_SHADER_BYTECODE(blob->GetBufferPointer(), blob->GetBufferSize());
+
+    CauldronThrowOnFail(GetDevice()->GetImpl()->DX12Device()->CreateComputePipelineState(&pipelineStateDesc, IID_PPV_ARGS(&m_pHiZPipelineState)));
+
+    blob->Release();
+
+    BindHiZ();
+}
+
+void IvyRenderModule::BindHiZ()
+{
+    m_pHiZParameterSet->SetTextureSRV(m_pGBufferDepthOutput, ViewDimension::Texture2D, IVY_HIZ_BUILD_DEPTH);
+
+    // Slots past the last mip are never written, but bound to the last mip such that all descriptors are valid
+    const uint32_t mipCount = m_pHiZTexture->GetDesc().MipLevels;
+    for (uint32_t slot = 0; slot < IVY_HIZ_MAX_MIPS; ++slot)
+    {
+        m_pHiZParameterSet->SetTextureUAV(m_pHiZTexture, ViewDimension::Texture2D, IVY_HIZ_BUILD_MIPS + slot, std::min(slot, mipCount - 1));
+    }
+
+    m_pWorkGraphParameterSet->SetTextureSRV(m_pHiZTexture, ViewDimension::Texture2D, IVY_HIZ);
+}
+
+void IvyRenderModule::InitLeafCards()
+{
+    TextureDesc textureDesc = TextureDesc::Tex2D(L"IvySample_LeafCardMask",
+                                                 ResourceFormat::RGBA16_FLOAT,
+                                                 IVY_LEAF_CARD_MASK_SIZE,
+                                                 IVY_LEAF_CARD_MASK_SIZE,
+                                                 1,
+                                                 1,
+                                                 ResourceFlags::AllowUnorderedAccess);
+
+    m_pLeafCardMaskTexture = GetDynamicResourcePool()->CreateRenderTexture(&textureDesc);
+
+    m_pWorkGraphParameterSet->SetTextureSRV(m_pLeafCardMaskTexture, ViewDimension::Texture2D, IVY_LEAF_CARD_MASK);
+    m_pWorkGraphParameterSet->SetTextureUAV(m_pLeafCardMaskTexture, ViewDimension::Texture2D, IVY_LEAF_CARD_MASK_BAKE);
+}
+
+void IvyRenderModule::InitMeshlets()
+{
+    // Zero meshlet counts draw nothing until the meshlets were baked
+    const uint32_t              meshletsSize = IVY_MESHLETS_SIZE * sizeof(uint32_t);
+    const std::vector<uint32_t> zeroMeshlets(IVY_MESHLETS_SIZE, 0);
+
+    BufferDesc bufferDesc = BufferDesc::Data(L"IvySample_MeshletBuffer", meshletsSize, sizeof(uint32_t), 0, ResourceFlags::AllowUnorderedAccess);
+
+    m_pMeshletBuffer = Buffer::CreateBufferResource(&bufferDesc, ResourceState::CopyDest);
+    m_pMeshletBuffer->CopyData(zeroMeshlets.data(), meshletsSize);
+
+    m_pWorkGraphParameterSet->SetBufferUAV(m_pMeshletBuffer, IVY_MESHLETS);
+}
+
+void IvyRenderModule::InitRTInfoTables()
+{
+    // Content loads start once the module is registered as content listener, thus the ring exists before the first upload
+    m_pRTInfoUploadRing = new UploadRing(RTInfoUploadRingSize);
+}
+
+void IvyRenderModule::UpdateWorkGraphInputCapacity()
+{
+    // Frontier dispatches of progressive growth can hold up to IVY_FRONTIER_CAPACITY records
+    const UINT entryRecordCount = static_cast<UINT>(m_ivyBranchRecords.size() + m_ivyAreaRecords.size());
+    const UINT recordCount      = m_useProgressiveGrowth ? std::max(entryRecordCount, static_cast<UINT>(IVY_FRONTIER_CAPACITY)) : entryRecordCount;
+
+    if ((m_WorkGraphInputRecordCapacity > 0) && (recordCount <= m_WorkGraphInputRecordCapacity))
+    {
+        return;
+    }
+
+    // Grow capacity geometrically, such that adding many records only re-initializes the work graph a few times
+    UINT capacity = std::max(m_WorkGraphInputRecordCapacity, WorkGraphMinInputRecordCapacity);
+    while (capacity < recordCount)
+    {
+        capacity *= 2;
+    }
+
+    // Set the input record limit. This is required for work graphs with mesh nodes.
+    m_pWorkGraphProperties->SetMaximumInputRecords(m_WorkGraphIndex, capacity, WorkGraphEntryPointCount);
+
+    // Memory requirements depend on the input record limit and thus need to be queried again
+    D3D12_WORK_GRAPH_MEMORY_REQUIREMENTS memoryRequirements = {};
+    m_pWorkGraphProperties->GetWorkGraphMemoryRequirements(m_WorkGraphIndex, &memoryRequirements);
+
+    if (memoryRequirements.MaxSizeInBytes > m_WorkGraphProgramDesc.WorkGraph.BackingMemory.SizeInBytes)
+    {
+        // Previous backing memory might still be in use by frames in flight
+        if (m_pWorkGraphBackingMemoryBuffer)
+        {
+            RetireBuffer(m_pWorkGraphBackingMemoryBuffer);
+            m_pWorkGraphBackingMemoryBuffer = nullptr;
+        }
+
+        BufferDesc bufferDesc = BufferDesc::Data(L"MeshNodeSample_WorkGraphBackingMemory",
+                                                 static_cast<uint32_t>(memoryRequirements.MaxSizeInBytes),
+                                                 1,
+                                                 D3D12_WORK_GRAPHS_BACKING_MEMORY_ALIGNMENT_IN_BYTES,
+                                                 ResourceFlags::AllowUnorderedAccess);
+
+        m_pWorkGraphBackingMemoryBuffer = Buffer::CreateBufferResource(&bufferDesc, ResourceState::UnorderedAccess);
+
+        // Set backing memory
+        const auto addressInfo                                      = m_pWorkGraphBackingMemoryBuffer->GetAddressInfo();
+        m_WorkGraphProgramDesc.WorkGraph.BackingMemory.StartAddress = addressInfo.GetImpl()->GPUBufferView;
         m_WorkGraphProgramDesc.WorkGraph.BackingMemory.SizeInBytes  = addressInfo.GetImpl()->SizeInBytes;
     }
 
-    // Query entry point indices
-    m_WorkGraphEntryPoints.IvyBranch = workGraphProperties->GetEntrypointIndex(workGraphIndex, {L"IvyBranch", 0});
-    m_WorkGraphEntryPoints.IvyArea   = workGraphProperties->GetEntrypointIndex(workGraphIndex, {L"IvyArea", 0});
+    // Set flag to initialize backing memory, as the input record limit has changed.
+    // We'll clear this flag once we've run the work graph for the first time.
+    m_WorkGraphProgramDesc.WorkGraph.Flags |= D3D12_SET_WORK_GRAPH_FLAG_INITIALIZE;
+
+    m_WorkGraphInputRecordCapacity = capacity;
+}
+
+void IvyRenderModule::UpdateEntryRecordBuffer(cauldron::CommandList* pCmdList)
+{
+    const UINT branchCount = static_cast<UINT>(m_ivyBranchRecords.size());
+    const UINT areaCount   = static_cast<UINT>(m_ivyAreaRecords.size());
+
+    struct EntryRecordBufferHeader
+    {
+        D3D12_MULTI_NODE_GPU_INPUT multiNodeInput;
+        D3D12_NODE_GPU_INPUT       nodeInputs[WorkGraphEntryPointCount];
+    };
+
+    // Each record array can hold as many records as the work graph input record limit
+    const uint32_t branchRecordOffset =
+        ((sizeof(EntryRecordBufferHeader) + EntryRecordBufferRecordAlignment - 1) / EntryRecordBufferRecordAlignment) * EntryRecordBufferRecordAlignment;
+    const uint32_t areaRecordOffset = branchRecordOffset + m_WorkGraphInputRecordCapacity * sizeof(IvyBranchRecord);
+    const uint32_t bufferSize       = areaRecordOffset + m_WorkGraphInputRecordCapacity * sizeof(IvyAreaRecord);
+
+    const auto GetHeader = [&](D3D12_GPU_VIRTUAL_ADDRESS bufferAddress) {
+        EntryRecordBufferHeader header = {};
+
+        header.multiNodeInput.NumNodeInputs            = WorkGraphEntryPointCount;
+        header.multiNodeInput.NodeInputs.StartAddress  = bufferAddress + offsetof(EntryRecordBufferHeader, nodeInputs);
+        header.multiNodeInput.NodeInputs.StrideInBytes = sizeof(D3D12_NODE_GPU_INPUT);
+
+        header.nodeInputs[0].EntrypointIndex       = m_WorkGraphEntryPoints.IvyBranch;
+        header.nodeInputs[0].NumRecords            = branchCount;
+        header.nodeInputs[0].Records.StartAddress  = bufferAddress + branchRecordOffset;
+        header.nodeInputs[0].Records.StrideInBytes = sizeof(IvyBranchRecord);
+
+        header.nodeInputs[1].EntrypointIndex       = m_WorkGraphEntryPoints.IvyArea;
+        header.nodeInputs[1].NumRecords            = areaCount;
+        header.nodeInputs[1].Records.StartAddress  = bufferAddress + areaRecordOffset;
+        header.nodeInputs[1].Records.StrideInBytes = sizeof(IvyAreaRecord);
+
+        return header;
+    };
+
+    if (m_entryRecordBufferCapacity != m_WorkGraphInputRecordCapacity)
+    {
+        // Buffer might still be in use by frames in flight, thus a new buffer is created for the full upload
+        if (m_pEntryRecordBuffer)
+        {
+            RetireBuffer(m_pEntryRecordBuffer);
+        }
+
+        BufferDesc bufferDesc = BufferDesc::Data(L"IvySample_EntryRecordBuffer", bufferSize, 1, EntryRecordBufferRecordAlignment, ResourceFlags::None);
+        m_pEntryRecordBuffer  = Buffer::CreateBufferResource(&bufferDesc, ResourceState::CopyDest);
+
+        const auto header = GetHeader(m_pEntryRecordBuffer->GetAddressInfo().GetImpl()->GPUBufferView);
+
+        std::vector<uint8_t> bufferData(bufferSize, 0);
+        memcpy(bufferData.data(), &header, sizeof(header));
+        memcpy(bufferData.data() + branchRecordOffset, m_ivyBranchRecords.data(), branchCount * sizeof(IvyBranchRecord));
+        memcpy(bufferData.data() + areaRecordOffset, m_ivyAreaRecords.data(), areaCount * sizeof(IvyAreaRecord));
+
+        m_pEntryRecordBuffer->CopyData(bufferData.data(), bufferData.size());
+
+        std::vector<Barrier> barriers = {Barrier::Transition(m_pEntryRecordBuffer->GetResource(), ResourceState::CopyDest, EntryRecordBufferReadState)};
+        ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+        m_entryRecordBufferCapacity = m_WorkGraphInputRecordCapacity;
+        m_entryRecordBufferBranches = branchCount;
+        m_entryRecordBufferAreas    = areaCount;
+        m_dirtyIvyBranchRecords.clear();
+        m_dirtyIvyAreaRecords.clear();
+
+        return;
+    }
+
+    const bool headerDirty = (m_entryRecordBufferBranches != branchCount) || (m_entryRecordBufferAreas != areaCount);
+
+    if (!headerDirty && m_dirtyIvyBranchRecords.empty() && m_dirtyIvyAreaRecords.empty())
+    {
+        return;
+    }
+
+    std::vector<Barrier> barriers = {Barrier::Transition(m_pEntryRecordBuffer->GetResource(), EntryRecordBufferReadState, ResourceState::CopyDest)};
+    ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+    // Copies data through the dynamic upload buffer into the entry record buffer
+    const auto CopyToEntryRecordBuffer = [&](uint32_t dstOffset, const void* pData, uint32_t size) {
+        UploadBufferRegion(pCmdList, m_pEntryRecordBuffer->GetResource(), dstOffset, pData, size);
+    };
+
+    // Copies all records in dirtyRecords, merging consecutive records into a single copy
+    const auto CopyDirtyRecords = [&](std::vector<uint32_t>& dirtyRecords, const uint8_t* pRecords, uint32_t recordCount, uint32_t recordSize, uint32_t offset) {
+        std::sort(dirtyRecords.begin(), dirtyRecords.end());
+        dirtyRecords.erase(std::unique(dirtyRecords.begin(), dirtyRecords.end()), dirtyRecords.end());
+
+        size_t rangeStart = 0;
+        while (rangeStart < dirtyRecords.size())
+        {
+            size_t rangeEnd = rangeStart + 1;
+            while ((rangeEnd < dirtyRecords.size()) && (dirtyRecords[rangeEnd] == dirtyRecords[rangeEnd - 1] + 1))
+            {
+                ++rangeEnd;
+            }
+
+            const uint32_t firstRecord = dirtyRecords[rangeStart];
+            const uint32_t lastRecord  = std::min(dirtyRecords[rangeEnd - 1] + 1, recordCount);
+
+            if (firstRecord < lastRecord)
+            {
+                CopyToEntryRecordBuffer(offset + firstRecord * recordSize, pRecords + firstRecord * recordSize, (lastRecord - firstRecord) * recordSize);
+            }
+
+            rangeStart = rangeEnd;
+        }
+
+        dirtyRecords.clear();
+    };
+
+    if (headerDirty)
+    {
+        const auto header = GetHeader(m_pEntryRecordBuffer->GetAddressInfo().GetImpl()->GPUBufferView);
+        CopyToEntryRecordBuffer(0, &header, sizeof(header));
+
+        m_entryRecordBufferBranches = branchCount;
+        m_entryRecordBufferAreas    = areaCount;
+    }
+
+    CopyDirtyRecords(m_dirtyIvyBranchRecords,
+                     reinterpret_cast<const uint8_t*>(m_ivyBranchRecords.data()),
+                     branchCount,
+                     sizeof(IvyBranchRecord),
+                     branchRecordOffset);
+    CopyDirtyRecords(
+        m_dirtyIvyAreaRecords, reinterpret_cast<const uint8_t*>(m_ivyAreaRecords.data()), areaCount, sizeof(IvyAreaRecord), areaRecordOffset);
+
+    std::swap(barriers[0].SourceState, barriers[0].DestState);
+    ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+}
+
+void IvyRenderModule::UpdateSceneGeometryReadback(cauldron::CommandList* pCmdList)
+{
+    // Scene meshes whose geometry readback completed
+    std::vector<uint32_t> readMeshIndices;
+
+    auto it = m_pendingGeometryReadbacks.begin();
+    while (it != m_pendingGeometryReadbacks.end())
+    {
+        auto& readback = *it;
+
+        // glTF vertex positions are always stored as float3
+        const uint64_t positionSize = static_cast<uint64_t>(readback.vertexCount) * 3 * sizeof(float);
+        const uint64_t indexSize    = static_cast<uint64_t>(readback.indexCount) * readback.indexStride;
+
+        if (readback.pReadbackResource == nullptr)
+        {
+            // Cauldron buffers can't be placed in a readback heap, thus the readback resource is created directly
+            const CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_READBACK);
+            const CD3DX12_RESOURCE_DESC   resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(positionSize + indexSize);
+
+            CauldronThrowOnFail(GetDevice()->GetImpl()->DX12Device()->CreateCommittedResource(&heapProperties,
+                                                                                              D3D12_HEAP_FLAG_NONE,
+                                                                                              &resourceDesc,
+                                                                                              D3D12_RESOURCE_STATE_COPY_DEST,
+                                                                                              nullptr,
+                                                                                              IID_PPV_ARGS(&readback.pReadbackResource)));
+
+            const GPUResource* pPositionResource = readback.pPositionBuffer->GetResource();
+            const GPUResource* pIndexResource    = readback.pIndexBuffer->GetResource();
+
+            std::vector<Barrier> barriers;
+            barriers.push_back(Barrier::Transition(pPositionResource, pPositionResource->GetCurrentResourceState(), ResourceState::CopySource));
+            barriers.push_back(Barrier::Transition(pIndexResource, pIndexResource->GetCurrentResourceState(), ResourceState::CopySource));
+            ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+            ID3D12GraphicsCommandList* commandList = pCmdList->GetImpl()->DX12CmdList();
+            commandList->CopyBufferRegion(readback.pReadbackResource, 0, pPositionResource->GetImpl()->DX12Resource(), 0, positionSize);
+            commandList->CopyBufferRegion(readback.pReadbackResource, positionSize, pIndexResource->GetImpl()->DX12Resource(), 0, indexSize);
+
+            for (auto& barrier : barriers)
+            {
+                std::swap(barrier.DestState, barrier.SourceState);
+            }
+            ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+            readback.readbackFrame = m_FrameIndex;
+            ++it;
+        }
+        else if (m_FrameIndex >= readback.readbackFrame + RetiredResourceFrameLatency)
+        {
+            // Copy has completed, unpack indexed triangles
+            const D3D12_RANGE readRange = {0, static_cast<SIZE_T>(positionSize + indexSize)};
+            uint8_t*          pData     = nullptr;
+            CauldronThrowOnFail(readback.pReadbackResource->Map(0, &readRange, reinterpret_cast<void**>(&pData)));
+
+            const float* pPositions = reinterpret_cast<const float*>(pData);
+            const auto   GetIndex   = [&](uint32_t i) -> uint32_t {
+                return (readback.indexStride == sizeof(uint16_t)) ? reinterpret_cast<const uint16_t*>(pData + positionSize)[i]
+                                                                     : reinterpret_cast<const uint32_t*>(pData + positionSize)[i];
+            };
+
+            auto& triangleVertices = m_sceneMeshes[readback.sceneMeshIndex].triangleVertices;
+
+            const size_t firstVertex = triangleVertices.size();
+
+            for (uint32_t i = 0; i < readback.indexCount - (readback.indexCount % 3); ++i)
+            {
+                const uint32_t index = std::min(GetIndex(i), readback.vertexCount - 1);
+                triangleVertices.push_back(Vec3(pPositions[index * 3 + 0], pPositions[index * 3 + 1], pPositions[index * 3 + 2]));
+            }
+
+            // Geometric normals of counter-clockwise triangles; degenerate triangles keep 0 and fall back to vertex normals in TraceRay
+            for (size_t i = firstVertex; i + 2 < triangleVertices.size(); i += 3)
+            {
+                const Vec3 normal = cross(triangleVertices[i + 1] - triangleVertices[i], triangleVertices[i + 2] - triangleVertices[i]);
+
+                if (lengthSqr(normal) > 0.f)
+                {
+                    m_faceNormals[readback.faceNormalOffset + (i - firstVertex) / 3] = EncodeFaceNormal(normalize(normal));
+                }
+            }
+            m_readFaceNormalRanges.emplace_back(readback.faceNormalOffset,
+                                                readback.faceNormalOffset + static_cast<uint32_t>(triangleVertices.size() - firstVertex) / 3);
+
+            const D3D12_RANGE writeRange = {0, 0};
+            readback.pReadbackResource->Unmap(0, &writeRange);
+            readback.pReadbackResource->Release();
+
+            readMeshIndices.push_back(readback.sceneMeshIndex);
+
+            it = m_pendingGeometryReadbacks.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (!readMeshIndices.empty())
+    {
+        ++m_sceneGeometryVersion;
+
+        std::sort(readMeshIndices.begin(), readMeshIndices.end());
+        readMeshIndices.erase(std::unique(readMeshIndices.begin(), readMeshIndices.end()), readMeshIndices.end());
+
+        for (const uint32_t sceneMeshIndex : readMeshIndices)
+        {
+            UpdateSceneMeshSamplingTriangles(sceneMeshIndex);
+        }
+    }
+}
+
+void IvyRenderModule::UpdateFaceNormals(cauldron::CommandList* pCmdList)
+{
+    const uint32_t faceNormalCount = static_cast<uint32_t>(m_faceNormals.size());
+
+    if ((faceNormalCount == m_uploadedFaceNormalCount) && m_readFaceNormalRanges.empty())
+    {
+        return;
+    }
+
+    // Face normals of newly registered surfaces are appended; they are uploaded again once their geometry was read back
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+
+    for (const auto& range : m_readFaceNormalRanges)
+    {
+        if (range.first < m_uploadedFaceNormalCount)
+        {
+            ranges.emplace_back(range.first, std::min(range.second, m_uploadedFaceNormalCount));
+        }
+    }
+    if (faceNormalCount > m_uploadedFaceNormalCount)
+    {
+        ranges.emplace_back(m_uploadedFaceNormalCount, faceNormalCount);
+    }
+
+    if (UpdateElementBuffer(pCmdList,
+                            m_pFaceNormalBuffer,
+                            m_faceNormalCapacity,
+                            L"IvySample_FaceNormalBuffer",
+                            m_faceNormals.data(),
+                            sizeof(uint32_t),
+                            faceNormalCount,
+                            m_uploadedFaceNormalCount,
+                            ranges))
+    {
+        m_pWorkGraphParameterSet->SetBufferSRV(m_pFaceNormalBuffer, IVY_FACE_NORMALS);
+    }
+
+    m_uploadedFaceNormalCount = faceNormalCount;
+    m_readFaceNormalRanges.clear();
+}
+
+void IvyRenderModule::UpdateSceneMeshSamplingTriangles(uint32_t sceneMeshIndex)
+{
+    auto& sceneMesh = m_sceneMeshes[sceneMeshIndex];
+
+    sceneMesh.samplingTriangles.clear();
+    sceneMesh.samplingTriangleAreas.clear();
+    sceneMesh.samplingChunkBounds.clear();
+    sceneMesh.geometryVersion = m_sceneGeometryVersion;
+
+    for (const auto& instanceTransform : sceneMesh.instanceTransforms)
+    {
+        for (size_t i = 0; i + 2 < sceneMesh.triangleVertices.size(); i += 3)
+        {
+            const Vec3 vertex = (instanceTransform * Vec4(sceneMesh.triangleVertices[i + 0], 1.f)).getXYZ();
+            const Vec3 edge1  = (instanceTransform * Vec4(sceneMesh.triangleVertices[i + 1], 1.f)).getXYZ() - vertex;
+            const Vec3 edge2  = (instanceTransform * Vec4(sceneMesh.triangleVertices[i + 2], 1.f)).getXYZ() - vertex;
+
+            const float area = 0.5f * length(cross(edge1, edge2));
+
+            if (!(area > 0.f))
+            {
+                continue;
+            }
+
+            SurfaceSamplingTriangle triangle = {};
+            for (int c = 0; c < 3; ++c)
+            {
+                triangle.vertex[c] = vertex[c];
+                triangle.edge1[c]  = edge1[c];
+                triangle.edge2[c]  = edge2[c];
+            }
+
+            const Vec3 boundsMin = minPerElem(vertex, minPerElem(vertex + edge1, vertex + edge2));
+            const Vec3 boundsMax = maxPerElem(vertex, maxPerElem(vertex + edge1, vertex + edge2));
+
+            if ((sceneMesh.samplingTriangles.size() % SurfaceSamplingChunkSize) == 0)
+            {
+                sceneMesh.samplingChunkBounds.emplace_back(boundsMin, boundsMax);
+            }
+            else
+            {
+                auto& chunkBounds  = sceneMesh.samplingChunkBounds.back();
+                chunkBounds.first  = minPerElem(chunkBounds.first, boundsMin);
+                chunkBounds.second = maxPerElem(chunkBounds.second, boundsMax);
+            }
+
+            sceneMesh.samplingTriangles.push_back(triangle);
+            sceneMesh.samplingTriangleAreas.push_back(area);
+        }
+    }
+}
+
+void IvyRenderModule::UpdateAreaSurfaceSampling(cauldron::CommandList* pCmdList)
+{
+    // Tables of enabled areas are rebuilt once geometry of their mesh(es) changed; option 0 selects all meshes
+    if (m_surfaceSamplingGeometryVersion != m_sceneGeometryVersion)
+    {
+        for (uint32_t areaIndex = 0; areaIndex < m_ivyAreaSurfaceSampling.size(); ++areaIndex)
+        {
+            const auto& sampling = m_ivyAreaSurfaceSampling[areaIndex];
+
+            if (!sampling.enabled || (sampling.meshOption > static_cast<int32_t>(m_sceneMeshes.size())))
+            {
+                continue;
+            }
+
+            const uint32_t geometryVersion =
+                (sampling.meshOption == 0) ? m_sceneGeometryVersion : m_sceneMeshes[sampling.meshOption - 1].geometryVersion;
+
+            if (sampling.builtGeometryVersion < geometryVersion)
+            {
+                m_dirtySurfaceSamplingAreas.push_back(areaIndex);
+            }
+        }
+
+        m_surfaceSamplingGeometryVersion = m_sceneGeometryVersion;
+    }
+
+    std::sort(m_dirtySurfaceSamplingAreas.begin(), m_dirtySurfaceSamplingAreas.end());
+    m_dirtySurfaceSamplingAreas.erase(std::unique(m_dirtySurfaceSamplingAreas.begin(), m_dirtySurfaceSamplingAreas.end()), m_dirtySurfaceSamplingAreas.end());
+
+    for (const uint32_t areaIndex : m_dirtySurfaceSamplingAreas)
+    {
+        auto& record   = m_ivyAreaRecords[areaIndex];
+        auto& sampling = m_ivyAreaSurfaceSampling[areaIndex];
+
+        sampling.meshOption           = std::clamp(sampling.meshOption, 0, static_cast<int32_t>(m_sceneMeshes.size()));
+        sampling.builtGeometryVersion = m_sceneGeometryVersion;
+
+        // Collect the world-space triangles of the selected mesh(es) overlapping the bounding box of the area
+        std::vector<SurfaceSamplingTriangle> triangles;
+        std::vector<float>                   triangleAreas;
+
+        if (sampling.enabled)
+        {
+            const Mat4 worldToArea = InverseMatrix(record.transform);
+
+            // Chunks are culled against the world-space bounds of the area box first
+            Vec3 areaMin = Vec3(FLT_MAX, FLT_MAX, FLT_MAX);
+            Vec3 areaMax = Vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+            for (int corner = 0; corner < 8; ++corner)
+            {
+                const Vec4 cornerPosition = record.transform * Vec4((corner & 1) ? 1.f : -1.f, (corner & 2) ? 1.f : -1.f, (corner & 4) ? 1.f : -1.f, 1.f);
+
+                areaMin = minPerElem(areaMin, cornerPosition.getXYZ());
+                areaMax = maxPerElem(areaMax, cornerPosition.getXYZ());
+            }
+
+            for (size_t meshIndex = 0; meshIndex < m_sceneMeshes.size(); ++meshIndex)
+            {
+                if ((sampling.meshOption != 0) && (sampling.meshOption != static_cast<int32_t>(meshIndex) + 1))
+                {
+                    continue;
+                }
+
+                const auto& sceneMesh = m_sceneMeshes[meshIndex];
+
+                for (size_t chunk = 0; chunk < sceneMesh.samplingChunkBounds.size(); ++chunk)
+                {
+                    const auto& chunkBounds = sceneMesh.samplingChunkBounds[chunk];
+
+                    if ((maxElem(chunkBounds.first - areaMax) > 0.f) || (minElem(chunkBounds.second - areaMin) < 0.f))
+                    {
+                        continue;
+                    }
+
+                    const size_t chunkEnd = std::min((chunk + 1) * SurfaceSamplingChunkSize, sceneMesh.samplingTriangles.size());
+
+                    for (size_t i = chunk * SurfaceSamplingChunkSize; i < chunkEnd; ++i)
+                    {
+                        const auto& triangle = sceneMesh.samplingTriangles[i];
+
+                        const Vec3 vertex = Vec3(triangle.vertex[0], triangle.vertex[1], triangle.vertex[2]);
+                        const Vec3 edge1  = Vec3(triangle.edge1[0], triangle.edge1[1], triangle.edge1[2]);
+                        const Vec3 edge2  = Vec3(triangle.edge2[0], triangle.edge2[1], triangle.edge2[2]);
+
+                        const Vec3 v0 = (worldToArea * Vec4(vertex, 1.f)).getXYZ();
+                        const Vec3 v1 = (worldToArea * Vec4(vertex + edge1, 1.f)).getXYZ();
+                        const Vec3 v2 = (worldToArea * Vec4(vertex + edge2, 1.f)).getXYZ();
+
+                        // Conservative overlap test of triangle bounds with [-1; 1]^3
+                        const Vec3 boundsMin = minPerElem(v0, minPerElem(v1, v2));
+                        const Vec3 boundsMax = maxPerElem(v0, maxPerElem(v1, v2));
+
+                        if ((maxElem(boundsMin) > 1.f) || (minElem(boundsMax) < -1.f))
+                        {
+                            continue;
+                        }
+
+                        triangles.push_back(triangle);
+                        triangleAreas.push_back(sceneMesh.samplingTriangleAreas[i]);
+                    }
+                }
+            }
+        }
+
+        const auto aliasTable = BuildAliasTable(triangleAreas);
+
+        sampling.surfaceArea = 0.f;
+        for (size_t i = 0; i < aliasTable.size(); ++i)
+        {
+            triangles[i].probability = aliasTable[i].probability;
+            triangles[i].alias       = aliasTable[i].alias;
+            sampling.surfaceArea += triangleAreas[i];
+        }
+
+        // Tables are rebuilt in place if they fit the range of the area, otherwise a new range is appended
+        const uint32_t triangleCount = static_cast<uint32_t>(triangles.size());
+
+        if (triangleCount > sampling.triangleCapacity)
+        {
+            m_ownedAreaSurfaceTriangleCount += triangleCount - sampling.triangleCapacity;
+
+            sampling.triangleOffset   = static_cast<uint32_t>(m_areaSurfaceTriangles.size());
+            sampling.triangleCapacity = triangleCount;
+            m_areaSurfaceTriangles.resize(m_areaSurfaceTriangles.size() + triangleCount);
+        }
+
+        sampling.triangleCount = triangleCount;
+
+        if (triangleCount > 0)
+        {
+            std::copy(triangles.begin(), triangles.end(), m_areaSurfaceTriangles.begin() + sampling.triangleOffset);
+            m_dirtyAreaSurfaceTriangleRanges.emplace_back(sampling.triangleOffset, sampling.triangleOffset + triangleCount);
+        }
+
+        record.surfaceTriangleOffset = sampling.triangleOffset;
+        record.surfaceTriangleCount  = triangleCount;
+        record.surfaceArea           = sampling.surfaceArea;
+
+        m_dirtyIvyAreaRecords.push_back(areaIndex);
+    }
+
+    m_dirtySurfaceSamplingAreas.clear();
+
+    // Compact ranges abandoned by grown tables, which moves all tables
+    if (m_areaSurfaceTriangles.size() > 2 * (m_ownedAreaSurfaceTriangleCount + 1))
+    {
+        std::vector<SurfaceSamplingTriangle> triangles = {SurfaceSamplingTriangle{}};
+
+        for (size_t areaIndex = 0; areaIndex < m_ivyAreaRecords.size(); ++areaIndex)
+        {
+            auto& record   = m_ivyAreaRecords[areaIndex];
+            auto& sampling = m_ivyAreaSurfaceSampling[areaIndex];
+
+            const auto first = m_areaSurfaceTriangles.begin() + sampling.triangleOffset;
+
+            sampling.triangleOffset   = (sampling.triangleCount > 0) ? static_cast<uint32_t>(triangles.size()) : 0;
+            sampling.triangleCapacity = sampling.triangleCount;
+            triangles.insert(triangles.end(), first, first + sampling.triangleCount);
+
+            record.surfaceTriangleOffset = sampling.triangleOffset;
+            m_dirtyIvyAreaRecords.push_back(static_cast<uint32_t>(areaIndex));
+        }
+
+        m_areaSurfaceTriangles          = std::move(triangles);
+        m_ownedAreaSurfaceTriangleCount = static_cast<uint32_t>(m_areaSurfaceTriangles.size()) - 1;
+
+        // Everything is uploaded again
+        m_uploadedAreaSurfaceTriangleCount = 0;
+        m_dirtyAreaSurfaceTriangleRanges.clear();
+    }
+
+    const uint32_t triangleCount = static_cast<uint32_t>(m_areaSurfaceTriangles.size());
+
+    if ((triangleCount == m_uploadedAreaSurfaceTriangleCount) && m_dirtyAreaSurfaceTriangleRanges.empty())
+    {
+        return;
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+
+    for (const auto& range : m_dirtyAreaSurfaceTriangleRanges)
+    {
+        if (range.first < m_uploadedAreaSurfaceTriangleCount)
+        {
+            ranges.emplace_back(range.first, std::min(range.second, m_uploadedAreaSurfaceTriangleCount));
+        }
+    }
+    if (triangleCount > m_uploadedAreaSurfaceTriangleCount)
+    {
+        ranges.emplace_back(m_uploadedAreaSurfaceTriangleCount, triangleCount);
+    }
+
+    if (UpdateElementBuffer(pCmdList,
+                            m_pAreaSurfaceTriangleBuffer,
+                            m_areaSurfaceTriangleCapacity,
+                            L"IvySample_AreaSurfaceSamplingTriangles",
+                            m_areaSurfaceTriangles.data(),
+                            sizeof(SurfaceSamplingTriangle),
+                            triangleCount,
+                            std::min(m_uploadedAreaSurfaceTriangleCount, triangleCount),
+                            ranges))
+    {
+        m_pWorkGraphParameterSet->SetBufferSRV(m_pAreaSurfaceTriangleBuffer, AREA_SURFACE_SAMPLING_TRIANGLES);
+    }
+
+    m_uploadedAreaSurfaceTriangleCount = triangleCount;
+    m_dirtyAreaSurfaceTriangleRanges.clear();
+}
+
+void IvyRenderModule::UpdateDistanceField(cauldron::CommandList* pCmdList)
+{
+    const bool useSdfQueries = m_useSdfQueries || !m_rayQueriesSupported;
+
+    if (useSdfQueries != m_usedSdfQueries)
+    {
+        m_usedSdfQueries = useSdfQueries;
+        ++m_hitCacheEpoch;
+    }
+
+    const bool bakeOutdated = (m_distanceFieldGeometryVersion != m_sceneGeometryVersion) || (m_distanceFieldProxyGeometry != m_useProxyGeometry);
+
+    // Start a new bake once the previous one completed, if scene geometry or the proxy setting changed in the meantime
+    if (useSdfQueries && !m_distanceFieldBake.valid() && bakeOutdated)
+    {
+        std::vector<float> triangleVertices;
+
+        for (const auto& sceneMesh : m_sceneMeshes)
+        {
+            for (const auto& instanceTransform : sceneMesh.instanceTransforms)
+            {
+                for (const auto& vertex : sceneMesh.triangleVertices)
+                {
+                    const Vec4 worldVertex = instanceTransform * Vec4(vertex, 1.f);
+
+                    triangleVertices.push_back(worldVertex.getX());
+                    triangleVertices.push_back(worldVertex.getY());
+                    triangleVertices.push_back(worldVertex.getZ());
+                }
+            }
+        }
+
+        const uint32_t threadCount      = std::max(1u, std::thread::hardware_concurrency());
+        const bool     useProxyGeometry = m_useProxyGeometry;
+
+        m_distanceFieldBake = std::async(std::launch::async, [triangleVertices = std::move(triangleVertices), threadCount, useProxyGeometry]() {
+            // Decimation runs in world space, as instance transforms may scale geometry
+            return BakeSparseDistanceField(useProxyGeometry ? DecimateTriangles(triangleVertices, IVY_PROXY_TOLERANCE) : triangleVertices, threadCount);
+        });
+        m_distanceFieldGeometryVersion = m_sceneGeometryVersion;
+        m_distanceFieldProxyGeometry   = m_useProxyGeometry;
+    }
+
+    // A completed bake is only taken once the upload of the previous one completed
+    if (m_pUploadingSdfBrickIndexBuffer == nullptr)
+    {
+        const bool bakeCompleted =
+            m_distanceFieldBake.valid() && (m_distanceFieldBake.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+
+        if (!bakeCompleted && (m_pSdfBrickIndexBuffer != nullptr))
+        {
+            return;
+        }
+
+        m_uploadingDistanceField = bakeCompleted ? m_distanceFieldBake.get() : SparseDistanceField{};
+
+        // Buffers always contain at least one element, as empty buffers cannot be bound
+        if (m_uploadingDistanceField.brickIndices.empty())
+        {
+            m_uploadingDistanceField.brickIndices.push_back(IVY_SDF_EMPTY_BRICK);
+        }
+        if (m_uploadingDistanceField.brickData.empty())
+        {
+            m_uploadingDistanceField.brickData.resize(IVY_SDF_BRICK_WORD_COUNT, 0);
+        }
+
+        const uint32_t brickIndexSize = static_cast<uint32_t>(m_uploadingDistanceField.brickIndices.size() * sizeof(uint32_t));
+        const uint32_t brickSize      = static_cast<uint32_t>(m_uploadingDistanceField.brickData.size() * sizeof(uint32_t));
+
+        BufferDesc brickIndexDesc = BufferDesc::Data(L"IvySample_SdfBrickIndices", brickIndexSize, sizeof(uint32_t), 0, ResourceFlags::None);
+        BufferDesc brickDesc      = BufferDesc::Data(L"IvySample_SdfBricks", brickSize, sizeof(uint32_t), 0, ResourceFlags::None);
+
+        m_pUploadingSdfBrickIndexBuffer = Buffer::CreateBufferResource(&brickIndexDesc, ResourceState::CopyDest);
+        m_pUploadingSdfBrickBuffer      = Buffer::CreateBufferResource(&brickDesc, ResourceState::CopyDest);
+        m_distanceFieldUploadedSize     = 0;
+    }
+
+    const SparseDistanceField& field = m_uploadingDistanceField;
+
+    // Brick indices are uploaded first, followed by the bricks
+    const uint32_t brickIndexSize = static_cast<uint32_t>(field.brickIndices.size() * sizeof(uint32_t));
+    const uint32_t uploadSize     = brickIndexSize + static_cast<uint32_t>(field.brickData.size() * sizeof(uint32_t));
+
+    // The first field has to be bound before the first dispatch, thus it is uploaded at once. It only holds a single empty brick.
+    const uint32_t uploadEnd =
+        (m_pSdfBrickIndexBuffer == nullptr) ? uploadSize : std::min(m_distanceFieldUploadedSize + DistanceFieldUploadSizePerFrame, uploadSize);
+
+    if (m_distanceFieldUploadedSize < brickIndexSize)
+    {
+        const uint32_t end = std::min(uploadEnd, brickIndexSize);
+
+        UploadBufferRegion(pCmdList,
+                           m_pUploadingSdfBrickIndexBuffer->GetResource(),
+                           m_distanceFieldUploadedSize,
+                           reinterpret_cast<const uint8_t*>(field.brickIndices.data()) + m_distanceFieldUploadedSize,
+                           end - m_distanceFieldUploadedSize);
+        m_distanceFieldUploadedSize = end;
+    }
+    if (m_distanceFieldUploadedSize < uploadEnd)
+    {
+        const uint32_t offset = m_distanceFieldUploadedSize - brickIndexSize;
+
+        UploadBufferRegion(pCmdList,
+                           m_pUploadingSdfBrickBuffer->GetResource(),
+                           offset,
+                           reinterpret_cast<const uint8_t*>(field.brickData.data()) + offset,
+                           uploadEnd - m_distanceFieldUploadedSize);
+        m_distanceFieldUploadedSize = uploadEnd;
+    }
+
+    if (m_distanceFieldUploadedSize < uploadSize)
+    {
+        return;
+    }
+
+    // Upload completed, thus the new field is read by growth from now on
+    std::vector<Barrier> barriers;
+    barriers.push_back(Barrier::Transition(m_pUploadingSdfBrickIndexBuffer->GetResource(),
+                                           ResourceState::CopyDest,
+                                           ResourceState::NonPixelShaderResource | ResourceState::PixelShaderResource));
+    barriers.push_back(Barrier::Transition(m_pUploadingSdfBrickBuffer->GetResource(),
+                                           ResourceState::CopyDest,
+                                           ResourceState::NonPixelShaderResource | ResourceState::PixelShaderResource));
+    ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+    // Previous buffers might still be in use by frames in flight
+    if (m_pSdfBrickIndexBuffer)
+    {
+        RetireBuffer(m_pSdfBrickIndexBuffer);
+    }
+    if (m_pSdfBrickBuffer)
+    {
+        RetireBuffer(m_pSdfBrickBuffer);
+    }
+
+    m_pSdfBrickIndexBuffer          = m_pUploadingSdfBrickIndexBuffer;
+    m_pSdfBrickBuffer               = m_pUploadingSdfBrickBuffer;
+    m_pUploadingSdfBrickIndexBuffer = nullptr;
+    m_pUploadingSdfBrickBuffer      = nullptr;
+
+    m_pWorkGraphParameterSet->SetBufferSRV(m_pSdfBrickIndexBuffer, IVY_SDF_BRICK_INDICES);
+    m_pWorkGraphParameterSet->SetBufferSRV(m_pSdfBrickBuffer, IVY_SDF_BRICKS);
+
+    m_sdfBoundsMin = Vec4(field.boundsMin[0], field.boundsMin[1], field.boundsMin[2], 0.f);
+    for (int c = 0; c < 3; ++c)
+    {
+        m_sdfBrickGridSize[c] = field.brickGridSize[c];
+    }
+
+    // Uploaded field is no longer needed on the CPU
+    m_uploadingDistanceField = SparseDistanceField{};
+
+    // Cached hits of the previous field are outdated
+    ++m_hitCacheEpoch;
+}
+
+bool IvyRenderModule::UpdateProgressiveGrowth(cauldron::CommandList* pCmdList)
+{
+    if (!m_useProgressiveGrowth)
+    {
+        m_progressiveGrowthActive = false;
+        return false;
+    }
+
+    // Hash all settings which change the grown ivy. Added & edited records request a restart themselves, see MarkIvyBranchEdited.
+    uint64_t hash = 14695981039346656037ull;
+
+    const bool settings[] = {m_usePoissonAreaSampling, m_useAdaptiveProbing, m_useHitCache, m_useSdfQueries};
+    hash                  = HashBytes(hash, settings, sizeof(settings));
+    hash                  = HashBytes(hash, &m_sceneGeometryVersion, sizeof(m_sceneGeometryVersion));
+
+    const bool restart = m_restartProgressiveGrowth || !m_progressiveGrowthActive || (hash != m_progressiveGrowthHash);
+
+    m_restartProgressiveGrowth = false;
+    m_progressiveGrowthActive  = true;
+    m_progressiveGrowthHash    = hash;
+
+    // Frontier is appended to in this frame & dispatched in the next frame
+    struct FrontierHeader
+    {
+        D3D12_NODE_GPU_INPUT nodeInput;
+        uint32_t             appendCounter;
+    };
+    static_assert(offsetof(FrontierHeader, nodeInput.NumRecords) == IVY_FRONTIER_RECORD_COUNT * sizeof(uint32_t), "Frontier layout mismatch");
+    static_assert(offsetof(FrontierHeader, appendCounter) == IVY_FRONTIER_APPEND_COUNTER * sizeof(uint32_t), "Frontier layout mismatch");
+
+    const Buffer* pWriteFrontier = m_pFrontierBuffers[1 - m_frontierReadIndex];
+
+    FrontierHeader header                  = {};
+    header.nodeInput.EntrypointIndex       = m_WorkGraphEntryPoints.IvyBranch;
+    header.nodeInput.NumRecords            = 0;
+    header.nodeInput.Records.StartAddress  = pWriteFrontier->GetAddressInfo().GetImpl()->GPUBufferView + IVY_FRONTIER_RECORDS * sizeof(uint32_t);
+    header.nodeInput.Records.StrideInBytes = IVY_FRONTIER_RECORD_SIZE * sizeof(uint32_t);
+    header.appendCounter                   = 0;
+
+    UploadBufferRegion(pCmdList, pWriteFrontier->GetResource(), 0, &header, sizeof(header));
+
+    return restart;
+}
+
+void IvyRenderModule::UpdateTemporalRegeneration()
+{
+    const uint32_t rootCount = static_cast<uint32_t>(m_ivyBranchRecords.size() + m_ivyAreaRecords.size());
+
+    // Continue after the window of the previous frame. Windows end at the last root, such that every root is regenerated once per rotation.
+    m_regenerationStart += m_regenerationCount;
+    if (m_regenerationStart >= rootCount)
+    {
+        m_regenerationStart = 0;
+    }
+
+    // Progressive growth supersedes temporal regeneration, as both keep growth of previous frames in the growth cache
+    if (!m_useTemporalRegeneration || m_useProgressiveGrowth)
+    {
+        m_regenerationCount = 0;
+        return;
+    }
+
+    if (m_adaptRegenerationToBudget)
+    {
+        // Back off quickly when over budget & grow slowly when below, such that the frame time settles just below the budget
+        if (m_frameTimeMs > m_regenerationFrameBudgetMs)
+        {
+            m_regenerationRootsPerFrame = std::max(1, static_cast<int>(m_regenerationRootsPerFrame * RegenerationBackoffFactor));
+        }
+        else if (m_frameTimeMs < m_regenerationFrameBudgetMs * RegenerationGrowthThreshold)
+        {
+            m_regenerationRootsPerFrame = std::min(m_regenerationRootsPerFrame + std::max(1, m_regenerationRootsPerFrame / 16), RegenerationMaxRootsPerFrame);
+        }
+    }
+
+    m_regenerationCount = std::min(static_cast<uint32_t>(std::max(m_regenerationRootsPerFrame, 1)), rootCount - m_regenerationStart);
+}
+
+void IvyRenderModule::UpdateStatistics(cauldron::CommandList* pCmdList)
+{
+    if (m_pStatisticsReadback->Read(m_FrameIndex, m_statistics.data(), &m_statisticsFrameIndex) && m_logStatistics)
+    {
+        if (!m_statisticsLog.is_open())
+        {
+            m_statisticsLog.open(StatisticsLogFileName, std::ios::out | std::ios::trunc);
+            m_statisticsLog << "frame,forwardRays,downwardRays,randomRays,areaRays,areaSeeds,clampedAreaSamples,stems,leaves,planarIterations,hitCacheLookups,hitCacheHits,"
+                               "culledStems,culledLeaves,leafCards,cardLeaves,culledMeshlets";
+            for (uint32_t depth = 0; depth < IVY_STATISTIC_DEPTH_HISTOGRAM_SIZE; ++depth)
+            {
+                m_statisticsLog << ",depth" << depth;
+            }
+            m_statisticsLog << "\n";
+        }
+
+        m_statisticsLog << m_statisticsFrameIndex;
+        for (uint32_t counter = 0; counter <= IVY_STATISTIC_CULLED_MESHLETS; ++counter)
+        {
+            m_statisticsLog << "," << m_statistics[counter];
+        }
+        for (uint32_t depth = 0; depth < IVY_STATISTIC_DEPTH_HISTOGRAM_SIZE; ++depth)
+        {
+            m_statisticsLog << "," << m_statistics[IVY_STATISTIC_DEPTH_HISTOGRAM + depth];
+        }
+        m_statisticsLog << "\n";
+    }
+
+    if (!m_logStatistics && m_statisticsLog.is_open())
+    {
+        m_statisticsLog.close();
+    }
+
+    m_pRootStatisticsReadback->Read(m_FrameIndex, m_rootStatistics.data());
+
+    std::vector<Barrier> barriers;
+    barriers.push_back(Barrier::Transition(m_pStatisticsBuffer->GetResource(), ResourceState::CopyDest, ResourceState::CopySource));
+    barriers.push_back(Barrier::Transition(m_pRootStatisticsBuffer->GetResource(), ResourceState::CopyDest, ResourceState::CopySource));
+    ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+    // Skips this frame if all readback buffers are still in flight
+    m_pStatisticsReadback->Copy(pCmdList, m_pStatisticsBuffer->GetResource(), 0, m_FrameIndex);
+    m_pRootStatisticsReadback->Copy(pCmdList, m_pRootStatisticsBuffer->GetResource(), 0, m_FrameIndex);
+
+    for (auto& barrier : barriers)
+    {
+        std::swap(barrier.SourceState, barrier.DestState);
+    }
+    ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+    // Reset counters for next frame. Only counters of existing roots can be non-zero.
+    const std::array<uint32_t, IVY_STATISTIC_COUNT> zeroStatistics = {};
+    UploadBufferRegion(pCmdList, m_pStatisticsBuffer->GetResource(), 0, zeroStatistics.data(), sizeof(zeroStatistics));
+
+    const size_t rootCount = m_ivyBranchRecords.size() + m_ivyAreaRecords.size();
+    ClearBufferRegion(pCmdList, m_pRootStatisticsBuffer->GetResource(), static_cast<uint32_t>(rootCount * IVY_ROOT_STATISTIC_COUNT * sizeof(uint32_t)));
+}
+
+void IvyRenderModule::UpdateLineageTrace(cauldron::CommandList* pCmdList, bool traceRecorded)
+{
+    if (traceRecorded)
+    {
+        if (m_pLineageTraceReadback == nullptr)
+        {
+            m_pLineageTraceReadback = new ReadbackRing(m_pLineageTraceBuffer->GetDesc().Size, RetiredResourceFrameLatency);
+        }
+
+        std::vector<Barrier> barriers = {Barrier::Transition(m_pLineageTraceBuffer->GetResource(), ResourceState::CopyDest, ResourceState::CopySource)};
+        ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+        // Only one trace is in flight at a time, thus a readback buffer is always available
+        m_pLineageTraceReadback->Copy(pCmdList, m_pLineageTraceBuffer->GetResource(), 0, m_FrameIndex);
+
+        std::swap(barriers[0].SourceState, barriers[0].DestState);
+        ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+        m_lineageTraceRequested = false;
+        m_lineageTracePending   = true;
+
+        return;
+    }
+
+    if (!m_lineageTracePending)
+    {
+        return;
+    }
+
+    std::vector<uint32_t> traceData(m_pLineageTraceReadback->GetSize() / sizeof(uint32_t));
+
+    if (!m_pLineageTraceReadback->Read(m_FrameIndex, traceData.data()))
+    {
+        return;
+    }
+
+    m_lineageTracePending = false;
+
+    // First header element counts all appended entries
+    const uint32_t appendedEntryCount = traceData[0];
+    const uint32_t entryCount         = std::min(appendedEntryCount, static_cast<uint32_t>(IVY_LINEAGE_TRACE_CAPACITY));
+
+    LineageTrace trace;
+    trace.entries.resize(entryCount);
+    trace.droppedEntryCount = appendedEntryCount - entryCount;
+    memcpy(trace.entries.data(), traceData.data() + IVY_LINEAGE_TRACE_HEADER_SIZE, entryCount * sizeof(IvyLineageTraceEntry));
+
+    if (!WriteLineageTrace(LineageTraceFileName, trace))
+    {
+        CauldronWarning(L"Failed to write lineage trace.");
+    }
+
+    m_lineageTraceStatistics    = ReplayLineageTrace(trace);
+    m_hasLineageTraceStatistics = true;
+}
+
+void IvyRenderModule::UpdateOutputDigests(cauldron::CommandList* pCmdList)
+{
+    const size_t rootCount = m_ivyBranchRecords.size() + m_ivyAreaRecords.size();
+
+    if (m_pOutputDigestReadback->Read(m_FrameIndex, m_outputDigests.data(), &m_outputDigestFrameIndex))
+    {
+        const std::vector<uint64_t> rootDigests(m_outputDigests.begin(), m_outputDigests.begin() + rootCount);
+
+        if (m_saveGoldenOutputDigests)
+        {
+            if (WriteOutputDigests(GoldenOutputDigestFileName, rootDigests))
+            {
+                m_goldenOutputDigests    = rootDigests;
+                m_hasGoldenOutputDigests = true;
+            }
+            else
+            {
+                CauldronWarning(L"Failed to write golden output digests.");
+            }
+
+            m_saveGoldenOutputDigests = false;
+        }
+
+        if (m_hasGoldenOutputDigests)
+        {
+            const bool matchedGolden = m_outputDigestMismatches.empty();
+
+            m_outputDigestMismatches = CompareOutputDigests(rootDigests, m_goldenOutputDigests);
+
+            // Only warn once per regression
+            if (matchedGolden && !m_outputDigestMismatches.empty())
+            {
+                CauldronWarning(L"Ivy output digests of %zu roots differ from golden digests.", m_outputDigestMismatches.size());
+            }
+        }
+
+        m_hasOutputDigests = true;
+    }
+
+    std::vector<Barrier> barriers = {Barrier::Transition(m_pOutputDigestBuffer->GetResource(), ResourceState::CopyDest, ResourceState::CopySource)};
+    ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
 
-    // Release state object properties
-    stateObjectProperties->Release();
-    workGraphProperties->Release();
+    // Skips this frame if all readback buffers are still in flight
+    m_pOutputDigestReadback->Copy(pCmdList, m_pOutputDigestBuffer->GetResource(), 0, m_FrameIndex);
 
-    // Release ID3D12Device9 (only releases additional reference created by QueryInterface)
-    d3dDevice->Release();
+    std::swap(barriers[0].SourceState, barriers[0].DestState);
+    ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+    // Reset digests for next frame. Only digests of existing roots can be non-zero.
+    ClearBufferRegion(pCmdList, m_pOutputDigestBuffer->GetResource(), static_cast<uint32_t>(rootCount * sizeof(uint64_t)));
+}
+
+void IvyRenderModule::UpdateGrowthOverflow(cauldron::CommandList* pCmdList)
+{
+    if (m_pFrontierCounterReadback == nullptr)
+    {
+        m_pFrontierCounterReadback    = new ReadbackRing(sizeof(uint32_t), RetiredResourceFrameLatency);
+        m_pGrowthCacheCounterReadback = new ReadbackRing(2 * sizeof(uint32_t), RetiredResourceFrameLatency);
+    }
+
+    // Append counters keep incrementing once the capacity is reached, thus they count all requested records & entries
+    uint32_t frontierAppendCount = 0;
+    if (m_pFrontierCounterReadback->Read(m_FrameIndex, &frontierAppendCount))
+    {
+        const uint32_t droppedCount = frontierAppendCount - std::min(frontierAppendCount, static_cast<uint32_t>(IVY_FRONTIER_CAPACITY));
+
+        // Only warn once per overflow
+        if ((m_droppedFrontierRecordCount == 0) && (droppedCount > 0))
+        {
+            CauldronWarning(L"Progressive growth dropped %u branch records beyond the frontier capacity of %u.", droppedCount, IVY_FRONTIER_CAPACITY);
+        }
+
+        m_droppedFrontierRecordCount = droppedCount;
+    }
+
+    std::array<uint32_t, 2> growthCacheCounts = {};
+    if (m_pGrowthCacheCounterReadback->Read(m_FrameIndex, growthCacheCounts.data()))
+    {
+        const uint32_t stemCount        = growthCacheCounts[IVY_GROWTH_CACHE_STEM_COUNT];
+        const uint32_t leafCount        = growthCacheCounts[IVY_GROWTH_CACHE_LEAF_COUNT];
+        const uint32_t droppedStemCount = stemCount - std::min(stemCount, static_cast<uint32_t>(IVY_GROWTH_CACHE_STEM_CAPACITY));
+        const uint32_t droppedLeafCount = leafCount - std::min(leafCount, static_cast<uint32_t>(IVY_GROWTH_CACHE_LEAF_CAPACITY));
+
+        if ((m_droppedCachedStemCount + m_droppedCachedLeafCount == 0) && (droppedStemCount + droppedLeafCount > 0))
+        {
+            CauldronWarning(L"Growth cache dropped %u stems & %u leaves beyond its capacity.", droppedStemCount, droppedLeafCount);
+        }
+
+        m_droppedCachedStemCount = droppedStemCount;
+        m_droppedCachedLeafCount = droppedLeafCount;
+    }
+
+    // Frontier is only appended to by progressive growth
+    const Buffer* pWriteFrontier    = m_useProgressiveGrowth ? m_pFrontierBuffers[1 - m_frontierReadIndex] : nullptr;
+    const Buffer* pWriteGrowthCache = m_pGrowthCacheBuffers[1 - m_growthCacheReadIndex];
+
+    std::vector<Barrier> barriers = {Barrier::Transition(pWriteGrowthCache->GetResource(), ResourceState::CopyDest, ResourceState::CopySource)};
+    if (pWriteFrontier)
+    {
+        barriers.push_back(Barrier::Transition(pWriteFrontier->GetResource(), ResourceState::CopyDest, ResourceState::CopySource));
+    }
+    ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+    // Skips this frame if all readback buffers are still in flight
+    m_pGrowthCacheCounterReadback->Copy(pCmdList, pWriteGrowthCache->GetResource(), 0, m_FrameIndex);
+    if (pWriteFrontier)
+    {
+        m_pFrontierCounterReadback->Copy(pCmdList, pWriteFrontier->GetResource(), IVY_FRONTIER_APPEND_COUNTER * sizeof(uint32_t), m_FrameIndex);
+    }
+    else
+    {
+        m_droppedFrontierRecordCount = 0;
+    }
+
+    for (auto& barrier : barriers)
+    {
+        std::swap(barrier.SourceState, barrier.DestState);
+    }
+    ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+}
+
+void IvyRenderModule::UpdateHitCacheInspection(cauldron::CommandList* pCmdList)
+{
+    if (m_hitCacheInspectionRequested && !m_hitCacheInspectionPending)
+    {
+        if (m_pHitCacheReadback == nullptr)
+        {
+            m_pHitCacheReadback = new ReadbackRing(m_pHitCacheBuffer->GetDesc().Size, RetiredResourceFrameLatency);
+        }
+
+        std::vector<Barrier> barriers = {Barrier::Transition(m_pHitCacheBuffer->GetResource(), ResourceState::CopyDest, ResourceState::CopySource)};
+        ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+        // Only one inspection is in flight at a time, thus a readback buffer is always available
+        m_pHitCacheReadback->Copy(pCmdList, m_pHitCacheBuffer->GetResource(), 0, m_FrameIndex);
+
+        std::swap(barriers[0].SourceState, barriers[0].DestState);
+        ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+        m_hitCacheInspectionRequested = false;
+        m_hitCacheInspectionPending   = true;
+
+        return;
+    }
+
+    if (!m_hitCacheInspectionPending)
+    {
+        return;
+    }
+
+    std::vector<IvyHitCacheEntry> entries(IVY_HIT_CACHE_CAPACITY);
+
+    if (!m_pHitCacheReadback->Read(m_FrameIndex, entries.data()))
+    {
+        return;
+    }
+
+    m_hitCacheInspectionPending = false;
+
+    HitCache hitCache;
+    hitCache.Load(entries.data(), entries.size());
+
+    m_hitCacheOccupancy    = hitCache.GetOccupancy();
+    m_hasHitCacheOccupancy = true;
+}
+
+void IvyRenderModule::UpdateShadowViews(WorkGraphCBData& workGraphData)
+{
+    const uint32_t previousDroppedViewCount = m_droppedShadowViewCount;
+
+    m_shadowViews.clear();
+    m_droppedShadowViewCount = 0;
+
+    ShadowMapResourcePool* pShadowMapResourcePool = GetFramework()->GetShadowMapResourcePool();
+
+    if (m_useIvyShadows && (pShadowMapResourcePool != nullptr) && (pShadowMapResourcePool->GetRenderTargetCount() > 0))
+    {
+        // Each shadow map of a light, e.g. each cascade of a directional light, is a region of a shadow map atlas
+        for (auto* pComponent : LightComponentMgr::Get()->GetComponentList())
+        {
+            const LightComponent* pLightComponent = static_cast<const LightComponent*>(pComponent);
+
+            for (int shadowMap = 0; shadowMap < pLightComponent->GetShadowMapCount(); ++shadowMap)
+            {
+                const int shadowMapIndex = pLightComponent->GetShadowMapIndex(shadowMap);
+                if (shadowMapIndex < 0)
+                {
+                    continue;
+                }
+                if (m_shadowViews.size() == IVY_MAX_VIEWS)
+                {
+                    ++m_droppedShadowViewCount;
+                    continue;
+                }
+
+                const Rect rect = pLightComponent->GetShadowMapRect(shadowMap);
+
+                ShadowView view;
+                view.renderTargetIndex = static_cast<int>(pShadowMapResourcePool->GetRenderTargetIndex(shadowMapIndex));
+                view.viewport          = {static_cast<float>(rect.Left),
+                                          static_cast<float>(rect.Top),
+                                          static_cast<float>(rect.Right - rect.Left),
+                                          static_cast<float>(rect.Bottom - rect.Top),
+                                          0.f,
+                                          1.f};
+                view.scissorRect       = {static_cast<LONG>(rect.Left), static_cast<LONG>(rect.Top), static_cast<LONG>(rect.Right), static_cast<LONG>(rect.Bottom)};
+
+                workGraphData.IvyViewProjections[m_shadowViews.size()] = pLightComponent->GetShadowViewProjection(shadowMap);
+                m_shadowViews.push_back(view);
+            }
+        }
+    }
+
+    // Only warn once per overflow
+    if ((previousDroppedViewCount == 0) && (m_droppedShadowViewCount > 0))
+    {
+        CauldronWarning(L"%u shadow maps beyond the %u supported views don't receive ivy shadows.", m_droppedShadowViewCount, IVY_MAX_VIEWS);
+    }
+
+    workGraphData.IvyViewCount = static_cast<uint32_t>(m_shadowViews.size());
+}
+
+void IvyRenderModule::ExecuteShadowPass(cauldron::CommandList* pCmdList, const WorkGraphCBData& workGraphData)
+{
+    ShadowMapResourcePool* pShadowMapResourcePool = GetFramework()->GetShadowMapResourcePool();
+
+    if (m_shadowViews.empty())
+    {
+        return;
+    }
+
+    GPUScopedProfileCapture shadowMarker(pCmdList, L"Ivy Shadows");
+
+    // Wind animation, mesh bounds, views & the growth cache index are shared with the GBuffer pass
+    BufferAddressInfo workGraphDataInfo = GetDynamicBufferPool()->AllocConstantBuffer(sizeof(WorkGraphCBData), &workGraphData);
+    m_pShadowParameterSet->UpdateRootConstantBuffer(&workGraphDataInfo, 0);
+
+    IvyShadowCBData shadowData = {};
+
+    // Shadow maps were already rendered by RasterShadowRenderModule & are in readable state
+    std::vector<Barrier> barriers;
+    for (uint32_t renderTargetIndex = 0; renderTargetIndex < pShadowMapResourcePool->GetRenderTargetCount(); ++renderTargetIndex)
+    {
+        barriers.push_back(Barrier::Transition(pShadowMapResourcePool->GetRenderTarget(renderTargetIndex)->GetResource(),
+                                               ResourceState::NonPixelShaderResource | ResourceState::PixelShaderResource,
+                                               ResourceState::DepthWrite));
+    }
+
+    ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+    ID3D12GraphicsCommandList10* commandList;
+    CauldronThrowOnFail(pCmdList->GetImpl()->DX12CmdList()->QueryInterface(IID_PPV_ARGS(&commandList)));
+
+    // The cache draw entry node has no input record
+    D3D12_DISPATCH_GRAPH_DESC dispatchDesc        = {};
+    dispatchDesc.Mode                             = D3D12_DISPATCH_MODE_NODE_CPU_INPUT;
+    dispatchDesc.NodeCPUInput.EntrypointIndex     = m_ShadowEntryPoint;
+    dispatchDesc.NodeCPUInput.NumRecords          = 1;
+    dispatchDesc.NodeCPUInput.pRecords            = nullptr;
+    dispatchDesc.NodeCPUInput.RecordStrideInBytes = 0;
+
+    // Viewport v is the region of view v in its render target, thus all render targets share the viewports of all views
+    std::vector<D3D12_VIEWPORT> viewports;
+    std::vector<D3D12_RECT>     scissorRects;
+    for (const ShadowView& view : m_shadowViews)
+    {
+        viewports.push_back(view.viewport);
+        scissorRects.push_back(view.scissorRect);
+    }
+
+    for (uint32_t renderTargetIndex = 0; renderTargetIndex < pShadowMapResourcePool->GetRenderTargetCount(); ++renderTargetIndex)
+    {
+        shadowData.ShadowViewMask = 0;
+        for (uint32_t view = 0; view < m_shadowViews.size(); ++view)
+        {
+            if (m_shadowViews[view].renderTargetIndex == static_cast<int>(renderTargetIndex))
+            {
+                shadowData.ShadowViewMask |= 1u << view;
+            }
+        }
+
+        if (shadowData.ShadowViewMask == 0)
+        {
+            continue;
+        }
+
+        BufferAddressInfo shadowDataInfo = GetDynamicBufferPool()->AllocConstantBuffer(sizeof(IvyShadowCBData), &shadowData);
+        m_pShadowParameterSet->UpdateRootConstantBuffer(&shadowDataInfo, 1);
+        m_pShadowParameterSet->Bind(pCmdList, nullptr);
+
+        BeginRaster(pCmdList, 0, nullptr, pShadowMapResourcePool->GetRasterView(renderTargetIndex), nullptr);
+        commandList->RSSetViewports(static_cast<UINT>(viewports.size()), viewports.data());
+        commandList->RSSetScissorRects(static_cast<UINT>(scissorRects.size()), scissorRects.data());
+
+        commandList->SetProgram(&m_ShadowProgramDesc);
+        commandList->DispatchGraph(&dispatchDesc);
+
+        // Clear backing memory initialization flag, as the graph has run at least once now
+        m_ShadowProgramDesc.WorkGraph.Flags &= ~D3D12_SET_WORK_GRAPH_FLAG_INITIALIZE;
+
+        EndRaster(pCmdList, nullptr);
+    }
+
+    commandList->Release();
+
+    for (auto& barrier : barriers)
+    {
+        std::swap(barrier.DestState, barrier.SourceState);
+    }
+
+    ResourceBarrier(pCmdList, static_cast<uint32_t>(barriers.size()), barriers.data());
+}
+
+void IvyRenderModule::UpdateHiZ(cauldron::CommandList* pCmdList, uint32_t width, uint32_t height)
+{
+    GPUScopedProfileCapture hizMarker(pCmdList, L"Ivy HiZ");
+
+    Barrier barrier = Barrier::Transition(
+        m_pHiZTexture->GetResource(), ResourceState::NonPixelShaderResource | ResourceState::PixelShaderResource, ResourceState::UnorderedAccess);
+    ResourceBarrier(pCmdList, 1, &barrier);
+
+    ID3D12GraphicsCommandList* commandList = pCmdList->GetImpl()->DX12CmdList();
+
+    HiZCBData hizData     = {};
+    hizData.SourceSize[0] = width;
+    hizData.SourceSize[1] = height;
+    hizData.InvertedDepth = GetConfig()->InvertedDepth ? 1 : 0;
+
+    // Each mip is downsampled from the previous one, mip 0 from GBufferDepth
+    const uint32_t mipCount = std::min(HiZPyramid::GetMipCount(width, height), m_pHiZTexture->GetDesc().MipLevels);
+    for (uint32_t mip = 0; mip < mipCount; ++mip)
+    {
+        hizData.DestinationMip = mip;
+        HiZPyramid::GetMipSize(width, height, mip, hizData.DestinationSize[0], hizData.DestinationSize[1]);
+
+        BufferAddressInfo hizDataInfo = GetDynamicBufferPool()->AllocConstantBuffer(sizeof(HiZCBData), &hizData);
+        m_pHiZParameterSet->UpdateRootConstantBuffer(&hizDataInfo, 0);
+        m_pHiZParameterSet->Bind(pCmdList, nullptr);
+
+        commandList->SetPipelineState(m_pHiZPipelineState);
+        commandList->Dispatch((hizData.DestinationSize[0] + HiZThreadGroupSize - 1) / HiZThreadGroupSize,
+                              (hizData.DestinationSize[1] + HiZThreadGroupSize - 1) / HiZThreadGroupSize,
+                              1);
+
+        // Next mip reads this one
+        Barrier mipBarrier = Barrier::UAV(m_pHiZTexture->GetResource());
+        ResourceBarrier(pCmdList, 1, &mipBarrier);
+
+        hizData.SourceSize[0] = hizData.DestinationSize[0];
+        hizData.SourceSize[1] = hizData.DestinationSize[1];
+    }
+
+    std::swap(barrier.DestState, barrier.SourceState);
+    ResourceBarrier(pCmdList, 1, &barrier);
+}
+
+void IvyRenderModule::UpdateRootStatisticsCapacity()
+{
+    if (m_rootStatisticsCapacity == m_WorkGraphInputRecordCapacity)
+    {
+        return;
+    }
+
+    // Previous buffer might still be in use by frames in flight
+    if (m_pRootStatisticsBuffer)
+    {
+        RetireBuffer(m_pRootStatisticsBuffer);
+    }
+
+    // Every entry record can be a root
+    m_rootStatisticsCapacity = m_WorkGraphInputRecordCapacity;
+    m_rootStatistics.assign(m_rootStatisticsCapacity * IVY_ROOT_STATISTIC_COUNT, 0);
+
+    const uint32_t bufferSize = static_cast<uint32_t>(m_rootStatistics.size() * sizeof(uint32_t));
+
+    BufferDesc bufferDesc = BufferDesc::Data(L"IvySample_RootStatisticsBuffer", bufferSize, sizeof(uint32_t), 0, ResourceFlags::AllowUnorderedAccess);
+
+    m_pRootStatisticsBuffer = Buffer::CreateBufferResource(&bufferDesc, ResourceState::CopyDest);
+    m_pRootStatisticsBuffer->CopyData(m_rootStatistics.data(), bufferSize);
+
+    if (m_pRootStatisticsReadback)
+    {
+        m_pRootStatisticsReadback->Resize(bufferSize, m_FrameIndex);
+    }
+    else
+    {
+        m_pRootStatisticsReadback = new ReadbackRing(bufferSize, RetiredResourceFrameLatency);
+    }
+
+    m_pWorkGraphParameterSet->SetBufferUAV(m_pRootStatisticsBuffer, IVY_ROOT_STATISTICS);
+
+    // Output digests
+    if (m_pOutputDigestBuffer)
+    {
+        RetireBuffer(m_pOutputDigestBuffer);
+    }
+
+    m_outputDigests.assign(m_rootStatisticsCapacity, 0);
+    m_hasOutputDigests = false;
+
+    const uint32_t digestBufferSize = static_cast<uint32_t>(m_outputDigests.size() * sizeof(uint64_t));
+
+    BufferDesc digestBufferDesc =
+        BufferDesc::Data(L"IvySample_OutputDigestBuffer", digestBufferSize, sizeof(uint64_t), 0, ResourceFlags::AllowUnorderedAccess);
+
+    m_pOutputDigestBuffer = Buffer::CreateBufferResource(&digestBufferDesc, ResourceState::CopyDest);
+    m_pOutputDigestBuffer->CopyData(m_outputDigests.data(), digestBufferSize);
+
+    if (m_pOutputDigestReadback)
+    {
+        m_pOutputDigestReadback->Resize(digestBufferSize, m_FrameIndex);
+    }
+    else
+    {
+        m_pOutputDigestReadback = new ReadbackRing(digestBufferSize, RetiredResourceFrameLatency);
+    }
+
+    m_pWorkGraphParameterSet->SetBufferUAV(m_pOutputDigestBuffer, IVY_OUTPUT_DIGESTS);
+
+    // Zero buffer covering the larger of both
+    if (m_pZeroBuffer)
+    {
+        RetireBuffer(m_pZeroBuffer);
+    }
+
+    const std::vector<uint8_t> zeros(std::max(bufferSize, digestBufferSize), 0);
+
+    BufferDesc zeroBufferDesc = BufferDesc::Data(L"IvySample_ZeroBuffer", static_cast<uint32_t>(zeros.size()), sizeof(uint32_t), 0, ResourceFlags::None);
+
+    m_pZeroBuffer = Buffer::CreateBufferResource(&zeroBufferDesc, ResourceState::CopyDest);
+    m_pZeroBuffer->CopyData(zeros.data(), zeros.size());
+}
+
+void IvyRenderModule::ClearBufferRegion(CommandList* pCmdList, const GPUResource* pDestination, uint32_t size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+
+    Barrier barrier = Barrier::Transition(m_pZeroBuffer->GetResource(), ResourceState::CopyDest, ResourceState::CopySource);
+    ResourceBarrier(pCmdList, 1, &barrier);
+
+    pCmdList->GetImpl()->DX12CmdList()->CopyBufferRegion(
+        pDestination->GetImpl()->DX12Resource(), 0, m_pZeroBuffer->GetResource()->GetImpl()->DX12Resource(), 0, size);
+
+    std::swap(barrier.DestState, barrier.SourceState);
+    ResourceBarrier(pCmdList, 1, &barrier);
+}
+
+bool IvyRenderModule::UpdateElementBuffer(CommandList*                                      pCmdList,
+                                          Buffer*&                                          pBuffer,
+                                          uint32_t&                                         capacity,
+                                          const wchar_t*                                    name,
+                                          const void*                                       pElements,
+                                          uint32_t                                          elementSize,
+                                          uint32_t                                          elementCount,
+                                          uint32_t                                          copyCount,
+                                          const std::vector<std::pair<uint32_t, uint32_t>>& ranges)
+{
+    const bool grow = elementCount > capacity;
+
+    if (!grow && ranges.empty())
+    {
+        return false;
+    }
+
+    if (grow)
+    {
+        Buffer* pPreviousBuffer = pBuffer;
+
+        capacity = std::max(elementCount, capacity * 2);
+
+        BufferDesc bufferDesc = BufferDesc::Data(name, capacity * elementSize, elementSize, 0, ResourceFlags::None);
+        pBuffer               = Buffer::CreateBufferResource(&bufferDesc, ResourceState::CopyDest);
+
+        if (pPreviousBuffer)
+        {
+            if (copyCount > 0)
+            {
+                Barrier barrier = Barrier::Transition(
+                    pPreviousBuffer->GetResource(), ResourceState::NonPixelShaderResource | ResourceState::PixelShaderResource, ResourceState::CopySource);
+                ResourceBarrier(pCmdList, 1, &barrier);
+
+                pCmdList->GetImpl()->DX12CmdList()->CopyBufferRegion(pBuffer->GetResource()->GetImpl()->DX12Resource(),
+                                                                     0,
+                                                                     pPreviousBuffer->GetResource()->GetImpl()->DX12Resource(),
+                                                                     0,
+                                                                     copyCount * elementSize);
+            }
+
+            // Previous buffer might still be in use by frames in flight
+            RetireBuffer(pPreviousBuffer);
+        }
+    }
+    else
+    {
+        // Frames in flight are done reading the elements in place once the copies execute, as they run on the same queue
+        Barrier barrier =
+            Barrier::Transition(pBuffer->GetResource(), ResourceState::NonPixelShaderResource | ResourceState::PixelShaderResource, ResourceState::CopyDest);
+        ResourceBarrier(pCmdList, 1, &barrier);
+    }
+
+    for (const auto& range : ranges)
+    {
+        UploadBufferRegion(pCmdList,
+                           pBuffer->GetResource(),
+                           range.first * elementSize,
+                           static_cast<const uint8_t*>(pElements) + range.first * elementSize,
+                           (range.second - range.first) * elementSize);
+    }
+
+    Barrier barrier =
+        Barrier::Transition(pBuffer->GetResource(), ResourceState::CopyDest, ResourceState::NonPixelShaderResource | ResourceState::PixelShaderResource);
+    ResourceBarrier(pCmdList, 1, &barrier);
+
+    return grow;
+}
+
+bool IvyRenderModule::FindRootRecord(uint32_t rootIndex, int& branchIndex, int& areaIndex) const
+{
+    const auto FindRecord = [rootIndex](const auto& records) {
+        const auto it =
+            std::lower_bound(records.begin(), records.end(), rootIndex, [](const auto& record, uint32_t index) { return record.rootIndex < index; });
+        return ((it != records.end()) && (it->rootIndex == rootIndex)) ? static_cast<int>(it - records.begin()) : -1;
+    };
+
+    branchIndex = FindRecord(m_ivyBranchRecords);
+    areaIndex   = (branchIndex < 0) ? FindRecord(m_ivyAreaRecords) : -1;
+
+    return (branchIndex >= 0) || (areaIndex >= 0);
+}
+
+void IvyRenderModule::RetireBuffer(cauldron::Buffer* pBuffer)
+{
+    m_RetiredBuffers.emplace_back(m_FrameIndex, pBuffer);
+}
+
+void IvyRenderModule::ReleaseRetiredBuffers()
+{
+    auto it = m_RetiredBuffers.begin();
+    while (it != m_RetiredBuffers.end())
+    {
+        if (m_FrameIndex >= it->first + RetiredResourceFrameLatency)
+        {
+            delete it->second;
+            it = m_RetiredBuffers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
 }
 
 void IvyRenderModule::RenderUserInterface()
@@ -519,15 +3064,18 @@ void IvyRenderModule::RenderUserInterface()
 
         if (i == m_selectedIvyBranch)
         {
-            ImGuizmo::Manipulate(reinterpret_cast<const float*>(&currentCamera->GetView()),
-                                 reinterpret_cast<const float*>(&currentCamera->GetProjection()),
-                                 ImGuizmo::OPERATION::TRANSLATE | ImGuizmo::ROTATE_X | ImGuizmo::ROTATE_Y | ImGuizmo::ROTATE_Z,
-                                 ImGuizmo::WORLD,
-                                 reinterpret_cast<float*>(&ivyData.transform),
-                                 nullptr,
-                                 nullptr,
-                                 nullptr,
-                                 nullptr);
+            if (ImGuizmo::Manipulate(reinterpret_cast<const float*>(&currentCamera->GetView()),
+                                     reinterpret_cast<const float*>(&currentCamera->GetProjection()),
+                                     ImGuizmo::OPERATION::TRANSLATE | ImGuizmo::ROTATE_X | ImGuizmo::ROTATE_Y | ImGuizmo::ROTATE_Z,
+                                     ImGuizmo::WORLD,
+                                     reinterpret_cast<float*>(&ivyData.transform),
+                                     nullptr,
+                                     nullptr,
+                                     nullptr,
+                                     nullptr))
+            {
+                MarkIvyBranchEdited(i);
+            }
         }
         else
         {
@@ -553,15 +3101,18 @@ void IvyRenderModule::RenderUserInterface()
 
         if (i == m_selectedIvyArea)
         {
-            ImGuizmo::Manipulate(reinterpret_cast<const float*>(&currentCamera->GetView()),
-                                 reinterpret_cast<const float*>(&currentCamera->GetProjection()),
-                                 ImGuizmo::OPERATION::TRANSLATE | ImGuizmo::ROTATE_X | ImGuizmo::ROTATE_Y | ImGuizmo::ROTATE_Z,
-                                 ImGuizmo::WORLD,
-                                 reinterpret_cast<float*>(&ivyData.transform),
-                                 nullptr,
-                                 nullptr,
-                                 bounds,
-                                 nullptr);
+            if (ImGuizmo::Manipulate(reinterpret_cast<const float*>(&currentCamera->GetView()),
+                                     reinterpret_cast<const float*>(&currentCamera->GetProjection()),
+                                     ImGuizmo::OPERATION::TRANSLATE | ImGuizmo::ROTATE_X | ImGuizmo::ROTATE_Y | ImGuizmo::ROTATE_Z,
+                                     ImGuizmo::WORLD,
+                                     reinterpret_cast<float*>(&ivyData.transform),
+                                     nullptr,
+                                     nullptr,
+                                     bounds,
+                                     nullptr))
+            {
+                MarkIvyAreaEdited(i);
+            }
         }
         else
         {
@@ -577,11 +3128,317 @@ void IvyRenderModule::RenderUserInterface()
             }
         }
     }
+
+    if (m_useStatistics)
+    {
+        RenderStatisticsWindow();
+    }
+
+    if (m_hasLineageTraceStatistics)
+    {
+        RenderLineageTraceWindow();
+    }
+
+    if (m_useOutputDigests)
+    {
+        RenderOutputDigestWindow();
+    }
+}
+
+void IvyRenderModule::RenderStatisticsWindow()
+{
+    ImGui::Begin("Ivy Statistics");
+
+    ImGui::Text("Frame:                %llu", static_cast<unsigned long long>(m_statisticsFrameIndex));
+    ImGui::Text("Forward rays:         %u", m_statistics[IVY_STATISTIC_FORWARD_RAYS]);
+    ImGui::Text("Downward rays:        %u", m_statistics[IVY_STATISTIC_DOWNWARD_RAYS]);
+    ImGui::Text("Random rays:          %u", m_statistics[IVY_STATISTIC_RANDOM_RAYS]);
+    ImGui::Text("Area rays:            %u", m_statistics[IVY_STATISTIC_AREA_RAYS]);
+    ImGui::Text("Area seeds:           %u", m_statistics[IVY_STATISTIC_AREA_SEEDS]);
+    ImGui::Text("Clamped area samples: %u", m_statistics[IVY_STATISTIC_CLAMPED_AREA_SAMPLES]);
+    ImGui::Text("Stems:                %u", m_statistics[IVY_STATISTIC_STEMS]);
+    ImGui::Text("Leaves:               %u", m_statistics[IVY_STATISTIC_LEAVES]);
+    ImGui::Text("Planar iterations:    %u", m_statistics[IVY_STATISTIC_PLANAR_ITERATIONS]);
+
+    // Ray counters above include rays answered by the hit cache
+    const uint32_t hitCacheLookups = m_statistics[IVY_STATISTIC_HIT_CACHE_LOOKUPS];
+    const uint32_t hitCacheHits    = m_statistics[IVY_STATISTIC_HIT_CACHE_HITS];
+    const float    hitCacheRate    = (hitCacheLookups > 0) ? 100.f * hitCacheHits / hitCacheLookups : 0.f;
+
+    ImGui::Text("Hit cache hits:       %u / %u (%.1f%%)", hitCacheHits, hitCacheLookups, hitCacheRate);
+
+    // Stems & leaves rejected by occlusion culling before reaching the mesh nodes
+    ImGui::Text("Culled stems:         %u", m_statistics[IVY_STATISTIC_CULLED_STEMS]);
+    ImGui::Text("Culled leaves:        %u", m_statistics[IVY_STATISTIC_CULLED_LEAVES]);
+    ImGui::Text("Leaf cards:           %u (%u leaves)", m_statistics[IVY_STATISTIC_LEAF_CARDS], m_statistics[IVY_STATISTIC_CARD_LEAVES]);
+    ImGui::Text("Culled meshlets:      %u", m_statistics[IVY_STATISTIC_CULLED_MESHLETS]);
+
+    // Growth beyond the fixed capacities is dropped, see UpdateGrowthOverflow
+    ImGui::Text("Dropped frontier:     %u records", m_droppedFrontierRecordCount);
+    ImGui::Text("Dropped cache:        %u stems, %u leaves", m_droppedCachedStemCount, m_droppedCachedLeafCount);
+    ImGui::Text("Dropped shadow views: %u", m_droppedShadowViewCount);
+
+    if (m_hasHitCacheOccupancy)
+    {
+        ImGui::Text("Hit cache entries:    %u hits, %u misses, %u empty, %u torn",
+                    m_hitCacheOccupancy.hitEntryCount,
+                    m_hitCacheOccupancy.missEntryCount,
+                    m_hitCacheOccupancy.emptyEntryCount,
+                    m_hitCacheOccupancy.tornEntryCount);
+    }
+
+    // Number of IvyBranch records per recursion depth
+    std::array<float, IVY_STATISTIC_DEPTH_HISTOGRAM_SIZE> depthHistogram;
+    for (uint32_t depth = 0; depth < IVY_STATISTIC_DEPTH_HISTOGRAM_SIZE; ++depth)
+    {
+        depthHistogram[depth] = static_cast<float>(m_statistics[IVY_STATISTIC_DEPTH_HISTOGRAM + depth]);
+    }
+
+    ImGui::PlotHistogram("Recursion depth", depthHistogram.data(), static_cast<int>(depthHistogram.size()), 0, nullptr, 0.f, FLT_MAX, ImVec2(0, 80));
+
+    // Most expensive roots by number of traced rays
+    const uint32_t rootCount = std::min(m_rootCount, m_rootStatisticsCapacity);
+
+    const auto GetRootStatistic = [&](uint32_t rootIndex, uint32_t counter) { return m_rootStatistics[rootIndex * IVY_ROOT_STATISTIC_COUNT + counter]; };
+
+    std::vector<uint32_t> roots(rootCount);
+    for (uint32_t i = 0; i < rootCount; ++i)
+    {
+        roots[i] = i;
+    }
+
+    const uint32_t topRootCount = std::min(rootCount, StatisticsTopRootCount);
+    std::partial_sort(roots.begin(), roots.begin() + topRootCount, roots.end(), [&](uint32_t a, uint32_t b) {
+        return GetRootStatistic(a, IVY_ROOT_STATISTIC_RAYS) > GetRootStatistic(b, IVY_ROOT_STATISTIC_RAYS);
+    });
+
+    ImGui::Separator();
+    ImGui::Text("Most expensive roots");
+
+    if (ImGui::BeginTable("IvyRootStatistics", 5))
+    {
+        ImGui::TableSetupColumn("Root");
+        ImGui::TableSetupColumn("Rays");
+        ImGui::TableSetupColumn("Stems");
+        ImGui::TableSetupColumn("Leaves");
+        ImGui::TableSetupColumn("Max. Depth");
+        ImGui::TableHeadersRow();
+
+        for (uint32_t i = 0; i < topRootCount; ++i)
+        {
+            const uint32_t rootIndex   = roots[i];
+            int            branchIndex = -1;
+            int            areaIndex   = -1;
+            FindRootRecord(rootIndex, branchIndex, areaIndex);
+
+            const std::string name = (branchIndex >= 0) ? "IvyBranch[" + std::to_string(branchIndex) + "]" : "IvyArea[" + std::to_string(areaIndex) + "]";
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+
+            // Select root on click
+            if (ImGui::Selectable(name.c_str(), false, ImGuiSelectableFlags_SpanAllColumns))
+            {
+                m_selectedIvyBranch = branchIndex;
+                m_selectedIvyArea   = areaIndex;
+                m_updateIvyUI       = true;
+            }
+
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", GetRootStatistic(rootIndex, IVY_ROOT_STATISTIC_RAYS));
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", GetRootStatistic(rootIndex, IVY_ROOT_STATISTIC_STEMS));
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", GetRootStatistic(rootIndex, IVY_ROOT_STATISTIC_LEAVES));
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", GetRootStatistic(rootIndex, IVY_ROOT_STATISTIC_MAX_DEPTH));
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+void IvyRenderModule::RenderLineageTraceWindow()
+{
+    const auto& statistics = m_lineageTraceStatistics;
+
+    ImGui::Begin("Ivy Lineage Trace", &m_hasLineageTraceStatistics);
+
+    ImGui::Text("Trace file:        %s", LineageTraceFileName);
+    ImGui::Text("Invocations:       %u", statistics.invocationCount);
+    ImGui::Text("Root invocations:  %u", statistics.rootInvocationCount);
+    ImGui::Text("Orphans:           %u", statistics.orphanInvocationCount);
+    ImGui::Text("Leaf invocations:  %u", statistics.leafInvocationCount);
+    ImGui::Text("Forks:             %u", statistics.forkCount);
+    ImGui::Text("Max. depth:        %u", statistics.maxDepth);
+    ImGui::Text("Branching factor:  %.3f", statistics.branchingFactor);
+
+    ImGui::Separator();
+    ImGui::Text("Forward hits:      %u", statistics.iterationOutcomes[IVY_LINEAGE_OUTCOME_FORWARD_HIT]);
+    ImGui::Text("Downward hits:     %u", statistics.iterationOutcomes[IVY_LINEAGE_OUTCOME_DOWNWARD_HIT]);
+    ImGui::Text("Random hits:       %u", statistics.iterationOutcomes[IVY_LINEAGE_OUTCOME_RANDOM_HIT]);
+    ImGui::Text("Free falls:        %u", statistics.iterationOutcomes[IVY_LINEAGE_OUTCOME_FREE_FALL]);
+    ImGui::Text("Wasted iterations: %u", statistics.wastedIterationCount);
+
+    std::array<float, IVY_LINEAGE_DEPTH_MASK + 1> invocationsPerDepth;
+    for (uint32_t depth = 0; depth < invocationsPerDepth.size(); ++depth)
+    {
+        invocationsPerDepth[depth] = static_cast<float>(statistics.invocationsPerDepth[depth]);
+    }
+
+    ImGui::PlotHistogram(
+        "Invocations per depth", invocationsPerDepth.data(), static_cast<int>(invocationsPerDepth.size()), 0, nullptr, 0.f, FLT_MAX, ImVec2(0, 80));
+
+    ImGui::End();
+}
+
+void IvyRenderModule::RenderOutputDigestWindow()
+{
+    ImGui::Begin("Ivy Output Digests");
+
+    if (!m_hasOutputDigests)
+    {
+        ImGui::Text("Waiting for readback...");
+        ImGui::End();
+        return;
+    }
+
+    const size_t rootCount = std::min(static_cast<size_t>(m_rootCount), m_outputDigests.size());
+
+    const std::vector<uint64_t> rootDigests(m_outputDigests.begin(), m_outputDigests.begin() + rootCount);
+
+    ImGui::Text("Frame:        %llu", static_cast<unsigned long long>(m_outputDigestFrameIndex));
+    ImGui::Text("Frame digest: %016llx", static_cast<unsigned long long>(CombineOutputDigests(rootDigests)));
+    ImGui::Text("Golden file:  %s", GoldenOutputDigestFileName);
+
+    if (!m_hasGoldenOutputDigests)
+    {
+        ImGui::Text("No golden digests loaded");
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("Golden:       %016llx", static_cast<unsigned long long>(CombineOutputDigests(m_goldenOutputDigests)));
+
+    if (m_outputDigestMismatches.empty())
+    {
+        ImGui::TextColored(ImVec4(0.f, 1.f, 0.f, 1.f), "All %zu roots match", rootCount);
+        ImGui::End();
+        return;
+    }
+
+    ImGui::TextColored(ImVec4(1.f, 0.f, 0.f, 1.f), "%zu roots differ", m_outputDigestMismatches.size());
+
+    ImGui::Separator();
+
+    const size_t listCount = std::min(m_outputDigestMismatches.size(), static_cast<size_t>(OutputDigestMismatchListCount));
+
+    for (size_t i = 0; i < listCount; ++i)
+    {
+        const uint32_t rootIndex   = m_outputDigestMismatches[i];
+        int            branchIndex = -1;
+        int            areaIndex   = -1;
+        const bool     exists      = FindRootRecord(rootIndex, branchIndex, areaIndex);
+
+        // Roots which only exist in the golden digests can't be selected
+        const std::string name = (branchIndex >= 0) ? "IvyBranch[" + std::to_string(branchIndex) + "]"
+                                 : (areaIndex >= 0) ? "IvyArea[" + std::to_string(areaIndex) + "]"
+                                                    : "Root[" + std::to_string(rootIndex) + "]";
+
+        // Select root on click
+        if (ImGui::Selectable(name.c_str(), false) && exists)
+        {
+            m_selectedIvyBranch = branchIndex;
+            m_selectedIvyArea   = areaIndex;
+            m_updateIvyUI       = true;
+        }
+    }
+
+    ImGui::End();
+}
+
+void IvyRenderModule::AddIvyBranch()
+{
+    IvyBranchRecord record = {Mat4::translation(Vec3(0, 0.1f, 0))};
+
+    if (!m_ivyBranchRecords.empty())
+    {
+        const int sourceIndex = (m_selectedIvyBranch >= 0) ? m_selectedIvyBranch : static_cast<int>(m_ivyBranchRecords.size()) - 1;
+
+        record = m_ivyBranchRecords[sourceIndex];
+        // move new root to the side of the source root
+        record.transform = record.transform * Mat4::translation(Vec3(0, 0, 0.5f));
+        record.seed += 1;
+    }
+
+    record.rootIndex = m_rootCount++;
+
+    m_ivyBranchRecords.push_back(record);
+    m_dirtyIvyBranchRecords.push_back(static_cast<uint32_t>(m_ivyBranchRecords.size()) - 1);
+    m_restartProgressiveGrowth = true;
+
+    // select new ivy branch
+    m_selectedIvyBranch = static_cast<int>(m_ivyBranchRecords.size()) - 1;
+    m_selectedIvyArea   = -1;
+}
+
+void IvyRenderModule::AddIvyArea()
+{
+    IvyAreaRecord record = {Mat4::translation(Vec3(0, 17, 7)), 0, 0.14f};
+
+    if (!m_ivyAreaRecords.empty())
+    {
+        const int sourceIndex = (m_selectedIvyArea >= 0) ? m_selectedIvyArea : static_cast<int>(m_ivyAreaRecords.size()) - 1;
+
+        record = m_ivyAreaRecords[sourceIndex];
+        // move new area next to the source area. Area transform is scaled to [-1; 1]
+        record.transform = record.transform * Mat4::translation(Vec3(2.f, 0, 0));
+        record.seed += 1;
+    }
+
+    record.rootIndex = m_rootCount++;
+
+    m_ivyAreaRecords.push_back(record);
+
+    // New area only takes the settings of the last area, its table is built into a range of its own
+    IvyAreaSurfaceSampling sampling = {};
+    if (!m_ivyAreaSurfaceSampling.empty())
+    {
+        sampling.enabled    = m_ivyAreaSurfaceSampling.back().enabled;
+        sampling.meshOption = m_ivyAreaSurfaceSampling.back().meshOption;
+    }
+    m_ivyAreaSurfaceSampling.push_back(sampling);
+    m_dirtySurfaceSamplingAreas.push_back(static_cast<uint32_t>(m_ivyAreaRecords.size()) - 1);
+    m_dirtyIvyAreaRecords.push_back(static_cast<uint32_t>(m_ivyAreaRecords.size()) - 1);
+    m_restartProgressiveGrowth = true;
+
+    // select new ivy area
+    m_selectedIvyArea   = static_cast<int>(m_ivyAreaRecords.size()) - 1;
+    m_selectedIvyBranch = -1;
+}
+
+void IvyRenderModule::MarkIvyBranchEdited(int branchIndex)
+{
+    m_dirtyIvyBranchRecords.push_back(static_cast<uint32_t>(branchIndex));
+    m_restartProgressiveGrowth = true;
+}
+
+void IvyRenderModule::MarkIvyAreaEdited(int areaIndex)
+{
+    m_dirtyIvyAreaRecords.push_back(static_cast<uint32_t>(areaIndex));
+    m_dirtySurfaceSamplingAreas.push_back(static_cast<uint32_t>(areaIndex));
+    m_restartProgressiveGrowth = true;
 }
 
 void IvyRenderModule::OnNewContentLoaded(ContentBlock* pContentBlock)
 {
-    std::lock_guard<std::mutex> pipelineLock(m_CriticalSection);
+    // Tables are built & uploaded while Execute keeps rendering with the previously published set
+    std::lock_guard<std::mutex> contentLoadLock(m_ContentLoadCriticalSection);
+
+    std::vector<std::pair<const Mesh*, Mat4>> sceneMeshInstances;
+
     // Material
 
     const size_t materialIdOffset = m_RTInfoTables.m_cpuMaterialBuffer.size();
@@ -645,6 +3502,9 @@ void IvyRenderModule::OnNewContentLoaded(ContentBlock* pContentBlock)
             {
                 const Mesh* pMesh = reinterpret_cast<MeshComponent*>(pComponent)->GetData().pMesh;
 
+                // Every instance of a mesh can be sampled by ivy areas
+                sceneMeshInstances.emplace_back(pMesh, pComponent->GetOwner()->GetTransform());
+
                 if (meshIdxToMesh.find(pMesh->GetMeshIndex()) != meshIdxToMesh.end())
                 {
                     continue;
@@ -658,24 +3518,20 @@ void IvyRenderModule::OnNewContentLoaded(ContentBlock* pContentBlock)
                 const size_t numSurfaces       = pMesh->GetNumSurfaces();
                 size_t       numOpaqueSurfaces = 0;
 
-                struct MeshData
-                {
-                    BLAS*                 m_pBlas;
-                    uint32_t              m_Index;
-                    std::wstring          m_Name;
-                    std::vector<Surface*> m_Surfaces;
-                };
-
-                const MeshData* pMeshData = reinterpret_cast<const MeshData*>(pMesh);
+                const std::wstring& meshName = GetMeshName(pMesh);
 
-                if (pMeshData->m_Name == L"..\\media\\Ivy\\Stem")
+                if (meshName == L"..\\media\\Ivy\\Stem")
                 {
-                    m_ivyStemSurfaceIndex = static_cast<int>(m_RTInfoTables.m_cpuSurfaceBuffer.size());
+                    m_RTInfoTables.m_ivyStem.surfaceIndex  = static_cast<int>(m_RTInfoTables.m_cpuSurfaceBuffer.size());
+                    m_RTInfoTables.m_ivyStem.boundsCenter  = pMesh->GetSurface(0)->Center();
+                    m_RTInfoTables.m_ivyStem.boundsExtents = pMesh->GetSurface(0)->Radius();
                 }
 
-                if (pMeshData->m_Name == L"..\\media\\Ivy\\Leaf")
+                if (meshName == L"..\\media\\Ivy\\Leaf")
                 {
-                    m_ivyLeafSurfaceIndex = static_cast<int>(m_RTInfoTables.m_cpuSurfaceBuffer.size());
+                    m_RTInfoTables.m_ivyLeaf.surfaceIndex  = static_cast<int>(m_RTInfoTables.m_cpuSurfaceBuffer.size());
+                    m_RTInfoTables.m_ivyLeaf.boundsCenter  = pMesh->GetSurface(0)->Center();
+                    m_RTInfoTables.m_ivyLeaf.boundsExtents = pMesh->GetSurface(0)->Radius();
                 }
 
                 for (uint32_t i = 0; i < numSurfaces; ++i)
@@ -684,6 +3540,7 @@ void IvyRenderModule::OnNewContentLoaded(ContentBlock* pContentBlock)
                     const Material* pMaterial = pSurface->GetMaterial();
 
                     m_RTInfoTables.m_cpuSurfaceIDsBuffer.push_back(static_cast<uint32_t>(m_RTInfoTables.m_cpuSurfaceBuffer.size()));
+                    m_RTInfoTables.m_surfaceMeshes.emplace_back(pMesh->GetMeshIndex(), i);
 
                     Surface_Info surface_info{};
                     memset(&surface_info, -1, sizeof(surface_info));
@@ -789,80 +3646,386 @@ void IvyRenderModule::OnNewContentLoaded(ContentBlock* pContentBlock)
         }
     }
 
-    if (m_RTInfoTables.m_cpuSurfaceBuffer.size() > 0)
+    PublishRTInfoTables(std::move(sceneMeshInstances));
+}
+
+void IvyRenderModule::OnContentUnloaded(ContentBlock* pContentBlock)
+{
+    std::lock_guard<std::mutex> contentLoadLock(m_ContentLoadCriticalSection);
+
+    for (auto materialInfo : m_RTInfoTables.m_cpuMaterialBuffer)
+    {
+        if (materialInfo.albedo_tex_id > 0)
+            RemoveTexture(materialInfo.albedo_tex_id);
+        if (materialInfo.arm_tex_id > 0)
+            RemoveTexture(materialInfo.arm_tex_id);
+        if (materialInfo.emission_tex_id > 0)
+            RemoveTexture(materialInfo.emission_tex_id);
+        if (materialInfo.normal_tex_id > 0)
+            RemoveTexture(materialInfo.normal_tex_id);
+    }
+
+    // Released slots keep their previous descriptor until a later load reuses them;
+    // no material references them anymore, so the stale binding is never sampled
+    PublishRTInfoTables({});
+}
+
+IvyRenderModule::RTInfoTableSet::~RTInfoTableSet()
+{
+    // Only sets which were never bound still hold retired buffers
+    for (auto* pBuffer : retiredBuffers)
+    {
+        delete pBuffer;
+    }
+}
+
+void IvyRenderModule::RTInfoTableSet::CarryOver(RTInfoTableSet& olderSet)
+{
+    sceneMeshInstances.insert(sceneMeshInstances.begin(), olderSet.sceneMeshInstances.begin(), olderSet.sceneMeshInstances.end());
+    retiredBuffers.insert(retiredBuffers.end(), olderSet.retiredBuffers.begin(), olderSet.retiredBuffers.end());
+
+    olderSet.sceneMeshInstances.clear();
+    olderSet.retiredBuffers.clear();
+}
+
+void IvyRenderModule::UploadRTInfoTable(
+    RTInfoTableBuffer& table, const wchar_t* name, const void* pData, size_t sizeInBytes, uint32_t stride, std::vector<Buffer*>& retiredBuffers)
+{
+    const uint8_t* pBytes       = static_cast<const uint8_t*>(pData);
+    const size_t   uploadedSize = table.uploadedData.size();
+
+    // Loads mostly append, thus usually only the new elements are uploaded
+    const auto changedRanges = GetChangedRanges(pBytes, sizeInBytes, table.uploadedData, stride);
+
+    if (changedRanges.empty())
+    {
+        return;
+    }
+
+    // Uploaded elements might be read by frames in flight, thus changing them requires a new buffer
+    const bool changesUploadedData = changedRanges.front().first < uploadedSize;
+
+    if ((sizeInBytes > table.capacityInBytes) || changesUploadedData)
+    {
+        Buffer* pPreviousBuffer = table.pBuffer;
+
+        if (sizeInBytes > table.capacityInBytes)
+        {
+            table.capacityInBytes = std::max(sizeInBytes, table.capacityInBytes * 2);
+        }
+
+        // Copy queues promote buffers from common state, which decay back to common state once the copies completed
+        BufferDesc bufferDesc = BufferDesc::Data(name, uint32_t(table.capacityInBytes), stride, 0, ResourceFlags::None);
+        table.pBuffer         = Buffer::CreateBufferResource(&bufferDesc, ResourceState::CommonResource);
+
+        if (pPreviousBuffer)
+        {
+            // Unchanged elements in between the changed ranges are copied from the previous buffer
+            ID3D12Resource* pDestination   = table.pBuffer->GetResource()->GetImpl()->DX12Resource();
+            ID3D12Resource* pSource        = pPreviousBuffer->GetResource()->GetImpl()->DX12Resource();
+            size_t          unchangedBegin = 0;
+
+            for (const auto& range : changedRanges)
+            {
+                const size_t unchangedEnd = std::min(range.first, uploadedSize);
+
+                if (unchangedEnd > unchangedBegin)
+                {
+                    m_pRTInfoUploadRing->Copy(pDestination, unchangedBegin, pSource, unchangedBegin, unchangedEnd - unchangedBegin);
+                }
+
+                unchangedBegin = range.second;
+            }
+
+            const size_t unchangedEnd = std::min(uploadedSize, sizeInBytes);
+
+            if (unchangedEnd > unchangedBegin)
+            {
+                m_pRTInfoUploadRing->Copy(pDestination, unchangedBegin, pSource, unchangedBegin, unchangedEnd - unchangedBegin);
+            }
+
+            retiredBuffers.push_back(pPreviousBuffer);
+        }
+    }
+
+    ID3D12Resource* pDestination = table.pBuffer->GetResource()->GetImpl()->DX12Resource();
+
+    for (const auto& range : changedRanges)
+    {
+        m_pRTInfoUploadRing->Upload(pDestination, range.first, pBytes + range.first, range.second - range.first);
+    }
+
+    table.uploadedData.assign(pBytes, pBytes + sizeInBytes);
+}
+
+void IvyRenderModule::PublishRTInfoTables(std::vector<std::pair<const Mesh*, Mat4>>&& sceneMeshInstances)
+{
+    RTInfoTableSet* pTables     = new RTInfoTableSet();
+    pTables->tables             = m_RTInfoTables;
+    pTables->sceneMeshInstances = std::move(sceneMeshInstances);
+
+    const RTInfoTables& tables = pTables->tables;
+
+    if (tables.m_cpuSurfaceBuffer.size() > 0)
+    {
+        // Upload changes on the copy queue
+        UploadRTInfoTable(m_materialTableBuffer,
+                          L"HSR_MaterialBuffer",
+                          tables.m_cpuMaterialBuffer.data(),
+                          tables.m_cpuMaterialBuffer.size() * sizeof(Material_Info),
+                          sizeof(Material_Info),
+                          pTables->retiredBuffers);
+        UploadRTInfoTable(m_instanceTableBuffer,
+                          L"HSR_InstanceBuffer",
+                          tables.m_cpuInstanceBuffer.data(),
+                          tables.m_cpuInstanceBuffer.size() * sizeof(Instance_Info),
+                          sizeof(Instance_Info),
+                          pTables->retiredBuffers);
+        UploadRTInfoTable(m_surfaceIDsTableBuffer,
+                          L"HSR_SurfaceIDBuffer",
+                          tables.m_cpuSurfaceIDsBuffer.data(),
+                          tables.m_cpuSurfaceIDsBuffer.size() * sizeof(uint32_t),
+                          sizeof(uint32_t),
+                          pTables->retiredBuffers);
+        UploadRTInfoTable(m_surfaceTableBuffer,
+                          L"HSR_SurfaceBuffer",
+                          tables.m_cpuSurfaceBuffer.data(),
+                          tables.m_cpuSurfaceBuffer.size() * sizeof(Surface_Info),
+                          sizeof(Surface_Info),
+                          pTables->retiredBuffers);
+
+        pTables->pMaterialBuffer   = m_materialTableBuffer.pBuffer;
+        pTables->pInstanceBuffer   = m_instanceTableBuffer.pBuffer;
+        pTables->pSurfaceIDsBuffer = m_surfaceIDsTableBuffer.pBuffer;
+        pTables->pSurfaceBuffer    = m_surfaceTableBuffer.pBuffer;
+    }
+
+    pTables->uploadFenceValue = m_pRTInfoUploadRing->Submit();
+
+    // A set Execute didn't take yet is replaced
+    RTInfoTableSet* pSkippedTables = m_pPendingRTInfoTables.exchange(nullptr, std::memory_order_acquire);
+
+    if (pSkippedTables)
+    {
+        pTables->CarryOver(*pSkippedTables);
+        delete pSkippedTables;
+    }
+
+    m_pPendingRTInfoTables.store(pTables, std::memory_order_release);
+}
+
+void IvyRenderModule::UpdateRTInfoTables(cauldron::CommandList* pCmdList)
+{
+    RTInfoTableSet* pPublishedTables = m_pPendingRTInfoTables.exchange(nullptr, std::memory_order_acquire);
+
+    if (pPublishedTables)
+    {
+        // Uploads complete in order, thus a set whose upload is still running is superseded by the newer one
+        if (m_pUploadingRTInfoTables)
+        {
+            pPublishedTables->CarryOver(*m_pUploadingRTInfoTables);
+            delete m_pUploadingRTInfoTables;
+        }
+
+        m_pUploadingRTInfoTables = pPublishedTables;
+    }
+
+    if ((m_pUploadingRTInfoTables == nullptr) || !m_pRTInfoUploadRing->IsComplete(m_pUploadingRTInfoTables->uploadFenceValue))
+    {
+        return;
+    }
+
+    RTInfoTableSet* pTables  = m_pUploadingRTInfoTables;
+    m_pUploadingRTInfoTables = nullptr;
+
+    const RTInfoTables& tables = pTables->tables;
+
+    // Cached rays don't know about the new geometry
+    ++m_hitCacheEpoch;
+
+    for (const auto& instance : pTables->sceneMeshInstances)
+    {
+        AddSceneMeshInstance(instance.first, instance.second);
+    }
+
+    // Meshlets & the leaf card mask are baked again once an ivy mesh was (re)loaded
+    if (tables.m_ivyStem.surfaceIndex != m_ivyStemSurfaceIndex)
+    {
+        m_meshletsBaked = false;
+    }
+    if (tables.m_ivyLeaf.surfaceIndex != m_ivyLeafSurfaceIndex)
+    {
+        m_leafCardMaskBaked = false;
+        m_meshletsBaked     = false;
+    }
+
+    m_ivyStemSurfaceIndex  = tables.m_ivyStem.surfaceIndex;
+    m_ivyStemBoundsCenter  = tables.m_ivyStem.boundsCenter;
+    m_ivyStemBoundsExtents = tables.m_ivyStem.boundsExtents;
+    m_ivyLeafSurfaceIndex  = tables.m_ivyLeaf.surfaceIndex;
+    m_ivyLeafBoundsCenter  = tables.m_ivyLeaf.boundsCenter;
+    m_ivyLeafBoundsExtents = tables.m_ivyLeaf.boundsExtents;
+
+    if (pTables->pSurfaceBuffer)
     {
-        // Upload
-        BufferDesc bufferMaterial = BufferDesc::Data(
-            L"HSR_MaterialBuffer", uint32_t(m_RTInfoTables.m_cpuMaterialBuffer.size() * sizeof(Material_Info)), sizeof(Material_Info), 0, ResourceFlags::None);
-        m_RTInfoTables.m_pMaterialBuffer = GetDynamicResourcePool()->CreateBuffer(&bufferMaterial, ResourceState::CopyDest);
-        const_cast<Buffer*>(m_RTInfoTables.m_pMaterialBuffer)
-            ->CopyData(m_RTInfoTables.m_cpuMaterialBuffer.data(), m_RTInfoTables.m_cpuMaterialBuffer.size() * sizeof(Material_Info));
+        m_pWorkGraphParameterSet->SetBufferSRV(pTables->pMaterialBuffer, RAYTRACING_INFO_BEGIN_SLOT);
+        m_pWorkGraphParameterSet->SetBufferSRV(pTables->pInstanceBuffer, RAYTRACING_INFO_BEGIN_SLOT + 1);
+        m_pWorkGraphParameterSet->SetBufferSRV(pTables->pSurfaceIDsBuffer, RAYTRACING_INFO_BEGIN_SLOT + 2);
+        m_pWorkGraphParameterSet->SetBufferSRV(pTables->pSurfaceBuffer, RAYTRACING_INFO_BEGIN_SLOT + 3);
+
+        // Face normals are allocated when a scene mesh is registered, thus offsets are resolved after registering the new instances.
+        // Ivy meshes have no scene mesh & thus no face normals.
+        std::vector<uint32_t> faceNormalOffsets;
+        faceNormalOffsets.reserve(tables.m_surfaceMeshes.size());
+
+        for (const auto& surfaceMesh : tables.m_surfaceMeshes)
+        {
+            const auto sceneMesh = m_sceneMeshIndices.find(surfaceMesh.first);
+            faceNormalOffsets.push_back((sceneMesh != m_sceneMeshIndices.end()) ? m_sceneMeshes[sceneMesh->second].surfaceFaceNormalOffsets[surfaceMesh.second]
+                                                                                : IVY_FACE_NORMAL_NONE);
+        }
+
+        // Loads mostly append surfaces, thus usually only the offsets of the new surfaces are uploaded
+        const uint32_t offsetCount   = static_cast<uint32_t>(faceNormalOffsets.size());
+        const uint32_t uploadedCount = static_cast<uint32_t>(m_faceNormalOffsets.size());
 
-        BufferDesc bufferInstance = BufferDesc::Data(
-            L"HSR_InstanceBuffer", uint32_t(m_RTInfoTables.m_cpuInstanceBuffer.size() * sizeof(Instance_Info)), sizeof(Instance_Info), 0, ResourceFlags::None);
-        m_RTInfoTables.m_pInstanceBuffer = GetDynamicResourcePool()->CreateBuffer(&bufferInstance, ResourceState::CopyDest);
-        const_cast<Buffer*>(m_RTInfoTables.m_pInstanceBuffer)
-            ->CopyData(m_RTInfoTables.m_cpuInstanceBuffer.data(), m_RTInfoTables.m_cpuInstanceBuffer.size() * sizeof(Instance_Info));
+        std::vector<std::pair<uint32_t, uint32_t>> ranges;
+        for (uint32_t i = 0; i < offsetCount; ++i)
+        {
+            if ((i < uploadedCount) && (faceNormalOffsets[i] == m_faceNormalOffsets[i]))
+            {
+                continue;
+            }
 
-        BufferDesc bufferSurfaceID = BufferDesc::Data(
-            L"HSR_SurfaceIDBuffer", uint32_t(m_RTInfoTables.m_cpuSurfaceIDsBuffer.size() * sizeof(uint32_t)), sizeof(uint32_t), 0, ResourceFlags::None);
-        m_RTInfoTables.m_pSurfaceIDsBuffer = GetDynamicResourcePool()->CreateBuffer(&bufferSurfaceID, ResourceState::CopyDest);
-        const_cast<Buffer*>(m_RTInfoTables.m_pSurfaceIDsBuffer)
-            ->CopyData(m_RTInfoTables.m_cpuSurfaceIDsBuffer.data(), m_RTInfoTables.m_cpuSurfaceIDsBuffer.size() * sizeof(uint32_t));
+            if (!ranges.empty() && (ranges.back().second == i))
+            {
+                ranges.back().second = i + 1;
+            }
+            else
+            {
+                ranges.emplace_back(i, i + 1);
+            }
+        }
 
-        BufferDesc bufferSurface = BufferDesc::Data(
-            L"HSR_SurfaceBuffer", uint32_t(m_RTInfoTables.m_cpuSurfaceBuffer.size() * sizeof(Surface_Info)), sizeof(Surface_Info), 0, ResourceFlags::None);
-        m_RTInfoTables.m_pSurfaceBuffer = GetDynamicResourcePool()->CreateBuffer(&bufferSurface, ResourceState::CopyDest);
-        const_cast<Buffer*>(m_RTInfoTables.m_pSurfaceBuffer)
-            ->CopyData(m_RTInfoTables.m_cpuSurfaceBuffer.data(), m_RTInfoTables.m_cpuSurfaceBuffer.size() * sizeof(Surface_Info));
+        if (UpdateElementBuffer(pCmdList,
+                                m_pFaceNormalOffsetBuffer,
+                                m_faceNormalOffsetCapacity,
+                                L"IvySample_FaceNormalOffsetBuffer",
+                                faceNormalOffsets.data(),
+                                sizeof(uint32_t),
+                                offsetCount,
+                                std::min(uploadedCount, offsetCount),
+                                ranges))
+        {
+            m_pWorkGraphParameterSet->SetBufferSRV(m_pFaceNormalOffsetBuffer, IVY_FACE_NORMAL_OFFSETS);
+        }
 
-        m_pWorkGraphParameterSet->SetBufferSRV(m_RTInfoTables.m_pMaterialBuffer, RAYTRACING_INFO_BEGIN_SLOT);
-        m_pWorkGraphParameterSet->SetBufferSRV(m_RTInfoTables.m_pInstanceBuffer, RAYTRACING_INFO_BEGIN_SLOT + 1);
-        m_pWorkGraphParameterSet->SetBufferSRV(m_RTInfoTables.m_pSurfaceIDsBuffer, RAYTRACING_INFO_BEGIN_SLOT + 2);
-        m_pWorkGraphParameterSet->SetBufferSRV(m_RTInfoTables.m_pSurfaceBuffer, RAYTRACING_INFO_BEGIN_SLOT + 3);
+        m_faceNormalOffsets = std::move(faceNormalOffsets);
     }
 
     {
         // Update the parameter set with loaded texture entries
-        CauldronAssert(ASSERT_CRITICAL, m_RTInfoTables.m_Textures.size() <= MAX_TEXTURES_COUNT, L"Too many textures.");
-        for (uint32_t i = 0; i < m_RTInfoTables.m_Textures.size(); ++i)
+        CauldronAssert(ASSERT_CRITICAL, tables.m_Textures.size() <= MAX_TEXTURES_COUNT, L"Too many textures.");
+        for (uint32_t i = 0; i < tables.m_Textures.size(); ++i)
         {
-            m_pWorkGraphParameterSet->SetTextureSRV(m_RTInfoTables.m_Textures[i].pTexture, ViewDimension::Texture2D, i + TEXTURE_BEGIN_SLOT);
+            // Released entries have no texture to bind
+            if (tables.m_Textures[i].pTexture == nullptr)
+                continue;
+
+            m_pWorkGraphParameterSet->SetTextureSRV(tables.m_Textures[i].pTexture, ViewDimension::Texture2D, i + TEXTURE_BEGIN_SLOT);
         }
 
         // Update sampler bindings as well
-        CauldronAssert(ASSERT_CRITICAL, m_RTInfoTables.m_Samplers.size() <= MAX_SAMPLERS_COUNT, L"Too many samplers.");
-        for (uint32_t i = 0; i < m_RTInfoTables.m_Samplers.size(); ++i)
+        CauldronAssert(ASSERT_CRITICAL, tables.m_Samplers.size() <= MAX_SAMPLERS_COUNT, L"Too many samplers.");
+        for (uint32_t i = 0; i < tables.m_Samplers.size(); ++i)
         {
-            m_pWorkGraphParameterSet->SetSampler(m_RTInfoTables.m_Samplers[i], i + SAMPLER_BEGIN_SLOT);
+            m_pWorkGraphParameterSet->SetSampler(tables.m_Samplers[i], i + SAMPLER_BEGIN_SLOT);
         }
 
-        CauldronAssert(ASSERT_CRITICAL, m_RTInfoTables.m_IndexBuffers.size() <= MAX_BUFFER_COUNT, L"Too many index buffers.");
-        for (uint32_t i = 0; i < m_RTInfoTables.m_IndexBuffers.size(); ++i)
+        CauldronAssert(ASSERT_CRITICAL, tables.m_IndexBuffers.size() <= MAX_BUFFER_COUNT, L"Too many index buffers.");
+        for (uint32_t i = 0; i < tables.m_IndexBuffers.size(); ++i)
         {
-            m_pWorkGraphParameterSet->SetBufferSRV(m_RTInfoTables.m_IndexBuffers[i], i + INDEX_BUFFER_BEGIN_SLOT);
+            m_pWorkGraphParameterSet->SetBufferSRV(tables.m_IndexBuffers[i], i + INDEX_BUFFER_BEGIN_SLOT);
         }
 
-        CauldronAssert(ASSERT_CRITICAL, m_RTInfoTables.m_VertexBuffers.size() <= MAX_BUFFER_COUNT, L"Too many vertex buffers.");
-        for (uint32_t i = 0; i < m_RTInfoTables.m_VertexBuffers.size(); ++i)
+        CauldronAssert(ASSERT_CRITICAL, tables.m_VertexBuffers.size() <= MAX_BUFFER_COUNT, L"Too many vertex buffers.");
+        for (uint32_t i = 0; i < tables.m_VertexBuffers.size(); ++i)
         {
-            m_pWorkGraphParameterSet->SetBufferSRV(m_RTInfoTables.m_VertexBuffers[i], i + VERTEX_BUFFER_BEGIN_SLOT);
+            m_pWorkGraphParameterSet->SetBufferSRV(tables.m_VertexBuffers[i], i + VERTEX_BUFFER_BEGIN_SLOT);
         }
     }
+
+    // Replaced buffers might still be read by frames in flight
+    for (auto* pBuffer : pTables->retiredBuffers)
+    {
+        RetireBuffer(pBuffer);
+    }
+    pTables->retiredBuffers.clear();
+
+    if (m_pBoundRTInfoTables)
+    {
+        delete m_pBoundRTInfoTables;
+    }
+
+    m_pBoundRTInfoTables = pTables;
 }
 
-void IvyRenderModule::OnContentUnloaded(ContentBlock* pContentBlock)
+void IvyRenderModule::AddSceneMeshInstance(const Mesh* pMesh, const Mat4& transform)
 {
-    for (auto materialInfo : m_RTInfoTables.m_cpuMaterialBuffer)
+    const std::wstring& meshName = GetMeshName(pMesh);
+
+    // Ivy meshes are only used for rendering the generated ivy
+    if ((meshName == L"..\\media\\Ivy\\Stem") || (meshName == L"..\\media\\Ivy\\Leaf"))
     {
-        if (materialInfo.albedo_tex_id > 0)
-            RemoveTexture(materialInfo.albedo_tex_id);
-        if (materialInfo.arm_tex_id > 0)
-            RemoveTexture(materialInfo.arm_tex_id);
-        if (materialInfo.emission_tex_id > 0)
-            RemoveTexture(materialInfo.emission_tex_id);
-        if (materialInfo.normal_tex_id > 0)
-            RemoveTexture(materialInfo.normal_tex_id);
+        return;
+    }
+
+    // Triangles are stored in object space, thus further instances only need their transform
+    const auto existingMesh = m_sceneMeshIndices.find(pMesh->GetMeshIndex());
+
+    if (existingMesh != m_sceneMeshIndices.end())
+    {
+        m_sceneMeshes[existingMesh->second].instanceTransforms.push_back(transform);
+        ++m_sceneGeometryVersion;
+        UpdateSceneMeshSamplingTriangles(existingMesh->second);
+        return;
+    }
+
+    const uint32_t sceneMeshIndex = static_cast<uint32_t>(m_sceneMeshes.size());
+    m_sceneMeshIndices.emplace(pMesh->GetMeshIndex(), sceneMeshIndex);
+
+    SceneMesh sceneMesh;
+    sceneMesh.name = WStringToString(meshName);
+    sceneMesh.instanceTransforms.push_back(transform);
+    m_sceneMeshes.push_back(sceneMesh);
+
+    // Geometry is read back in Execute, as copies have to be recorded to a command list
+    for (uint32_t i = 0; i < pMesh->GetNumSurfaces(); ++i)
+    {
+        const Surface* pSurface = pMesh->GetSurface(i);
+
+        // Ivy only grows on opaque surfaces
+        if (pSurface->HasTranslucency())
+        {
+            m_sceneMeshes[sceneMeshIndex].surfaceFaceNormalOffsets.push_back(IVY_FACE_NORMAL_NONE);
+            continue;
+        }
+
+        // Face normals are filled in once the readback completed
+        const uint32_t faceNormalOffset = static_cast<uint32_t>(m_faceNormals.size());
+        m_faceNormals.resize(m_faceNormals.size() + pSurface->GetIndexBuffer().Count / 3, 0);
+        m_sceneMeshes[sceneMeshIndex].surfaceFaceNormalOffsets.push_back(faceNormalOffset);
+
+        SceneGeometryReadback readback;
+        readback.sceneMeshIndex   = sceneMeshIndex;
+        readback.pPositionBuffer  = pSurface->GetVertexBuffer(VertexAttributeType::Position).pBuffer;
+        readback.vertexCount      = pSurface->GetVertexBuffer(VertexAttributeType::Position).Count;
+        readback.pIndexBuffer     = pSurface->GetIndexBuffer().pBuffer;
+        readback.indexCount       = pSurface->GetIndexBuffer().Count;
+        readback.indexStride      = (pSurface->GetIndexBuffer().IndexFormat == ResourceFormat::R16_UINT) ? sizeof(uint16_t) : sizeof(uint32_t);
+        readback.faceNormalOffset = faceNormalOffset;
+
+        m_pendingGeometryReadbacks.push_back(readback);
     }
 }
 
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include "render/commandlist.h"
 #include "render/rendermodule.h"
 #include "render/shaderbuilder.h"
 #include "core/contentmanager.h"
@@ -29,16 +30,31 @@
 // common files with shaders
 #include "shaders/ivycommon.h"
 
+#include "distancefield.h"
+#include "hitcache.h"
+#include "hiz.h"
+#include "lineagetrace.h"
+
 // d3dx12 for work graphs
 #include "d3dx12/d3dx12.h"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <unordered_map>
+
+class ReadbackRing;
+class UploadRing;
+
 // Forward declaration of Cauldron classes
 namespace cauldron
 {
     class Buffer;
+    class Mesh;
     class ParameterSet;
     class PipelineObject;
-    class RasterView;
     class RootSignature;
     class Texture;
 }  // namespace cauldron
@@ -55,7 +71,8 @@ public:
     void Init(const json& initData) override;
 
     /**
-     * @brief   Execute the work graph.
+     * @brief   Draws ivy grown in this frame into the shadow maps and reads back growth results.
+     *          Runs after GBufferRenderModule, which grows & draws ivy through ExecuteGBufferPass.
      */
     void Execute(double deltaTime, cauldron::CommandList* pCmdList) override;
 
@@ -65,6 +82,10 @@ public:
     void OnResize(const cauldron::ResolutionInfo& resInfo) override;
 
 private:
+    /**
+     * @brief   Execute the work graph inside the raster pass of GBufferRenderModule, with the GBuffer targets bound.
+     */
+    void ExecuteGBufferPass(double deltaTime, cauldron::CommandList* pCmdList);
     /**
      * @brief   Create and initialize textures required for rendering and shading.
      */
@@ -73,11 +94,202 @@ private:
      * @brief   Create and initialize the work graph program with mesh nodes.
      */
     void InitWorkGraphProgram();
+    /**
+     * @brief   Create the depth-only work graph drawing the growth cache into shadow maps.
+     */
+    void InitShadowWorkGraphProgram();
+    /**
+     * @brief   Generate and upload the Poisson-disk point set used for sampling ivy areas.
+     */
+    void InitAreaSamplingPoints();
+    /**
+     * @brief   Create the growth statistics counters and their readback ring.
+     */
+    void InitStatistics();
+    /**
+     * @brief   Create the spatial hit cache of IvyBranch ray queries.
+     */
+    void InitHitCache();
+    /**
+     * @brief   Create the frontier buffers of progressive growth & the growth caches.
+     */
+    void InitProgressiveGrowth();
+    /**
+     * @brief   Create the HiZ pyramid texture & the compute pipeline downsampling GBufferDepth into it.
+     */
+    void InitHiZ();
+    /**
+     * @brief   Updates the views of GBufferDepth & the HiZ pyramid, which are recreated on resize.
+     */
+    void BindHiZ();
+    /**
+     * @brief   Create the leaf card mask, which is baked from the leaf mesh once it is loaded.
+     */
+    void InitLeafCards();
+    /**
+     * @brief   Create the meshlet buffer, which is baked from the stem & leaf mesh once both are loaded.
+     */
+    void InitMeshlets();
+    /**
+     * @brief   Create the staging ring & copy queue RT info tables are uploaded through.
+     */
+    void InitRTInfoTables();
+
+    /**
+     * @brief   Grows the declared input record limit of the work graph if the current number of entry records exceeds it.
+     *          Capacity grows geometrically; backing memory is only reallocated and re-initialized when the limit is crossed.
+     */
+    void UpdateWorkGraphInputCapacity();
+    /**
+     * @brief   Keeps the GPU-resident copy of the entry records up to date.
+     *          Only edited records are copied; the buffer is reallocated & fully uploaded if the input record capacity changed.
+     */
+    void UpdateEntryRecordBuffer(cauldron::CommandList* pCmdList);
+    /**
+     * @brief   Copies geometry of newly loaded meshes to CPU memory and transforms completed readbacks to world space.
+     */
+    void UpdateSceneGeometryReadback(cauldron::CommandList* pCmdList);
+    /**
+     * @brief   Uploads face normals of newly registered surfaces & of surfaces whose geometry was read back.
+     */
+    void UpdateFaceNormals(cauldron::CommandList* pCmdList);
+    /**
+     * @brief   Transforms the triangles of all instances of a scene mesh to world space, computing their area & chunk bounds for surface sampling.
+     */
+    void UpdateSceneMeshSamplingTriangles(uint32_t sceneMeshIndex);
+    /**
+     * @brief   Rebuilds the area-weighted triangle alias tables of ivy areas whose region, mesh or geometry changed.
+     *          Only the ranges of rebuilt tables are uploaded through the command list.
+     */
+    void UpdateAreaSurfaceSampling(cauldron::CommandList* pCmdList);
+    /**
+     * @brief   Bakes the distance field for SDF growth queries on worker threads once scene geometry or the proxy setting changed,
+     *          and uploads completed bakes over several frames. The previous field stays bound until the upload completed.
+     */
+    void UpdateDistanceField(cauldron::CommandList* pCmdList);
+    /**
+     * @brief   Resets the frontier progressive growth appends to in this frame.
+     *          Returns true if growth restarts from the entry records, in which case the growth cache isn't drawn.
+     */
+    bool UpdateProgressiveGrowth(cauldron::CommandList* pCmdList);
+    /**
+     * @brief   Advances the window of roots regenerated in this frame & adapts its size to the frame time budget.
+     */
+    void UpdateTemporalRegeneration();
+    /**
+     * @brief   Reads back completed growth statistics, then records a readback & reset of the current counters.
+     *          Statistics are available with a delay of a few frames, as reading them never waits for the GPU.
+     */
+    void UpdateStatistics(cauldron::CommandList* pCmdList);
+    /**
+     * @brief   Resizes the per-root statistics counters & output digests to the work graph input record capacity.
+     */
+    void UpdateRootStatisticsCapacity();
+    /**
+     * @brief   Records a copy from the zero buffer over the first size bytes of pDestination. pDestination has to be in copy dest state.
+     */
+    void ClearBufferRegion(cauldron::CommandList* pCmdList, const cauldron::GPUResource* pDestination, uint32_t size);
+    /**
+     * @brief   Uploads element ranges [first; second) of a structured buffer read by the work graph through the command list.
+     *          The buffer grows geometrically to elementCount; the first copyCount elements are copied from the previous buffer on the GPU.
+     *          Returns true if the buffer was replaced, which then has to be bound again.
+     */
+    bool UpdateElementBuffer(cauldron::CommandList*                            pCmdList,
+                             cauldron::Buffer*&                                pBuffer,
+                             uint32_t&                                         capacity,
+                             const wchar_t*                                    name,
+                             const void*                                       pElements,
+                             uint32_t                                          elementSize,
+                             uint32_t                                          elementCount,
+                             uint32_t                                          copyCount,
+                             const std::vector<std::pair<uint32_t, uint32_t>>& ranges);
+    /**
+     * @brief   Finds the record of a root index; the other index is set to -1. Returns false if no record has the root index.
+     */
+    bool FindRootRecord(uint32_t rootIndex, int& branchIndex, int& areaIndex) const;
+    /**
+     * @brief   Records readback of a lineage trace recorded in this frame, or writes & analyzes a completed readback.
+     */
+    void UpdateLineageTrace(cauldron::CommandList* pCmdList, bool traceRecorded);
+    /**
+     * @brief   Reads back completed output digests & compares them to the golden digests, then records a readback & reset of the current digests.
+     */
+    void UpdateOutputDigests(cauldron::CommandList* pCmdList);
+    /**
+     * @brief   Reads back the append counters of the frontier & growth cache written in a previous frame, then records a readback for this frame.
+     *          Records & entries beyond IVY_FRONTIER_CAPACITY & the growth cache capacities are dropped by the shaders; each overflow is warned about once.
+     */
+    void UpdateGrowthOverflow(cauldron::CommandList* pCmdList);
+    /**
+     * @brief   Records readback of the hit cache if an inspection was requested, or loads a completed readback into a CPU hit cache.
+     */
+    void UpdateHitCacheInspection(cauldron::CommandList* pCmdList);
+    /**
+     * @brief   Collects the shadow maps of all lights as views of this frame, which growth tests each cached instance against.
+     *          Shadow maps beyond IVY_MAX_VIEWS don't receive ivy shadows.
+     */
+    void UpdateShadowViews(WorkGraphCBData& workGraphData);
+    /**
+     * @brief   Draws the growth cache written in this frame into each shadow map view, using simplified LODs.
+     *          All views of a shadow map render target are drawn by a single dispatch. Growth caches have to be in unordered access state.
+     */
+    void ExecuteShadowPass(cauldron::CommandList* pCmdList, const WorkGraphCBData& workGraphData);
+    /**
+     * @brief   Downsamples the render region of GBufferDepth into all mips of the HiZ pyramid, see IVY_HIZ.
+     *          GBufferDepth has to be in shader resource state.
+     */
+    void UpdateHiZ(cauldron::CommandList* pCmdList, uint32_t width, uint32_t height);
+    /**
+     * @brief   Uploads the changes of m_RTInfoTables on the copy queue & publishes a snapshot to Execute. Called by content loads.
+     *          A previously published set which Execute didn't take yet is replaced, see RTInfoTableSet::CarryOver.
+     */
+    void PublishRTInfoTables(std::vector<std::pair<const cauldron::Mesh*, Mat4>>&& sceneMeshInstances);
+    /**
+     * @brief   Binds the latest published RT info tables once their upload completed, registers their mesh instances & retires replaced buffers.
+     *          Never waits for the copy queue; the previous set stays bound until then.
+     */
+    void UpdateRTInfoTables(cauldron::CommandList* pCmdList);
+    /**
+     * @brief   Defers destruction of a buffer until the GPU is guaranteed to no longer reference it.
+     */
+    void RetireBuffer(cauldron::Buffer* pBuffer);
+    /**
+     * @brief   Destroys retired buffers which are no longer in flight.
+     */
+    void ReleaseRetiredBuffers();
 
     /**
      * @brief   Renders 3D user interface for manipulating ivy generation.
      */
     void RenderUserInterface();
+    /**
+     * @brief   Renders window with latest growth statistics.
+     */
+    void RenderStatisticsWindow();
+    /**
+     * @brief   Renders window with statistics of the last recorded lineage trace.
+     */
+    void RenderLineageTraceWindow();
+    /**
+     * @brief   Renders window with the latest output digests and their comparison to the golden digests.
+     */
+    void RenderOutputDigestWindow();
+    /**
+     * @brief   Adds a copy of the selected (or last) ivy branch record, offset to the side.
+     */
+    void AddIvyBranch();
+    /**
+     * @brief   Adds a copy of the selected (or last) ivy area record, offset to the side.
+     */
+    void AddIvyArea();
+    /**
+     * @brief   Queues upload of a branch record edited through the UI or gizmo & restarts progressive growth.
+     */
+    void MarkIvyBranchEdited(int branchIndex);
+    /**
+     * @brief   Queues upload & surface sampling rebuild of an area record edited through the UI or gizmo, and restarts progressive growth.
+     */
+    void MarkIvyAreaEdited(int areaIndex);
 
     /**
      * Prepare surface information for raytracing passes.
@@ -88,21 +300,38 @@ private:
      */
     virtual void OnContentUnloaded(cauldron::ContentBlock* pContentBlock) override;
 
+    /**
+     * @brief   Registers an instance of a mesh for surface sampling and queues readback of its geometry on first use.
+     */
+    void AddSceneMeshInstance(const cauldron::Mesh* pMesh, const Mat4& transform);
+
     int32_t AddTexture(const cauldron::Material* pMaterial, const cauldron::TextureClass textureClass, int32_t& textureSamplerIndex);
     void    RemoveTexture(int32_t index);
 
-    const cauldron::Texture*                   m_pGBufferDepthOutput               = nullptr;
-    const cauldron::RasterView*                m_pGBufferDepthRasterView           = nullptr;
-    const cauldron::Texture*                   m_pGBufferAlbedoOutput              = nullptr;
-    const cauldron::Texture*                   m_pGBufferNormalOutput              = nullptr;
-    const cauldron::Texture*                   m_pGBufferAoRoughnessMetallicOutput = nullptr;
-    const cauldron::Texture*                   m_pGBufferMotionOutput              = nullptr;
-    std::array<const cauldron::RasterView*, 4> m_pGBufferRasterViews;
-
-    cauldron::RootSignature* m_pWorkGraphRootSignature       = nullptr;
-    cauldron::ParameterSet*  m_pWorkGraphParameterSet        = nullptr;
-    ID3D12StateObject*       m_pWorkGraphStateObject         = nullptr;
-    cauldron::Buffer*        m_pWorkGraphBackingMemoryBuffer = nullptr;
+    const cauldron::Texture* m_pGBufferDepthOutput               = nullptr;
+    const cauldron::Texture* m_pGBufferAlbedoOutput              = nullptr;
+    const cauldron::Texture* m_pGBufferNormalOutput              = nullptr;
+    const cauldron::Texture* m_pGBufferAoRoughnessMetallicOutput = nullptr;
+    const cauldron::Texture* m_pGBufferMotionOutput              = nullptr;
+
+    // State of the GBuffer pass of this frame, which Execute finishes
+    struct GBufferPassState
+    {
+        bool                           executed           = false;
+        bool                           recordLineageTrace = false;
+        bool                           useGrowthCache     = false;
+        WorkGraphCBData                workGraphData      = {};
+        std::vector<cauldron::Barrier> barriers;
+    } m_gbufferPass;
+
+    cauldron::RootSignature*    m_pWorkGraphRootSignature       = nullptr;
+    cauldron::ParameterSet*     m_pWorkGraphParameterSet        = nullptr;
+    ID3D12StateObject*          m_pWorkGraphStateObject         = nullptr;
+    ID3D12WorkGraphProperties1* m_pWorkGraphProperties          = nullptr;
+    UINT                        m_WorkGraphIndex                = 0;
+    cauldron::Buffer*           m_pWorkGraphBackingMemoryBuffer = nullptr;
+    // Maximum number of entry records the backing memory was sized for
+    UINT                        m_WorkGraphInputRecordCapacity  = 0;
     // Program description for binding the work graph
     // contains work graph identifier & backing memory
     D3D12_SET_PROGRAM_DESC m_WorkGraphProgramDesc = {};
@@ -110,8 +339,11 @@ private:
     // Index of entry nodes
     struct WorkGraphEntryPoints
     {
-        UINT IvyBranch = 0;
-        UINT IvyArea   = 0;
+        UINT IvyBranch           = 0;
+        UINT IvyArea             = 0;
+        UINT IvyGrowthCacheDraw  = 0;
+        UINT IvyLeafCardMaskBake = 0;
+        UINT IvyMeshletBake      = 0;
     } m_WorkGraphEntryPoints;
 
     std::vector<IvyBranchRecord> m_ivyBranchRecords;
@@ -119,10 +351,36 @@ private:
     std::vector<IvyAreaRecord>   m_ivyAreaRecords;
     int                          m_selectedIvyArea = -1;
     bool                         m_updateIvyUI     = false;
+    // Root indices are assigned in creation order & never change, thus records of each type are sorted by root index
+    uint32_t                     m_rootCount       = 0;
+
+    // Records added through the UI are deferred to Execute, as adding records invalidates pointers held by m_UISection
+    int      m_ivyRecordAddCount    = 1;
+    uint32_t m_pendingIvyBranchAdds = 0;
+    uint32_t m_pendingIvyAreaAdds   = 0;
 
     cauldron::UISection m_UISection;
+    cauldron::UISection m_SettingsUISection;
+
+    // GPU-resident entry records for D3D12_DISPATCH_MODE_MULTI_NODE_GPU_INPUT
+    // Buffer layout: D3D12_MULTI_NODE_GPU_INPUT, D3D12_NODE_GPU_INPUT per entry point, IvyBranchRecords, IvyAreaRecords
+    bool                  m_useGpuEntryRecords        = false;
+    cauldron::Buffer*     m_pEntryRecordBuffer        = nullptr;
+    UINT                  m_entryRecordBufferCapacity = 0;
+    UINT                  m_entryRecordBufferBranches = 0;
+    UINT                  m_entryRecordBufferAreas    = 0;
+    std::vector<uint32_t> m_dirtyIvyBranchRecords;
+    std::vector<uint32_t> m_dirtyIvyAreaRecords;
+
+    // Number of frames recorded by Execute; used to delay destruction of GPU resources
+    uint64_t                                            m_FrameIndex = 0;
+    // CPU time in between the last two Execute calls
+    std::chrono::steady_clock::time_point               m_previousFrameTime = std::chrono::steady_clock::now();
+    float                                               m_frameTimeMs       = 0.f;
+    std::vector<std::pair<uint64_t, cauldron::Buffer*>> m_RetiredBuffers;
 
-    std::mutex m_CriticalSection;
+    // Serializes content loads, which build & publish RT info tables without blocking Execute, see PublishRTInfoTables
+    std::mutex m_ContentLoadCriticalSection;
 
     struct RTInfoTables
     {
@@ -143,14 +401,342 @@ private:
         std::vector<Surface_Info>        m_cpuSurfaceBuffer;
         std::vector<uint32_t>            m_cpuSurfaceIDsBuffer;
 
-        const cauldron::Buffer* m_pMaterialBuffer   = NULL;  // material_id -> Material buffer
-        const cauldron::Buffer* m_pSurfaceBuffer    = NULL;  // surface_id -> Surface_Info buffer
-        const cauldron::Buffer* m_pSurfaceIDsBuffer = NULL;  // flat array of uint32_t
-        const cauldron::Buffer* m_pInstanceBuffer   = NULL;  // instance_id -> Instance_Info buffer
-    } m_RTInfoTables;
+        // Cauldron mesh index & surface index in the mesh, parallel to m_cpuSurfaceIDsBuffer; face normal offsets are looked up by Execute
+        std::vector<std::pair<uint32_t, uint32_t>> m_surfaceMeshes;
+
+        // Surface index in m_cpuSurfaceBuffer & object-space bounding box of the ivy stem & leaf meshes
+        struct IvyMesh
+        {
+            int  surfaceIndex  = -1;
+            Vec4 boundsCenter  = Vec4(0.f);
+            Vec4 boundsExtents = Vec4(0.f);
+        };
+
+        IvyMesh m_ivyStem;
+        IvyMesh m_ivyLeaf;
+    };
+
+    // Tables of all loaded content; only accessed by content loads
+    RTInfoTables m_RTInfoTables;
+
+    // GPU copy of a table, which grows geometrically & is updated in place as long as only data beyond the uploaded part changes
+    struct RTInfoTableBuffer
+    {
+        cauldron::Buffer*    pBuffer         = nullptr;
+        size_t               capacityInBytes = 0;
+        // Data last uploaded to pBuffer, which changed ranges are found against
+        std::vector<uint8_t> uploadedData;
+    };
+
+    /**
+     * @brief   Records uploads of the elements of pData which differ from the uploaded data of table into the upload ring.
+     *          Changes to uploaded elements might be read by frames in flight, thus they reallocate the buffer & copy unchanged elements on the GPU.
+     *          Replaced buffers are appended to retiredBuffers.
+     */
+    void UploadRTInfoTable(RTInfoTableBuffer&              table,
+                           const wchar_t*                  name,
+                           const void*                     pData,
+                           size_t                          sizeInBytes,
+                           uint32_t                        stride,
+                           std::vector<cauldron::Buffer*>& retiredBuffers);
+
+    // Buffers of the tables; only accessed by content loads
+    RTInfoTableBuffer m_materialTableBuffer;    // material_id -> Material buffer
+    RTInfoTableBuffer m_surfaceTableBuffer;     // surface_id -> Surface_Info buffer
+    RTInfoTableBuffer m_surfaceIDsTableBuffer;  // flat array of uint32_t
+    RTInfoTableBuffer m_instanceTableBuffer;    // instance_id -> Instance_Info buffer
+
+    // Staging ring & copy queue of table uploads
+    UploadRing* m_pRTInfoUploadRing = nullptr;
+
+    // Immutable snapshot of m_RTInfoTables & the buffers it was uploaded to, published by content loads & bound by Execute
+    struct RTInfoTableSet
+    {
+        ~RTInfoTableSet();
+
+        /**
+         * @brief   Takes over the mesh instances & retired buffers of an older set which is replaced before it was bound.
+         */
+        void CarryOver(RTInfoTableSet& olderSet);
+
+        RTInfoTables tables;
+
+        const cauldron::Buffer* pMaterialBuffer   = nullptr;
+        const cauldron::Buffer* pSurfaceBuffer    = nullptr;
+        const cauldron::Buffer* pSurfaceIDsBuffer = nullptr;
+        const cauldron::Buffer* pInstanceBuffer   = nullptr;
+        // Fence value of the upload ring once the buffers are up to date
+        uint64_t                uploadFenceValue  = 0;
+
+        // Mesh instances loaded since the previously bound set, which are registered for surface sampling by Execute
+        std::vector<std::pair<const cauldron::Mesh*, Mat4>> sceneMeshInstances;
+        // Buffers replaced since the previously bound set, which might still be read by frames in flight
+        std::vector<cauldron::Buffer*>                      retiredBuffers;
+    };
+
+    // Latest published set which Execute didn't take yet. Content loads replace it, Execute takes it with an atomic exchange.
+    std::atomic<RTInfoTableSet*> m_pPendingRTInfoTables{nullptr};
+    // Set taken by Execute whose upload didn't complete yet
+    RTInfoTableSet*              m_pUploadingRTInfoTables = nullptr;
+    // Set bound to the work graph
+    RTInfoTableSet*              m_pBoundRTInfoTables     = nullptr;
+
+    // Face normal offset of each entry in the surface ID table, see IVY_FACE_NORMAL_OFFSETS
+    std::vector<uint32_t> m_faceNormalOffsets;
+    uint32_t              m_faceNormalOffsetCapacity = 0;
+    cauldron::Buffer*     m_pFaceNormalOffsetBuffer  = nullptr;
+
+    // Flattened face normals of all scene surfaces, filled in as scene geometry is read back, see IVY_FACE_NORMALS.
+    // The first face normal is a placeholder, as empty buffers cannot be bound.
+    std::vector<uint32_t>                      m_faceNormals             = {0};
+    uint32_t                                   m_uploadedFaceNormalCount = 0;
+    // Ranges of face normals filled in since the last upload
+    std::vector<std::pair<uint32_t, uint32_t>> m_readFaceNormalRanges;
+    uint32_t                                   m_faceNormalCapacity      = 0;
+    cauldron::Buffer*                          m_pFaceNormalBuffer       = nullptr;
+
+    // Tileable Poisson-disk point set for ivy area sampling
+    bool              m_usePoissonAreaSampling      = true;
+    cauldron::Buffer* m_pAreaPoissonDiskPointBuffer = nullptr;
+
+    // Trace single confirm rays while branches grow along a plane, see IVY_FLAG_ADAPTIVE_PROBING
+    bool m_useAdaptiveProbing = true;
+
+    // Spatial hit cache of IvyBranch ray queries, see IVY_FLAG_HIT_CACHE
+    bool              m_useHitCache                 = false;
+    cauldron::Buffer* m_pHitCacheBuffer             = nullptr;
+    // Entries of other epochs never match, thus incrementing the epoch invalidates the cache
+    uint32_t          m_hitCacheEpoch               = 0;
+    ReadbackRing*     m_pHitCacheReadback           = nullptr;
+    bool              m_hitCacheInspectionRequested = false;
+    bool              m_hitCacheInspectionPending   = false;
+    bool              m_hasHitCacheOccupancy        = false;
+    HitCacheOccupancy m_hitCacheOccupancy;
+
+    // Baked sparse distance field as alternative growth query backend, see IVY_FLAG_SDF_QUERIES
+    bool                             m_useSdfQueries                = false;
+    // Ray queries are compiled out of the work graph if the device doesn't support them, see IVY_SDF_QUERIES_ONLY
+    bool                             m_rayQueriesSupported          = true;
+    // Baking takes longer than a frame, thus it runs on worker threads & the previous field stays bound until it completes
+    std::future<SparseDistanceField> m_distanceFieldBake;
+    // Bake from simplified proxy geometry, see IVY_PROXY_TOLERANCE; ray query growth is unaffected and traces the scene TLAS
+    bool                             m_useProxyGeometry             = true;
+    // Scene geometry version & proxy setting of the latest started bake
+    uint32_t                         m_distanceFieldGeometryVersion = UINT32_MAX;
+    bool                             m_distanceFieldProxyGeometry   = false;
+    cauldron::Buffer*                m_pSdfBrickIndexBuffer         = nullptr;
+    cauldron::Buffer*                m_pSdfBrickBuffer              = nullptr;
+    // Completed bake uploaded through the command list, at most DistanceFieldUploadSizePerFrame bytes per frame
+    SparseDistanceField              m_uploadingDistanceField;
+    cauldron::Buffer*                m_pUploadingSdfBrickIndexBuffer = nullptr;
+    cauldron::Buffer*                m_pUploadingSdfBrickBuffer      = nullptr;
+    uint32_t                         m_distanceFieldUploadedSize     = 0;
+    Vec4                             m_sdfBoundsMin                 = Vec4(0.f);
+    uint32_t                         m_sdfBrickGridSize[3]          = {};
+    // Backend selection of the previous frame; hit cache entries of the other backend are invalidated when switching
+    bool                             m_usedSdfQueries               = false;
+
+    // Grow a bounded number of recursion levels per frame & draw previous growth from a cache, see IVY_FLAG_PROGRESSIVE_GROWTH
+    bool                             m_useProgressiveGrowth         = false;
+    int                              m_progressiveLevelsPerFrame    = 2;
+    bool                             m_restartProgressiveGrowth     = false;
+    // Whether progressive growth ran in the previous frame, i.e. whether the frontier & growth cache are valid
+    bool                             m_progressiveGrowthActive      = false;
+    // Hash of settings & scene geometry the current growth started from; growth restarts once it changes or a record was edited
+    uint64_t                         m_progressiveGrowthHash        = 0;
+    std::array<cauldron::Buffer*, 2> m_pFrontierBuffers             = {};
+    // Frontier dispatched in this frame, the other one is appended to
+    uint32_t                         m_frontierReadIndex            = 0;
+    // Append counters of the frontier & growth cache, read back to count records & entries dropped at their capacities
+    ReadbackRing*                    m_pFrontierCounterReadback     = nullptr;
+    ReadbackRing*                    m_pGrowthCacheCounterReadback  = nullptr;
+    uint32_t                         m_droppedFrontierRecordCount   = 0;
+    uint32_t                         m_droppedCachedStemCount       = 0;
+    uint32_t                         m_droppedCachedLeafCount       = 0;
+
+    // Regenerate a window of roots per frame & draw all other roots from the growth cache, see IVY_FLAG_TEMPORAL_REGENERATION
+    bool     m_useTemporalRegeneration   = false;
+    int      m_regenerationRootsPerFrame = 64;
+    bool     m_adaptRegenerationToBudget = false;
+    float    m_regenerationFrameBudgetMs = 16.6f;
+    // Roots in [m_regenerationStart; m_regenerationStart + m_regenerationCount) are regenerated in this frame
+    uint32_t m_regenerationStart         = 0;
+    uint32_t m_regenerationCount         = 0;
+
+    // Procedural wind bending of stems & leaves in the mesh nodes, see IVY_FLAG_WIND
+    bool  m_useWind              = false;
+    float m_windStrength         = 0.05f;
+    float m_windDirectionDegrees = 30.f;
+    // Animation time of this & the previous frame, wraps after IVY_WIND_TIME_PERIOD
+    float m_windTime             = 0.f;
+    float m_previousWindTime     = 0.f;
+
+    // Depth-only work graph drawing the growth cache into shadow maps, see IvyShadowCacheDraw
+    bool                     m_useIvyShadows              = true;
+    cauldron::RootSignature* m_pShadowRootSignature       = nullptr;
+    cauldron::ParameterSet*  m_pShadowParameterSet        = nullptr;
+    ID3D12StateObject*       m_pShadowStateObject         = nullptr;
+    cauldron::Buffer*        m_pShadowBackingMemoryBuffer = nullptr;
+    D3D12_SET_PROGRAM_DESC   m_ShadowProgramDesc          = {};
+    UINT                     m_ShadowEntryPoint           = 0;
+    // Shadow map views of this frame; view v is drawn into viewport v of its render target, see IvyViewProjections
+    struct ShadowView
+    {
+        int            renderTargetIndex = -1;
+        D3D12_VIEWPORT viewport          = {};
+        D3D12_RECT     scissorRect       = {};
+    };
+    std::vector<ShadowView>  m_shadowViews                = {};
+    // Shadow maps of this frame beyond IVY_MAX_VIEWS, which don't receive ivy shadows
+    uint32_t                 m_droppedShadowViewCount     = 0;
+    // Object-space bounding boxes of the stem & leaf meshes, which the shadow LODs & occlusion culling are derived from
+    Vec4                     m_ivyStemBoundsCenter        = Vec4(0.f);
+    Vec4                     m_ivyStemBoundsExtents       = Vec4(0.f);
+    Vec4                     m_ivyLeafBoundsCenter        = Vec4(0.f);
+    Vec4                     m_ivyLeafBoundsExtents       = Vec4(0.f);
+
+    // HiZ pyramid of GBufferDepth for occlusion culling of drawn instances, see IVY_HIZ
+    bool                     m_useOcclusionCulling = true;
+    const cauldron::Texture* m_pHiZTexture         = nullptr;
+    cauldron::RootSignature* m_pHiZRootSignature   = nullptr;
+    cauldron::ParameterSet*  m_pHiZParameterSet    = nullptr;
+    ID3D12PipelineState*     m_pHiZPipelineState   = nullptr;
+
+    // Distant leaves drawn as cards, see IVY_FLAG_LEAF_CARDS
+    bool                     m_useLeafCards         = false;
+    float                    m_leafCardDistance     = 30.f;
+    const cauldron::Texture* m_pLeafCardMaskTexture = nullptr;
+    // Whether the mask was baked from the currently loaded leaf mesh
+    bool                     m_leafCardMaskBaked    = false;
+
+    // Meshlets of the stem & leaf mesh culled by the mesh nodes, see IVY_MESHLETS
+    bool              m_useMeshletCulling = true;
+    cauldron::Buffer* m_pMeshletBuffer    = nullptr;
+    // Whether the meshlets were baked from the currently loaded meshes
+    bool              m_meshletsBaked     = false;
+
+    // Stems & leaves of previous frames, see IVY_GROWTH_CACHE
+    std::array<cauldron::Buffer*, 2> m_pGrowthCacheBuffers = {};
+    // Cache drawn in this frame, the other one is written
+    uint32_t                         m_growthCacheReadIndex = 0;
+    // Whether the previous frame wrote the growth cache, i.e. whether the cache drawn in this frame is valid
+    bool                             m_growthCacheWritten   = false;
+
+    // Cauldron doesn't keep vertex data in CPU memory, thus geometry for surface sampling is read back once after loading
+    struct SceneGeometryReadback
+    {
+        uint32_t                sceneMeshIndex    = 0;
+        const cauldron::Buffer* pPositionBuffer   = nullptr;
+        uint32_t                vertexCount       = 0;
+        const cauldron::Buffer* pIndexBuffer      = nullptr;
+        uint32_t                indexCount        = 0;
+        uint32_t                indexStride       = 0;
+        uint32_t                faceNormalOffset  = 0;
+        ID3D12Resource*         pReadbackResource = nullptr;
+        uint64_t                readbackFrame     = 0;
+    };
+
+    struct SceneMesh
+    {
+        std::string           name;
+        std::vector<Mat4>     instanceTransforms;
+        // Object-space triangles of the mesh, three vertices per triangle; placed by instanceTransforms
+        std::vector<Vec3>     triangleVertices;
+        // First face normal of each surface, IVY_FACE_NORMAL_NONE for translucent surfaces
+        std::vector<uint32_t> surfaceFaceNormalOffsets;
+
+        // World-space triangles of all instances & their area, see UpdateSceneMeshSamplingTriangles
+        std::vector<SurfaceSamplingTriangle> samplingTriangles;
+        std::vector<float>                   samplingTriangleAreas;
+        // World-space bounds of each SurfaceSamplingChunkSize consecutive sampling triangles
+        std::vector<std::pair<Vec3, Vec3>>   samplingChunkBounds;
+        // m_sceneGeometryVersion the sampling triangles were built for
+        uint32_t                             geometryVersion = 0;
+    };
+
+    std::vector<SceneGeometryReadback>     m_pendingGeometryReadbacks;
+    std::vector<SceneMesh>                 m_sceneMeshes;
+    std::unordered_map<uint32_t, uint32_t> m_sceneMeshIndices;  // Cauldron mesh index -> index in m_sceneMeshes
+    // Incremented whenever geometry of a scene mesh became available
+    uint32_t                               m_sceneGeometryVersion = 0;
+    // Options for mesh selection in UI; first option selects all meshes
+    std::vector<std::string>               m_sceneMeshNames;
+    std::vector<const char*>               m_sceneMeshOptions;
+
+    // Surface sampling settings of ivy areas, parallel to m_ivyAreaRecords
+    struct IvyAreaSurfaceSampling
+    {
+        bool    enabled    = false;
+        int32_t meshOption = 0;
+
+        // m_sceneGeometryVersion the sampling triangles were built for
+        uint32_t builtGeometryVersion = 0;
+
+        // Range of the alias table in m_areaSurfaceTriangles; the range is only reallocated once the table outgrew it
+        uint32_t triangleOffset   = 0;
+        uint32_t triangleCount    = 0;
+        uint32_t triangleCapacity = 0;
+        float    surfaceArea      = 0.f;
+    };
+
+    std::vector<IvyAreaSurfaceSampling> m_ivyAreaSurfaceSampling;
+    // Areas whose table is rebuilt in the next frame, see MarkIvyAreaEdited
+    std::vector<uint32_t>               m_dirtySurfaceSamplingAreas;
+    // m_sceneGeometryVersion up to which tables of changed meshes were queued for rebuild
+    uint32_t                            m_surfaceSamplingGeometryVersion = 0;
+
+    // Alias tables of all ivy areas. The first triangle is a placeholder, as empty buffers cannot be bound.
+    std::vector<SurfaceSamplingTriangle>       m_areaSurfaceTriangles = {SurfaceSamplingTriangle{}};
+    // Triangles in ranges owned by ivy areas; abandoned ranges are compacted once they make up half of m_areaSurfaceTriangles
+    uint32_t                                   m_ownedAreaSurfaceTriangleCount    = 0;
+    uint32_t                                   m_uploadedAreaSurfaceTriangleCount = 0;
+    // Ranges of triangles rebuilt since the last upload
+    std::vector<std::pair<uint32_t, uint32_t>> m_dirtyAreaSurfaceTriangleRanges;
+    uint32_t                                   m_areaSurfaceTriangleCapacity      = 0;
+    cauldron::Buffer*                          m_pAreaSurfaceTriangleBuffer       = nullptr;
+
+    // Growth statistics counters, see IVY_FLAG_STATISTICS
+    bool                                      m_useStatistics        = false;
+    bool                                      m_logStatistics        = false;
+    cauldron::Buffer*                         m_pStatisticsBuffer    = nullptr;
+    ReadbackRing*                             m_pStatisticsReadback  = nullptr;
+    std::array<uint32_t, IVY_STATISTIC_COUNT> m_statistics           = {};
+    // Frame in which m_statistics were recorded
+    uint64_t                                  m_statisticsFrameIndex = 0;
+    std::ofstream                             m_statisticsLog;
+
+    // Per-root statistics counters, IVY_ROOT_STATISTIC_COUNT counters for each entry record
+    cauldron::Buffer*     m_pRootStatisticsBuffer   = nullptr;
+    ReadbackRing*         m_pRootStatisticsReadback = nullptr;
+    uint32_t              m_rootStatisticsCapacity  = 0;
+    std::vector<uint32_t> m_rootStatistics;
+    // Zeros covering the per-root statistics & output digests, source of their per-frame reset
+    cauldron::Buffer*     m_pZeroBuffer             = nullptr;
+
+    // Lineage trace of a single frame, see IVY_FLAG_LINEAGE_TRACE
+    cauldron::Buffer*      m_pLineageTraceBuffer       = nullptr;
+    ReadbackRing*          m_pLineageTraceReadback     = nullptr;
+    bool                   m_lineageTraceRequested     = false;
+    bool                   m_lineageTracePending       = false;
+    bool                   m_hasLineageTraceStatistics = false;
+    LineageTraceStatistics m_lineageTraceStatistics;
+
+    // Per-root digests of all generated stem & leaf transforms, see IVY_FLAG_OUTPUT_DIGEST
+    bool                  m_useOutputDigests        = false;
+    bool                  m_saveGoldenOutputDigests = false;
+    cauldron::Buffer*     m_pOutputDigestBuffer     = nullptr;
+    ReadbackRing*         m_pOutputDigestReadback   = nullptr;
+    std::vector<uint64_t> m_outputDigests;
+    // Frame in which m_outputDigests were recorded
+    uint64_t              m_outputDigestFrameIndex  = 0;
+    bool                  m_hasOutputDigests        = false;
+    std::vector<uint64_t> m_goldenOutputDigests;
+    bool                  m_hasGoldenOutputDigests  = false;
+    // Roots whose latest digest differs from the golden digest
+    std::vector<uint32_t> m_outputDigestMismatches;
 
-    // Index of ivy stem surface in m_cpuSurfaceBuffer
+    // Index of ivy stem surface in the bound surface table
     int m_ivyStemSurfaceIndex = -1;
-    // Index of ivy leaf surface in m_cpuSurfaceBuffer
+    // Index of ivy leaf surface in the bound surface table
     int m_ivyLeafSurfaceIndex = -1;
 };
\ No newline at end of file
@@ -0,0 +1,157 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "lineagetrace.h"
+
+#include <algorithm>
+#include <fstream>
+
+static const uint32_t LineageTraceMagic   = 'I' | ('V' << 8) | ('Y' << 16) | ('L' << 24);
+static const uint32_t LineageTraceVersion = 1;
+
+bool WriteLineageTrace(const std::string& fileName, const LineageTrace& trace)
+{
+    std::ofstream file(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!file)
+    {
+        return false;
+    }
+
+    const uint32_t header[4] = {LineageTraceMagic, LineageTraceVersion, static_cast<uint32_t>(trace.entries.size()), trace.droppedEntryCount};
+
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(trace.entries.data()), trace.entries.size() * sizeof(IvyLineageTraceEntry));
+
+    return file.good();
+}
+
+bool ReadLineageTrace(const std::string& fileName, LineageTrace& trace)
+{
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+
+    uint32_t header[4] = {};
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+
+    if (!file || (header[0] != LineageTraceMagic) || (header[1] != LineageTraceVersion))
+    {
+        return false;
+    }
+
+    trace.entries.resize(header[2]);
+    trace.droppedEntryCount = header[3];
+
+    file.read(reinterpret_cast<char*>(trace.entries.data()), trace.entries.size() * sizeof(IvyLineageTraceEntry));
+
+    return file.good();
+}
+
+LineageTraceStatistics ReplayLineageTrace(const LineageTrace& trace)
+{
+    LineageTraceStatistics statistics;
+
+    const uint32_t entryCount = static_cast<uint32_t>(trace.entries.size());
+
+    statistics.invocationCount = entryCount;
+
+    // Rebuild tree. Entry ids are 1 + entry index.
+    std::vector<uint32_t> childCounts(entryCount, 0);
+
+    for (const auto& entry : trace.entries)
+    {
+        if (entry.parentId == 0)
+        {
+            ++statistics.rootInvocationCount;
+        }
+        else if (entry.parentId > entryCount)
+        {
+            ++statistics.orphanInvocationCount;
+        }
+        else
+        {
+            ++childCounts[entry.parentId - 1];
+        }
+
+        const uint32_t depth = entry.flags & IVY_LINEAGE_DEPTH_MASK;
+
+        statistics.maxDepth = std::max(statistics.maxDepth, depth);
+        ++statistics.invocationsPerDepth[depth];
+
+        if (entry.flags & IVY_LINEAGE_HAS_BRANCH)
+        {
+            ++statistics.forkCount;
+        }
+    }
+
+    uint32_t parentCount = 0;
+    uint32_t childCount  = 0;
+
+    for (const uint32_t count : childCounts)
+    {
+        if (count == 0)
+        {
+            ++statistics.leafInvocationCount;
+        }
+        else
+        {
+            ++parentCount;
+            childCount += count;
+        }
+    }
+
+    statistics.branchingFactor = (parentCount > 0) ? static_cast<float>(childCount) / parentCount : 0.f;
+
+    // Children are always appended after their parent, thus visiting entries in reverse order visits all children before their parent.
+    // futureHit tracks whether an invocation or any of its descendants hits a surface.
+    std::vector<bool> futureHit(entryCount, false);
+
+    for (uint32_t i = entryCount; i-- > 0;)
+    {
+        const auto& entry = trace.entries[i];
+
+        bool hit = futureHit[i];
+
+        for (int iteration = IVY_LINEAGE_MAX_ITERATIONS - 1; iteration >= 0; --iteration)
+        {
+            const uint32_t outcome = (entry.flags >> (IVY_LINEAGE_OUTCOME_SHIFT + 2 * iteration)) & IVY_LINEAGE_OUTCOME_MASK;
+
+            ++statistics.iterationOutcomes[outcome];
+
+            if (outcome != IVY_LINEAGE_OUTCOME_FREE_FALL)
+            {
+                hit = true;
+            }
+            else if (!hit)
+            {
+                ++statistics.wastedIterationCount;
+            }
+        }
+
+        futureHit[i] = hit;
+
+        if (hit && (entry.parentId > 0) && (entry.parentId <= entryCount))
+        {
+            futureHit[entry.parentId - 1] = true;
+        }
+    }
+
+    return statistics;
+}
@@ -0,0 +1,74 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "shaders/ivycommon.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Lineage trace captured from the IvyBranch node, see IVY_FLAG_LINEAGE_TRACE
+struct LineageTrace
+{
+    std::vector<IvyLineageTraceEntry> entries;
+    // Number of entries which exceeded the trace capacity
+    uint32_t droppedEntryCount = 0;
+};
+
+// Statistics of the growth tree rebuilt from a lineage trace
+struct LineageTraceStatistics
+{
+    uint32_t invocationCount = 0;
+    // Invocations seeded by an entry record or an ivy area
+    uint32_t rootInvocationCount = 0;
+    // Invocations whose parent is missing from the trace
+    uint32_t orphanInvocationCount = 0;
+    // Invocations without children
+    uint32_t leafInvocationCount = 0;
+    uint32_t forkCount           = 0;
+    uint32_t maxDepth            = 0;
+    // Average number of children of invocations with at least one child
+    float    branchingFactor     = 0.f;
+
+    // Number of iterations per IVY_LINEAGE_OUTCOME_*
+    std::array<uint32_t, 4> iterationOutcomes = {};
+    // Free fall iterations after which neither the branch nor any of its descendants hit a surface again
+    uint32_t                wastedIterationCount = 0;
+
+    std::array<uint32_t, IVY_LINEAGE_DEPTH_MASK + 1> invocationsPerDepth = {};
+};
+
+/**
+ * @brief   Writes a lineage trace to a binary file: "IVYL" magic, version, entry count, dropped entry count, entries.
+ */
+bool WriteLineageTrace(const std::string& fileName, const LineageTrace& trace);
+/**
+ * @brief   Reads a lineage trace written by WriteLineageTrace.
+ */
+bool ReadLineageTrace(const std::string& fileName, LineageTrace& trace);
+
+/**
+ * @brief   Rebuilds the growth tree from a lineage trace and computes its statistics.
+ */
+LineageTraceStatistics ReplayLineageTrace(const LineageTrace& trace);
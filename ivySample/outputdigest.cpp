@@ -0,0 +1,138 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "outputdigest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+static const char* OutputDigestFileHeader = "IvyOutputDigests 1";
+
+// 64-bit hash finalizer of splitmix64, same as Hash64 in utils.hlsl
+static uint64_t Hash64(uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+// Same as Hash64(float3x4, uint) in utils.hlsl
+uint64_t GetOutputDigest(const float transform[3][4], uint32_t outputType)
+{
+    uint64_t digest = outputType;
+
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int column = 0; column < 4; ++column)
+        {
+            uint32_t bits;
+            memcpy(&bits, &transform[row][column], sizeof(bits));
+
+            digest = Hash64(digest ^ bits);
+        }
+    }
+
+    return digest;
+}
+
+uint64_t CombineOutputDigests(const std::vector<uint64_t>& rootDigests)
+{
+    uint64_t digest = rootDigests.size();
+
+    for (const uint64_t rootDigest : rootDigests)
+    {
+        digest = Hash64(digest ^ rootDigest);
+    }
+
+    return digest;
+}
+
+bool WriteOutputDigests(const std::string& fileName, const std::vector<uint64_t>& rootDigests)
+{
+    std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+
+    if (!file)
+    {
+        return false;
+    }
+
+    file << OutputDigestFileHeader << "\n";
+    file << std::hex << CombineOutputDigests(rootDigests) << "\n";
+    file << std::dec << rootDigests.size() << "\n";
+
+    for (const uint64_t rootDigest : rootDigests)
+    {
+        file << std::hex << rootDigest << "\n";
+    }
+
+    return file.good();
+}
+
+bool ReadOutputDigests(const std::string& fileName, std::vector<uint64_t>& rootDigests)
+{
+    std::ifstream file(fileName, std::ios::in);
+
+    std::string header;
+    std::getline(file, header);
+
+    uint64_t frameDigest = 0;
+    size_t   rootCount   = 0;
+    file >> std::hex >> frameDigest >> std::dec >> rootCount;
+
+    if (!file || (header != OutputDigestFileHeader))
+    {
+        return false;
+    }
+
+    std::vector<uint64_t> digests(rootCount);
+
+    for (auto& digest : digests)
+    {
+        file >> std::hex >> digest;
+    }
+
+    if (!file || (CombineOutputDigests(digests) != frameDigest))
+    {
+        return false;
+    }
+
+    rootDigests = std::move(digests);
+
+    return true;
+}
+
+std::vector<uint32_t> CompareOutputDigests(const std::vector<uint64_t>& rootDigests, const std::vector<uint64_t>& goldenRootDigests)
+{
+    std::vector<uint32_t> mismatches;
+
+    const size_t rootCount = std::max(rootDigests.size(), goldenRootDigests.size());
+
+    for (size_t i = 0; i < rootCount; ++i)
+    {
+        if ((i >= rootDigests.size()) || (i >= goldenRootDigests.size()) || (rootDigests[i] != goldenRootDigests[i]))
+        {
+            mismatches.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    return mismatches;
+}
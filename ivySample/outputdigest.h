@@ -0,0 +1,53 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief   Returns the digest of a generated stem or leaf transform, same as GetOutputDigest in common.hlsl.
+ *          transform holds the rows of the float3x4 transform, outputType is IVY_OUTPUT_DIGEST_STEM or IVY_OUTPUT_DIGEST_LEAF.
+ *          The digest of a root is the wrapping sum of the digests of all its stem & leaf transforms.
+ */
+uint64_t GetOutputDigest(const float transform[3][4], uint32_t outputType);
+
+/**
+ * @brief   Combines per-root output digests, in root order, into a single digest of the whole frame.
+ */
+uint64_t CombineOutputDigests(const std::vector<uint64_t>& rootDigests);
+
+/**
+ * @brief   Writes per-root output digests to a text file: header, frame digest, root count and one hexadecimal digest per root.
+ */
+bool WriteOutputDigests(const std::string& fileName, const std::vector<uint64_t>& rootDigests);
+/**
+ * @brief   Reads per-root output digests written by WriteOutputDigests. Fails if the stored frame digest doesn't match the root digests.
+ */
+bool ReadOutputDigests(const std::string& fileName, std::vector<uint64_t>& rootDigests);
+
+/**
+ * @brief   Returns the indices of all roots whose digest differs from the golden digest.
+ *          Roots which only exist in one of both sets are reported as mismatches.
+ */
+std::vector<uint32_t> CompareOutputDigests(const std::vector<uint64_t>& rootDigests, const std::vector<uint64_t>& goldenRootDigests);
@@ -0,0 +1,115 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "poissondisk.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+std::vector<PoissonDiskPoint> GeneratePoissonDiskPoints(uint32_t pointCount, uint32_t candidateCount, uint32_t seed)
+{
+    std::vector<PoissonDiskPoint> points;
+    points.reserve(pointCount);
+
+    std::mt19937                          generator(seed);
+    std::uniform_real_distribution<float> distribution(0.f, 1.f);
+
+    // Uniform grid over the unit torus for nearest neighbor queries. Each cell contains about one point.
+    const int   gridSize = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(pointCount)))));
+    const float cellSize = 1.f / gridSize;
+
+    std::vector<std::vector<uint32_t>> grid(gridSize * gridSize);
+
+    const auto GetCell = [&](float coordinate) { return std::min(static_cast<int>(coordinate * gridSize), gridSize - 1); };
+
+    // Squared toroidal distance to the closest point in the set
+    const auto GetClosestPointDistance = [&](const PoissonDiskPoint& candidate) {
+        const int candidateCellX = GetCell(candidate.x);
+        const int candidateCellY = GetCell(candidate.y);
+
+        float closestDistance = std::numeric_limits<float>::max();
+
+        // Search rings of cells around the candidate, until no closer point can be found in the next ring
+        for (int ring = 0; ring <= gridSize / 2; ++ring)
+        {
+            for (int y = -ring; y <= ring; ++y)
+            {
+                for (int x = -ring; x <= ring; ++x)
+                {
+                    // only visit cells on the border of the ring
+                    if ((std::abs(x) != ring) && (std::abs(y) != ring))
+                    {
+                        continue;
+                    }
+
+                    const int cellX = (candidateCellX + x + gridSize) % gridSize;
+                    const int cellY = (candidateCellY + y + gridSize) % gridSize;
+
+                    for (const uint32_t pointIndex : grid[cellY * gridSize + cellX])
+                    {
+                        float dx = std::abs(points[pointIndex].x - candidate.x);
+                        float dy = std::abs(points[pointIndex].y - candidate.y);
+                        // wrap around torus
+                        dx = std::min(dx, 1.f - dx);
+                        dy = std::min(dy, 1.f - dy);
+
+                        closestDistance = std::min(closestDistance, dx * dx + dy * dy);
+                    }
+                }
+            }
+
+            // points in the next ring are at least ring * cellSize away
+            const float ringDistance = ring * cellSize;
+            if (closestDistance <= ringDistance * ringDistance)
+            {
+                break;
+            }
+        }
+
+        return closestDistance;
+    };
+
+    for (uint32_t pointIndex = 0; pointIndex < pointCount; ++pointIndex)
+    {
+        PoissonDiskPoint bestCandidate         = {distribution(generator), distribution(generator)};
+        float            bestCandidateDistance = GetClosestPointDistance(bestCandidate);
+
+        // first point has no neighbors, thus any candidate is as good as the first one
+        for (uint32_t candidateIndex = 1; (candidateIndex < candidateCount) && !points.empty(); ++candidateIndex)
+        {
+            const PoissonDiskPoint candidate         = {distribution(generator), distribution(generator)};
+            const float            candidateDistance = GetClosestPointDistance(candidate);
+
+            if (candidateDistance > bestCandidateDistance)
+            {
+                bestCandidate         = candidate;
+                bestCandidateDistance = candidateDistance;
+            }
+        }
+
+        grid[GetCell(bestCandidate.y) * gridSize + GetCell(bestCandidate.x)].push_back(pointIndex);
+        points.push_back(bestCandidate);
+    }
+
+    return points;
+}
@@ -0,0 +1,131 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "proxygeometry.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    // 21 bits per axis are sufficient for any scene at the cell sizes used for proxy geometry
+    uint64_t GetClusterKey(const float* vertex, float cellSize)
+    {
+        uint64_t key = 0;
+
+        for (int c = 0; c < 3; ++c)
+        {
+            const int64_t cell = static_cast<int64_t>(std::floor(vertex[c] / cellSize));
+
+            key |= (static_cast<uint64_t>(cell) & 0x1FFFFF) << (21 * c);
+        }
+
+        return key;
+    }
+
+    struct Cluster
+    {
+        uint32_t index       = 0;
+        uint32_t vertexCount = 0;
+        float    sum[3]      = {};
+    };
+
+    struct ClusterTriangleHash
+    {
+        size_t operator()(const std::array<uint32_t, 3>& triangle) const
+        {
+            return std::hash<uint64_t>()((static_cast<uint64_t>(triangle[0]) << 42) ^ (static_cast<uint64_t>(triangle[1]) << 21) ^ triangle[2]);
+        }
+    };
+}  // namespace
+
+std::vector<float> DecimateTriangles(const std::vector<float>& triangleVertices, float tolerance)
+{
+    const float  cellSize    = tolerance / std::sqrt(3.f);
+    const size_t vertexCount = triangleVertices.size() / 3;
+
+    // Assign each vertex to its cluster & accumulate cluster means
+    std::unordered_map<uint64_t, Cluster> clusters;
+    std::vector<uint32_t>                 vertexClusters(vertexCount);
+
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        const float* vertex  = &triangleVertices[i * 3];
+        auto         result  = clusters.try_emplace(GetClusterKey(vertex, cellSize));
+        Cluster&     cluster = result.first->second;
+
+        if (result.second)
+        {
+            cluster.index = static_cast<uint32_t>(clusters.size() - 1);
+        }
+
+        ++cluster.vertexCount;
+        for (int c = 0; c < 3; ++c)
+        {
+            cluster.sum[c] += vertex[c];
+        }
+
+        vertexClusters[i] = cluster.index;
+    }
+
+    std::vector<float> clusterPositions(clusters.size() * 3);
+
+    for (const auto& entry : clusters)
+    {
+        const Cluster& cluster = entry.second;
+
+        for (int c = 0; c < 3; ++c)
+        {
+            clusterPositions[cluster.index * 3 + c] = cluster.sum[c] / cluster.vertexCount;
+        }
+    }
+
+    // Emit remaining triangles; rotating the smallest cluster index first keeps the winding of duplicates comparable
+    std::unordered_set<std::array<uint32_t, 3>, ClusterTriangleHash> emittedTriangles;
+    std::vector<float>                                               decimatedVertices;
+
+    for (size_t i = 0; i + 2 < vertexCount; i += 3)
+    {
+        std::array<uint32_t, 3> triangle = {vertexClusters[i], vertexClusters[i + 1], vertexClusters[i + 2]};
+
+        if ((triangle[0] == triangle[1]) || (triangle[1] == triangle[2]) || (triangle[2] == triangle[0]))
+        {
+            continue;
+        }
+
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+
+        if (!emittedTriangles.insert(triangle).second)
+        {
+            continue;
+        }
+
+        for (const uint32_t clusterIndex : triangle)
+        {
+            decimatedVertices.insert(decimatedVertices.end(), &clusterPositions[clusterIndex * 3], &clusterPositions[clusterIndex * 3] + 3);
+        }
+    }
+
+    return decimatedVertices;
+}
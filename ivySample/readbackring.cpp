@@ -0,0 +1,174 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "readbackring.h"
+
+#include "misc/assert.h"
+#include "render/device.h"
+
+#include "render/dx12/commandlist_dx12.h"
+#include "render/dx12/device_dx12.h"
+#include "render/dx12/gpuresource_dx12.h"
+
+#include "d3dx12/d3dx12.h"
+
+#include <cstring>
+
+using namespace cauldron;
+
+ReadbackRing::ReadbackRing(size_t sizeInBytes, uint64_t frameLatency)
+    : m_SizeInBytes(sizeInBytes)
+    , m_FrameLatency(frameLatency)
+{
+    CreateEntries();
+}
+
+ReadbackRing::~ReadbackRing()
+{
+    for (auto& entry : m_Entries)
+    {
+        if (entry.pResource)
+            entry.pResource->Release();
+    }
+
+    for (auto& retiredResource : m_RetiredResources)
+    {
+        retiredResource.second->Release();
+    }
+}
+
+void ReadbackRing::CreateEntries()
+{
+    // One more buffer than frames in flight, such that a copy can be recorded every frame
+    m_Entries.clear();
+    m_Entries.resize(m_FrameLatency + 1);
+
+    const CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_READBACK);
+    const CD3DX12_RESOURCE_DESC   resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(m_SizeInBytes);
+
+    for (auto& entry : m_Entries)
+    {
+        CauldronThrowOnFail(GetDevice()->GetImpl()->DX12Device()->CreateCommittedResource(
+            &heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&entry.pResource)));
+        entry.pResource->SetName(L"IvySample_ReadbackRing");
+    }
+}
+
+void ReadbackRing::ReleaseRetiredResources(uint64_t frameIndex)
+{
+    auto it = m_RetiredResources.begin();
+    while (it != m_RetiredResources.end())
+    {
+        if (frameIndex >= it->first + m_FrameLatency)
+        {
+            it->second->Release();
+            it = m_RetiredResources.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void ReadbackRing::Resize(size_t sizeInBytes, uint64_t frameIndex)
+{
+    // Buffers might still be written by frames in flight
+    for (auto& entry : m_Entries)
+    {
+        m_RetiredResources.emplace_back(frameIndex, entry.pResource);
+    }
+
+    m_SizeInBytes = sizeInBytes;
+    CreateEntries();
+}
+
+bool ReadbackRing::Copy(CommandList* pCmdList, const GPUResource* pSource, uint64_t sourceOffset, uint64_t frameIndex)
+{
+    ReleaseRetiredResources(frameIndex);
+
+    for (auto& entry : m_Entries)
+    {
+        if (entry.pending)
+        {
+            continue;
+        }
+
+        pCmdList->GetImpl()->DX12CmdList()->CopyBufferRegion(entry.pResource, 0, pSource->GetImpl()->DX12Resource(), sourceOffset, m_SizeInBytes);
+
+        entry.frameIndex = frameIndex;
+        entry.pending    = true;
+
+        return true;
+    }
+
+    return false;
+}
+
+bool ReadbackRing::Read(uint64_t frameIndex, void* pData, uint64_t* pSourceFrameIndex)
+{
+    Entry* pLatestEntry = nullptr;
+
+    // Find latest completed copy & discard all older ones
+    for (auto& entry : m_Entries)
+    {
+        if (!entry.pending || (frameIndex < entry.frameIndex + m_FrameLatency))
+        {
+            continue;
+        }
+
+        if (pLatestEntry && (pLatestEntry->frameIndex > entry.frameIndex))
+        {
+            entry.pending = false;
+            continue;
+        }
+
+        if (pLatestEntry)
+        {
+            pLatestEntry->pending = false;
+        }
+
+        pLatestEntry = &entry;
+    }
+
+    if (pLatestEntry == nullptr)
+    {
+        return false;
+    }
+
+    const D3D12_RANGE readRange = {0, m_SizeInBytes};
+    void*             pMapped   = nullptr;
+    CauldronThrowOnFail(pLatestEntry->pResource->Map(0, &readRange, &pMapped));
+
+    memcpy(pData, pMapped, m_SizeInBytes);
+
+    const D3D12_RANGE writeRange = {0, 0};
+    pLatestEntry->pResource->Unmap(0, &writeRange);
+
+    if (pSourceFrameIndex)
+    {
+        *pSourceFrameIndex = pLatestEntry->frameIndex;
+    }
+
+    pLatestEntry->pending = false;
+
+    return true;
+}
@@ -0,0 +1,82 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+struct ID3D12Resource;
+
+namespace cauldron
+{
+    class CommandList;
+    class GPUResource;
+}  // namespace cauldron
+
+/**
+ * @brief   Ring of readback buffers for reading GPU data on the CPU without stalling.
+ *          Copies are recorded into a free buffer and read once the frame which recorded them is no longer in flight.
+ */
+class ReadbackRing
+{
+public:
+    ReadbackRing(size_t sizeInBytes, uint64_t frameLatency);
+    ~ReadbackRing();
+
+    /**
+     * @brief   Records a copy of sizeInBytes from pSource, which has to be in CopySource state, into a free readback buffer.
+     *          Returns false if all readback buffers are in flight.
+     */
+    bool Copy(cauldron::CommandList* pCmdList, const cauldron::GPUResource* pSource, uint64_t sourceOffset, uint64_t frameIndex);
+
+    /**
+     * @brief   Copies the latest completed readback to pData. Returns false if no new readback has completed.
+     *          pSourceFrameIndex receives the index of the frame which recorded the copy.
+     */
+    bool Read(uint64_t frameIndex, void* pData, uint64_t* pSourceFrameIndex = nullptr);
+
+    /**
+     * @brief   Changes the size of all readback buffers and discards pending readbacks.
+     *          Previous buffers are released once the current frame is no longer in flight.
+     */
+    void Resize(size_t sizeInBytes, uint64_t frameIndex);
+
+    size_t GetSize() const { return m_SizeInBytes; }
+
+private:
+    void CreateEntries();
+    void ReleaseRetiredResources(uint64_t frameIndex);
+
+    struct Entry
+    {
+        ID3D12Resource* pResource  = nullptr;
+        uint64_t        frameIndex = 0;
+        bool            pending    = false;
+    };
+
+    size_t             m_SizeInBytes  = 0;
+    uint64_t           m_FrameLatency = 0;
+    std::vector<Entry> m_Entries;
+
+    std::vector<std::pair<uint64_t, ID3D12Resource*>> m_RetiredResources;
+};
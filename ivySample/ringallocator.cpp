@@ -0,0 +1,64 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ringallocator.h"
+
+#include <cassert>
+
+RingAllocator::RingAllocator(size_t sizeInBytes)
+    : m_SizeInBytes(sizeInBytes)
+{
+}
+
+bool RingAllocator::Allocate(size_t sizeInBytes, size_t& offset, size_t& usedBytes)
+{
+    assert(sizeInBytes <= GetMaxAllocationSize());
+
+    // Remaining bytes at the end of the ring are skipped if the allocation doesn't fit in front of them
+    const bool   wraps   = (m_Head + sizeInBytes) > m_SizeInBytes;
+    const size_t padding = wraps ? (m_SizeInBytes - m_Head) : 0;
+
+    if ((m_UsedBytes + padding + sizeInBytes) > m_SizeInBytes)
+    {
+        return false;
+    }
+
+    offset    = wraps ? 0 : m_Head;
+    usedBytes = padding + sizeInBytes;
+
+    m_Head       = offset + sizeInBytes;
+    m_UsedBytes += usedBytes;
+
+    return true;
+}
+
+void RingAllocator::Free(size_t usedBytes)
+{
+    assert(usedBytes <= m_UsedBytes);
+
+    m_UsedBytes -= usedBytes;
+
+    // A drained ring starts over at its beginning, thus any allocation up to the maximum size fits again
+    if (m_UsedBytes == 0)
+    {
+        m_Head = 0;
+    }
+}
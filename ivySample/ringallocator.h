@@ -0,0 +1,57 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+
+// Allocates consecutive byte ranges of a ring buffer, which are freed in allocation order once the GPU is done reading them.
+// Allocations never wrap around the end of the ring; the bytes skipped at the end are accounted to the wrapping allocation.
+class RingAllocator
+{
+public:
+    RingAllocator(size_t sizeInBytes);
+
+    /**
+     * @brief   Returns the size of the largest allocation. Limited to half the ring, such that one half can be filled
+     *          while copies from the other half are still in flight.
+     */
+    size_t GetMaxAllocationSize() const { return m_SizeInBytes / 2; }
+
+    /**
+     * @brief   Allocates sizeInBytes at offset & returns true, or returns false if not enough bytes are free.
+     *          usedBytes receives the bytes taken from the ring including skipped bytes, which are to be passed to Free.
+     */
+    bool Allocate(size_t sizeInBytes, size_t& offset, size_t& usedBytes);
+
+    /**
+     * @brief   Frees the oldest allocation, given the usedBytes returned by Allocate. Allocations may be freed in batches.
+     */
+    void Free(size_t usedBytes);
+
+    size_t GetUsedBytes() const { return m_UsedBytes; }
+
+private:
+    size_t m_SizeInBytes = 0;
+    // Next free byte & number of allocated bytes
+    size_t m_Head        = 0;
+    size_t m_UsedBytes   = 0;
+};
@@ -80,7 +80,7 @@ ShaderCompiler::~ShaderCompiler()
     SafeRelease(m_pUtils);
 }
 
-IDxcBlob* ShaderCompiler::CompileShader(const wchar_t* shaderFilePath, const wchar_t* target, const wchar_t* entryPoint)
+IDxcBlob* ShaderCompiler::CompileShader(const wchar_t* shaderFilePath, const wchar_t* target, const wchar_t* entryPoint, const std::vector<DxcDefine>& defines)
 {
     IDxcBlobEncoding* source = nullptr;
 
@@ -106,8 +106,16 @@ IDxcBlob* ShaderCompiler::CompileShader(const wchar_t* shaderFilePath, const wch
     };
 
     IDxcOperationResult* result = nullptr;
-    const auto           hr     = m_pCompiler->Compile(
-        source, shaderFilePath, entryPoint, target, arguments.data(), static_cast<UINT32>(arguments.size()), nullptr, 0, m_pIncludeHandler, &result);
+    const auto           hr     = m_pCompiler->Compile(source,
+                                               shaderFilePath,
+                                               entryPoint,
+                                               target,
+                                               arguments.data(),
+                                               static_cast<UINT32>(arguments.size()),
+                                               defines.data(),
+                                               static_cast<UINT32>(defines.size()),
+                                               m_pIncludeHandler,
+                                               &result);
 
     // release source blob
     SafeRelease(source);
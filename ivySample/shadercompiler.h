@@ -30,13 +30,15 @@
 // DXC header
 #include <dxcapi.h>
 
+#include <vector>
+
 class ShaderCompiler
 {
 public:
     ShaderCompiler();
     ~ShaderCompiler();
 
-    IDxcBlob* CompileShader(const wchar_t* shaderFilePath, const wchar_t* target, const wchar_t* entryPoint);
+    IDxcBlob* CompileShader(const wchar_t* shaderFilePath, const wchar_t* target, const wchar_t* entryPoint, const std::vector<DxcDefine>& defines = {});
 
 private:
     IDxcUtils*          m_pUtils          = nullptr;
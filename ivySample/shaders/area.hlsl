@@ -20,7 +20,15 @@
 // THE SOFTWARE.
 
 #include "common.hlsl"
-#include "raytracing.hlsl"
+#include "distancefield.hlsl"
+
+struct IvyAreaTileRecord
+{
+    float4x4 transform;
+    uint     seed;
+    uint     sampleCount;
+    uint     rootIndex;
+};
 
 struct IvyAreaSampleRecord
 {
@@ -28,16 +36,66 @@ struct IvyAreaSampleRecord
     float4x4 transform;
     uint     seed;
     uint     sampleCount;
+    uint     rootIndex;
+};
+
+struct IvyAreaSurfaceTileRecord
+{
+    uint seed;
+    uint sampleCount;
+    uint triangleOffset;
+    uint triangleCount;
+    uint rootIndex;
+};
+
+struct IvyAreaSurfaceSampleRecord
+{
+    uint dispatchSize : SV_DispatchGrid;
+    uint seed;
+    uint sampleCount;
+    uint triangleOffset;
+    uint triangleCount;
+    uint rootIndex;
 };
 
 static const uint ivyAreaSampleThreadGroupSize = 32;
 static const uint ivyAreaSampleMaxThreadGroups = 128;
+static const uint ivyAreaSampleMaxSamples      = ivyAreaSampleThreadGroupSize * ivyAreaSampleMaxThreadGroups;
+
+static const uint ivyAreaSurfaceSampleMaxThreadGroups = 1024;
+static const uint ivyAreaSurfaceSampleMaxSamples      = ivyAreaSampleThreadGroupSize * ivyAreaSurfaceSampleMaxThreadGroups;
+
+// Each subdivision level splits a tile into up to 4 tiles,
+// i.e. a single area can generate up to 4^ivyAreaMaxSubdivisionLevels * ivyAreaSampleMaxSamples samples
+static const uint ivyAreaMaxSubdivisionLevels = 8;
+
+// Surface samples are split into 4 ranges per level, i.e. up to 4^ivyAreaMaxSurfaceSubdivisionLevels * ivyAreaSurfaceSampleMaxSamples samples
+static const uint ivyAreaMaxSurfaceSubdivisionLevels = 4;
+
+StructuredBuffer<float2>                  g_area_poisson_disk_points : DECLARE_SRV(AREA_POISSON_DISK_POINTS);
+StructuredBuffer<SurfaceSamplingTriangle> g_area_surface_triangles : DECLARE_SRV(AREA_SURFACE_SAMPLING_TRIANGLES);
 
 uint DivideAndRoundUp(uint dividend, uint divisor)
 {
     return (dividend + divisor - 1) / divisor;
 }
 
+// Returns sample position on top surface of area bounding box in [-1; 1]
+float2 GetAreaSamplePosition(in uint seed, in uint sampleIndex)
+{
+    if (IvyFlags & IVY_FLAG_POISSON_AREA_SAMPLING)
+    {
+        // Point set is tileable, thus a random offset per tile yields a different, but equally well distributed point set.
+        // Every prefix of the point set is well distributed, thus any sample count can be used.
+        const float2 tileOffset = float2(Random(seed, 7365), Random(seed, 1982));
+        const float2 diskPoint  = g_area_poisson_disk_points[sampleIndex % AREA_POISSON_DISK_POINT_COUNT];
+
+        return frac(diskPoint + tileOffset) * 2.0 - 1.0;
+    }
+
+    return float2(Random(seed, sampleIndex, 3732), Random(seed, sampleIndex, 4561)) * 2.0 - 1.0;
+}
+
 [Shader("node")]
 [NodeIsProgramEntry]
 [NodeLaunch("thread")]
@@ -45,28 +103,178 @@ void IvyArea(
     ThreadNodeInputRecord<IvyAreaRecord> inputRecord,
 
     [MaxRecords(1)]
-    [NodeId("IvyAreaSample")]
-    NodeOutput<IvyAreaSampleRecord> sampleOutput
+    [NodeId("IvyAreaSubdivide")]
+    NodeOutput<IvyAreaTileRecord> tileOutput,
+
+    [MaxRecords(1)]
+    [NodeId("IvyAreaSurfaceSubdivide")]
+    NodeOutput<IvyAreaSurfaceTileRecord> surfaceTileOutput
 )
 {
     const IvyAreaRecord record = inputRecord.Get();
 
+    const bool surfaceSampling = record.surfaceTriangleCount > 0;
+
     // record.transform defines a bounding box in [-1; 1]
     // Here we compute the area of the top surface of the bounding box
     const float xScale = length(mul((float3x3)record.transform, float3(1, 0, 0))) * 2;
     const float zScale = length(mul((float3x3)record.transform, float3(0, 0, 1))) * 2;
 
-    const float sampleArea  = xScale * zScale;
+    // Surface sampling distributes samples over the area of all triangles inside the bounding box
+    const float sampleArea  = surfaceSampling ? record.surfaceArea : xScale * zScale;
     const uint  sampleCount = sampleArea * record.density;
 
-    ThreadNodeOutputRecords<IvyAreaSampleRecord> outputRecord = sampleOutput.GetThreadNodeOutputRecords(1);
+    ThreadNodeOutputRecords<IvyAreaTileRecord> outputRecord = tileOutput.GetThreadNodeOutputRecords(!surfaceSampling);
 
-    outputRecord.Get().dispatchSize = min(DivideAndRoundUp(sampleCount, ivyAreaSampleThreadGroupSize), ivyAreaSampleMaxThreadGroups);
-    outputRecord.Get().transform    = record.transform;
-    outputRecord.Get().seed         = record.seed;
-    outputRecord.Get().sampleCount  = sampleCount;
+    if (!surfaceSampling)
+    {
+        outputRecord.Get().transform   = record.transform;
+        outputRecord.Get().seed        = record.seed;
+        outputRecord.Get().sampleCount = sampleCount;
+        outputRecord.Get().rootIndex   = record.rootIndex;
+    }
 
     outputRecord.OutputComplete();
+
+    ThreadNodeOutputRecords<IvyAreaSurfaceTileRecord> surfaceOutputRecord = surfaceTileOutput.GetThreadNodeOutputRecords(surfaceSampling);
+
+    if (surfaceSampling)
+    {
+        surfaceOutputRecord.Get().seed           = record.seed;
+        surfaceOutputRecord.Get().sampleCount    = sampleCount;
+        surfaceOutputRecord.Get().triangleOffset = record.surfaceTriangleOffset;
+        surfaceOutputRecord.Get().triangleCount  = record.surfaceTriangleCount;
+        surfaceOutputRecord.Get().rootIndex      = record.rootIndex;
+    }
+
+    surfaceOutputRecord.OutputComplete();
+}
+
+[Shader("node")]
+[NodeLaunch("thread")]
+[NodeMaxRecursionDepth(ivyAreaMaxSurfaceSubdivisionLevels)]
+void IvyAreaSurfaceSubdivide(
+    ThreadNodeInputRecord<IvyAreaSurfaceTileRecord> inputRecord,
+
+    [MaxRecords(4)]
+    [NodeId("IvyAreaSurfaceSubdivide")]
+    NodeOutput<IvyAreaSurfaceTileRecord> surfaceTileOutput,
+
+    [MaxRecords(1)]
+    [NodeId("IvyAreaSurfaceSample")]
+    NodeOutput<IvyAreaSurfaceSampleRecord> surfaceSampleOutput
+)
+{
+    const IvyAreaSurfaceTileRecord record = inputRecord.Get();
+
+    // Sample ranges which fit into a single broadcasting dispatch are sampled directly.
+    // If the recursion limit is reached, the sample count is clamped.
+    const bool sample    = (record.sampleCount <= ivyAreaSurfaceSampleMaxSamples) || (GetRemainingRecursionLevels() == 0);
+    const uint tileCount = sample ? 0 : 4;
+
+    // Samples are drawn from the alias table of all triangles, thus ranges only differ in their seed
+    ThreadNodeOutputRecords<IvyAreaSurfaceTileRecord> tileOutputRecords = surfaceTileOutput.GetThreadNodeOutputRecords(tileCount);
+
+    for (uint tile = 0; tile < tileCount; ++tile)
+    {
+        tileOutputRecords.Get(tile).seed = CombineSeed(record.seed, tile);
+        // distribute samples evenly, such that the total sample count is preserved
+        tileOutputRecords.Get(tile).sampleCount    = (record.sampleCount / tileCount) + (tile < (record.sampleCount % tileCount));
+        tileOutputRecords.Get(tile).triangleOffset = record.triangleOffset;
+        tileOutputRecords.Get(tile).triangleCount  = record.triangleCount;
+        tileOutputRecords.Get(tile).rootIndex      = record.rootIndex;
+    }
+
+    tileOutputRecords.OutputComplete();
+
+    ThreadNodeOutputRecords<IvyAreaSurfaceSampleRecord> sampleOutputRecord = surfaceSampleOutput.GetThreadNodeOutputRecords(sample);
+
+    if (sample)
+    {
+        const uint sampleCount = min(record.sampleCount, ivyAreaSurfaceSampleMaxSamples);
+
+        AddWaveStatistic(IVY_STATISTIC_CLAMPED_AREA_SAMPLES, record.sampleCount - sampleCount);
+
+        sampleOutputRecord.Get().dispatchSize   = DivideAndRoundUp(sampleCount, ivyAreaSampleThreadGroupSize);
+        sampleOutputRecord.Get().seed           = record.seed;
+        sampleOutputRecord.Get().sampleCount    = sampleCount;
+        sampleOutputRecord.Get().triangleOffset = record.triangleOffset;
+        sampleOutputRecord.Get().triangleCount  = record.triangleCount;
+        sampleOutputRecord.Get().rootIndex      = record.rootIndex;
+    }
+
+    sampleOutputRecord.OutputComplete();
+}
+
+[Shader("node")]
+[NodeLaunch("thread")]
+[NodeMaxRecursionDepth(ivyAreaMaxSubdivisionLevels)]
+void IvyAreaSubdivide(
+    ThreadNodeInputRecord<IvyAreaTileRecord> inputRecord,
+
+    [MaxRecords(4)]
+    [NodeId("IvyAreaSubdivide")]
+    NodeOutput<IvyAreaTileRecord> tileOutput,
+
+    [MaxRecords(1)]
+    [NodeId("IvyAreaSample")]
+    NodeOutput<IvyAreaSampleRecord> sampleOutput
+)
+{
+    const IvyAreaTileRecord record = inputRecord.Get();
+
+    // Tiles which fit into a single broadcasting dispatch are sampled directly.
+    // If the recursion limit is reached, the sample count is clamped.
+    const bool sample = (record.sampleCount <= ivyAreaSampleMaxSamples) || (GetRemainingRecursionLevels() == 0);
+
+    // Split tile along both axes, unless one side is much shorter than the other.
+    // This keeps tiles close to square, such that samples remain evenly distributed.
+    const float xScale = length(mul((float3x3)record.transform, float3(1, 0, 0)));
+    const float zScale = length(mul((float3x3)record.transform, float3(0, 0, 1)));
+
+    const uint xTiles    = (xScale * 2.f >= zScale) ? 2 : 1;
+    const uint zTiles    = (zScale * 2.f >= xScale) ? 2 : 1;
+    const uint tileCount = sample ? 0 : xTiles * zTiles;
+
+    ThreadNodeOutputRecords<IvyAreaTileRecord> tileOutputRecords = tileOutput.GetThreadNodeOutputRecords(tileCount);
+
+    for (uint tile = 0; tile < tileCount; ++tile)
+    {
+        const uint  xTile = tile % xTiles;
+        const uint  zTile = tile / xTiles;
+        // tile center in [-1; 1] space of parent tile
+        const float xOffset = (xTiles == 1) ? 0.f : (xTile * 2.f - 1.f) * 0.5f;
+        const float zOffset = (zTiles == 1) ? 0.f : (zTile * 2.f - 1.f) * 0.5f;
+
+        tileOutputRecords.Get(tile).transform = mmul(
+            record.transform,
+            Translate(xOffset, 0, zOffset),
+            Scale(1.f / xTiles, 1.f, 1.f / zTiles)
+        );
+        tileOutputRecords.Get(tile).seed = CombineSeed(record.seed, tile);
+        // distribute samples evenly, such that the total sample count is preserved
+        tileOutputRecords.Get(tile).sampleCount = (record.sampleCount / tileCount) + (tile < (record.sampleCount % tileCount));
+        tileOutputRecords.Get(tile).rootIndex   = record.rootIndex;
+    }
+
+    tileOutputRecords.OutputComplete();
+
+    ThreadNodeOutputRecords<IvyAreaSampleRecord> sampleOutputRecord = sampleOutput.GetThreadNodeOutputRecords(sample);
+
+    if (sample)
+    {
+        const uint sampleCount = min(record.sampleCount, ivyAreaSampleMaxSamples);
+
+        AddWaveStatistic(IVY_STATISTIC_CLAMPED_AREA_SAMPLES, record.sampleCount - sampleCount);
+
+        sampleOutputRecord.Get().dispatchSize = DivideAndRoundUp(sampleCount, ivyAreaSampleThreadGroupSize);
+        sampleOutputRecord.Get().transform    = record.transform;
+        sampleOutputRecord.Get().seed         = record.seed;
+        sampleOutputRecord.Get().sampleCount  = sampleCount;
+        sampleOutputRecord.Get().rootIndex    = record.rootIndex;
+    }
+
+    sampleOutputRecord.OutputComplete();
 }
 
 [Shader("node")]
@@ -94,15 +302,18 @@ void IvyAreaSample(
 
     if (dtid < record.sampleCount)
     {
-        const float3 samplePositionInBoundingBox = float3(Random(record.seed, dtid, 3732) * 2.0 - 1.0,  //
-                                                          1.f,
-                                                          Random(record.seed, dtid, 4561) * 2.0 - 1.0);
+        const float2 samplePosition              = GetAreaSamplePosition(record.seed, dtid);
+        const float3 samplePositionInBoundingBox = float3(samplePosition.x, 1.f, samplePosition.y);
         const float3 samplePositionWorldSpace    = mul(record.transform, float4(samplePositionInBoundingBox, 1)).xyz;
 
         // tMin and tMax are relative to length of direction
-        hit = TraceRay(samplePositionWorldSpace, sampleDirection, 0.f, 1.f, hitPosition, hitNormal);
+        hit = TraceGrowthRay(samplePositionWorldSpace, sampleDirection, 0.f, 1.f, hitPosition, hitNormal);
     }
 
+    AddWaveStatistic(IVY_STATISTIC_AREA_RAYS, dtid < record.sampleCount);
+    AddWaveRootStatistic(record.rootIndex, IVY_ROOT_STATISTIC_RAYS, dtid < record.sampleCount);
+    AddWaveStatistic(IVY_STATISTIC_AREA_SEEDS, hit);
+
     ThreadNodeOutputRecords<IvyBranchRecord> outputRecord = ivyBranchOutput.GetThreadNodeOutputRecords(hit);
 
     if (hit)
@@ -122,6 +333,75 @@ void IvyAreaSample(
             Translate(0, 2 * ivyStemRadius, 0)
         );
         outputRecord.Get(0).seed = CombineSeed(record.seed, dtid);
+        outputRecord.Get(0).rootIndex   = record.rootIndex;
+        outputRecord.Get(0).parentId    = 0;
+        outputRecord.Get(0).coplanarRun = 0;
+        outputRecord.Get(0).baseDepth   = 0;
+    }
+
+    outputRecord.OutputComplete();
+}
+
+[Shader("node")]
+[NodeLaunch("broadcasting")]
+[NodeMaxDispatchGrid(ivyAreaSurfaceSampleMaxThreadGroups, 1, 1)]
+[NumThreads(ivyAreaSampleThreadGroupSize, 1, 1)]
+void IvyAreaSurfaceSample(
+    uint dtid : SV_DispatchThreadID,
+
+    DispatchNodeInputRecord<IvyAreaSurfaceSampleRecord> inputRecord,
+
+    [MaxRecords(ivyAreaSampleThreadGroupSize)]
+    [NodeId("IvyBranch")]
+    NodeOutput<IvyBranchRecord> ivyBranchOutput
+)
+{
+    const IvyAreaSurfaceSampleRecord record = inputRecord.Get();
+
+    const bool hasSample = dtid < record.sampleCount;
+
+    AddWaveStatistic(IVY_STATISTIC_AREA_SEEDS, hasSample);
+
+    ThreadNodeOutputRecords<IvyBranchRecord> outputRecord = ivyBranchOutput.GetThreadNodeOutputRecords(hasSample);
+
+    if (hasSample)
+    {
+        // Select triangle proportional to its area using the alias table
+        const float  column      = Random(record.seed, dtid, 8123) * record.triangleCount;
+        const uint   columnIndex = min(uint(column), record.triangleCount - 1);
+        const SurfaceSamplingTriangle columnEntry = g_area_surface_triangles[record.triangleOffset + columnIndex];
+
+        const uint triangleIndex = (frac(column) < columnEntry.probability) ? columnIndex : columnEntry.alias;
+        const SurfaceSamplingTriangle triangle =
+            (triangleIndex == columnIndex) ? columnEntry : g_area_surface_triangles[record.triangleOffset + triangleIndex];
+
+        // Uniformly distributed point on triangle
+        float2 barycentrics = float2(Random(record.seed, dtid, 2741), Random(record.seed, dtid, 9432));
+        if (barycentrics.x + barycentrics.y > 1.f)
+        {
+            barycentrics = 1.f - barycentrics;
+        }
+
+        const float3 position = triangle.vertex + triangle.edge1 * barycentrics.x + triangle.edge2 * barycentrics.y;
+        const float3 normal   = normalize(cross(triangle.edge1, triangle.edge2));
+
+        // Random growth direction in tangent plane
+        const float3 tangent   = normalize(cross(normal, (abs(normal.y) < 0.99f) ? float3(0, 1, 0) : float3(1, 0, 0)));
+        const float3 bitangent = cross(normal, tangent);
+        const float  angle     = Random(record.seed, dtid, 5317) * 2 * PI;
+        const float3 forward   = tangent * cos(angle) + bitangent * sin(angle);
+
+        outputRecord.Get(0).transform = mmul(
+            Translate(position),
+            Rotate(forward, normal),
+            // move origin up to not place ivy inside the surface
+            Translate(0, 2 * ivyStemRadius, 0)
+        );
+        outputRecord.Get(0).seed = CombineSeed(record.seed, dtid);
+        outputRecord.Get(0).rootIndex   = record.rootIndex;
+        outputRecord.Get(0).parentId    = 0;
+        outputRecord.Get(0).coplanarRun = 0;
+        outputRecord.Get(0).baseDepth   = 0;
     }
 
     outputRecord.OutputComplete();
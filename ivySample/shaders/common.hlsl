@@ -28,7 +28,7 @@
 // Constants
 
 static const float ivyStemLength = 0.2f;
-static const float ivyStemRadius = 0.01f;
+static const float ivyStemRadius = IVY_STEM_RADIUS;
 
 static const uint ivyThreadGroupIterations = 4;
 static const uint ivyThreadGroupCoalescing = 8;
@@ -50,6 +50,8 @@ struct DrawIvyStemRecord
 {
     uint     stemCount : SV_DispatchGrid;
     float3x4 transform[maxStemsPerRecord];
+    // see PackWindData
+    uint     windData[maxStemsPerRecord];
 };
 
 // max. two leafes per stem
@@ -59,8 +61,513 @@ struct DrawIvyLeafRecord
 {
     uint     leafCount : SV_DispatchGrid;
     float3x4 transform[maxLeavesPerRecord];
+    // see PackWindData
+    uint     windData[maxLeavesPerRecord];
 };
 
+// All leaves of one IvyBranch record can collapse into a single card, see IVY_FLAG_LEAF_CARDS
+static const uint maxLeavesPerCard  = 2 * ivyThreadGroupIterations;
+static const uint maxCardsPerRecord = ivyThreadGroupCoalescing;
+
+struct DrawIvyLeafCardRecord
+{
+    uint     groupCount : SV_DispatchGrid;
+    uint     cardCount;
+    // Orthonormal card frame: x & z span the card plane, y is the card normal
+    float3x4 transform[maxCardsPerRecord];
+    // xy: minimum, zw: maximum of the card rectangle in the card plane
+    float4   rect[maxCardsPerRecord];
+    // see PackWindData
+    uint     windData[maxCardsPerRecord];
+    uint     leafCount[maxCardsPerRecord];
+    // maxLeavesPerCard sprites per card, see PackLeafCardSprite
+    uint     sprites[maxCardsPerRecord * maxLeavesPerCard];
+};
+
+// ==================
+// Wind animation
+
+// Flutter amplitude of leaf vertices per meter distance to the leaf origin, relative to IvyWindStrength
+static const float ivyLeafFlutterScale = 10.f;
+
+// Packs hierarchy depth (4 bits), branch phase (14 bits) & instance phase (14 bits) of a drawn instance
+uint PackWindData(uint depth, float branchPhase, float instancePhase)
+{
+    return min(depth, 15) | (uint(frac(branchPhase) * 16384.f) << 4) | (uint(frac(instancePhase) * 16384.f) << 18);
+}
+
+// Returns the bending offset of an instance. Bending grows with hierarchy depth, such that roots stay attached to their surface.
+float3 GetWindOffset(uint windData, float time)
+{
+    const float depth       = windData & 0xF;
+    const float branchPhase = ((windData >> 4) & 0x3FFF) / 16384.f;
+    const float bend        = IvyWindStrength * (depth / IVY_MAX_RECURSION) * sin(2 * PI * (time * IVY_WIND_FREQUENCY + branchPhase));
+
+    return IvyWindDirection.xyz * bend;
+}
+
+// Returns the flutter offset of a leaf vertex along the leaf normal; it grows with distance to the leaf origin, which stays attached to the stem
+float3 GetLeafFlutterOffset(uint windData, float3 localPosition, float3 leafNormal, float time)
+{
+    const float instancePhase = (windData >> 18) / 16384.f;
+    const float flutter       = IvyWindStrength * ivyLeafFlutterScale * length(localPosition);
+
+    return leafNormal * flutter * sin(2 * PI * (time * IVY_WIND_FLUTTER_FREQUENCY + instancePhase));
+}
+
+// ==================
+// Occlusion culling
+
+Texture2D<float> g_ivy_hiz : DECLARE_SRV(IVY_HIZ);
+
+float GetFarthestDepth(float a, float b)
+{
+    return (IvyFlags & IVY_FLAG_INVERTED_DEPTH) ? min(a, b) : max(a, b);
+}
+
+// Returns true if a screen-space rectangle in [0; 1] uv coordinates, whose nearest depth is nearestDepth, is entirely behind the HiZ pyramid.
+// Same as HiZPyramid::IsOccluded in hiz.cpp.
+bool IsHiZOccluded(float2 uvMin, float2 uvMax, float nearestDepth)
+{
+    // Rectangle in texels of the depth region
+    const float2 texelMin = saturate(uvMin) * HiZDepthSize;
+    const float2 texelMax = saturate(uvMax) * HiZDepthSize;
+
+    // Texels of mip m cover 2^(m+1) depth texels, thus the rectangle overlaps at most 2x2 texels of the selected mip
+    const float extent = max(max(texelMax.x - texelMin.x, texelMax.y - texelMin.y), 1.f);
+    const uint  mip    = min(uint(max(ceil(log2(extent)) - 1.f, 0.f)), HiZMipCount - 1);
+
+    uint2 mipSize;
+    uint  mipCount;
+    g_ivy_hiz.GetDimensions(mip, mipSize.x, mipSize.y, mipCount);
+
+    // Mips of the texture can be larger than the mips of the depth region, if it was rendered at a lower resolution
+    const uint2 regionMipSize = max(HiZDepthSize >> (mip + 1), 1);
+    const uint2 lastTexel     = min(regionMipSize, mipSize) - 1;
+    const uint2 minTexel      = min(uint2(texelMin) >> (mip + 1), lastTexel);
+    const uint2 maxTexel      = min(uint2(texelMax) >> (mip + 1), lastTexel);
+
+    const float farthestTop    = GetFarthestDepth(g_ivy_hiz.Load(int3(minTexel.x, minTexel.y, mip)), g_ivy_hiz.Load(int3(maxTexel.x, minTexel.y, mip)));
+    const float farthestBottom = GetFarthestDepth(g_ivy_hiz.Load(int3(minTexel.x, maxTexel.y, mip)), g_ivy_hiz.Load(int3(maxTexel.x, maxTexel.y, mip)));
+    const float farthestDepth  = GetFarthestDepth(farthestTop, farthestBottom);
+
+    return (IvyFlags & IVY_FLAG_INVERTED_DEPTH) ? (nearestDepth < farthestDepth) : (nearestDepth > farthestDepth);
+}
+
+// Returns false if the bounding box of an instance, grown by inflation to account for wind, is outside the view or behind the HiZ pyramid
+bool IsInstanceVisible(in float3x4 transform, float3 boundsCenter, float3 boundsExtents, float inflation)
+{
+    if ((IvyFlags & IVY_FLAG_OCCLUSION_CULLING) == 0)
+    {
+        return true;
+    }
+
+    // World-space bounding box of the transformed box
+    const float3 center  = mul(transform, float4(boundsCenter, 1));
+    const float3 extents = mul(abs((float3x3)transform), boundsExtents) + inflation;
+
+    float2 uvMin        = 1.f;
+    float2 uvMax        = 0.f;
+    float  nearestDepth = (IvyFlags & IVY_FLAG_INVERTED_DEPTH) ? 0.f : 1.f;
+
+    [unroll]
+    for (uint corner = 0; corner < 8; ++corner)
+    {
+        const float3 cornerSign        = float3(corner & 1, (corner >> 1) & 1, corner >> 2) * 2.f - 1.f;
+        const float4 clipSpacePosition = mul(ViewProjection, float4(center + extents * cornerSign, 1));
+
+        // Boxes crossing the near plane are always drawn
+        if (clipSpacePosition.w <= 0.f)
+        {
+            return true;
+        }
+
+        const float3 ndc = clipSpacePosition.xyz / clipSpacePosition.w;
+        const float2 uv  = ndc.xy * float2(0.5f, -0.5f) + 0.5f;
+
+        uvMin        = min(uvMin, uv);
+        uvMax        = max(uvMax, uv);
+        nearestDepth = (IvyFlags & IVY_FLAG_INVERTED_DEPTH) ? max(nearestDepth, ndc.z) : min(nearestDepth, ndc.z);
+    }
+
+    if (any(uvMax < 0.f) || any(uvMin > 1.f))
+    {
+        return false;
+    }
+
+    return !IsHiZOccluded(uvMin, uvMax, nearestDepth);
+}
+
+// Stems bend by at most IvyWindStrength, see GetWindOffset
+float GetStemInflation()
+{
+    return (IvyFlags & IVY_FLAG_WIND) ? IvyWindStrength : 0.f;
+}
+
+// Leaves additionally flutter proportional to the distance to their origin, see GetLeafFlutterOffset
+float GetLeafInflation()
+{
+    const float flutterDistance = length(abs(IvyLeafBoundsCenter.xyz) + IvyLeafBoundsExtents.xyz);
+
+    return (IvyFlags & IVY_FLAG_WIND) ? IvyWindStrength * (1.f + ivyLeafFlutterScale * flutterDistance) : 0.f;
+}
+
+bool IsStemVisible(in float3x4 transform)
+{
+    return IsInstanceVisible(transform, IvyStemBoundsCenter.xyz, IvyStemBoundsExtents.xyz, GetStemInflation());
+}
+
+bool IsLeafVisible(in float3x4 transform)
+{
+    return IsInstanceVisible(transform, IvyLeafBoundsCenter.xyz, IvyLeafBoundsExtents.xyz, GetLeafInflation());
+}
+
+// ==================
+// Views
+
+// Returns the views of IvyViewProjections the bounding box of an instance, grown by inflation to account for wind, may be visible in.
+// Only the side planes of each view are tested, as shadow casters in front of the near plane still cast shadows.
+uint GetInstanceViewMask(in float3x4 transform, float3 boundsCenter, float3 boundsExtents, float inflation)
+{
+    // World-space bounding box of the transformed box
+    const float3 center  = mul(transform, float4(boundsCenter, 1));
+    const float3 extents = mul(abs((float3x3)transform), boundsExtents) + inflation;
+
+    uint viewMask = 0;
+
+    for (uint view = 0; view < min(IvyViewCount, IVY_MAX_VIEWS); ++view)
+    {
+        // Side planes all corners are outside of; x < -w: bit 0, x > w: bit 1, y < -w: bit 2, y > w: bit 3
+        uint outside = 0xF;
+
+        [unroll]
+        for (uint corner = 0; corner < 8; ++corner)
+        {
+            const float3 cornerSign        = float3(corner & 1, (corner >> 1) & 1, corner >> 2) * 2.f - 1.f;
+            const float4 clipSpacePosition = mul(IvyViewProjections[view], float4(center + extents * cornerSign, 1));
+
+            outside &= ((clipSpacePosition.x < -clipSpacePosition.w) ? 1 : 0) | ((clipSpacePosition.x > clipSpacePosition.w) ? 2 : 0) |
+                       ((clipSpacePosition.y < -clipSpacePosition.w) ? 4 : 0) | ((clipSpacePosition.y > clipSpacePosition.w) ? 8 : 0);
+        }
+
+        if (outside == 0)
+        {
+            viewMask |= 1u << view;
+        }
+    }
+
+    return viewMask;
+}
+
+uint GetStemViewMask(in float3x4 transform)
+{
+    return GetInstanceViewMask(transform, IvyStemBoundsCenter.xyz, IvyStemBoundsExtents.xyz, GetStemInflation());
+}
+
+uint GetLeafViewMask(in float3x4 transform)
+{
+    return GetInstanceViewMask(transform, IvyLeafBoundsCenter.xyz, IvyLeafBoundsExtents.xyz, GetLeafInflation());
+}
+
+// ==================
+// Leaf cards
+
+// Range of leaf offsets from the card origin, covering all stems of one IvyBranch record
+static const float ivyLeafCardOffsetRange = ivyThreadGroupIterations * ivyStemLength;
+
+// Leaves collapsed into the card of an IvyBranch record
+struct IvyLeafCard
+{
+    float3x4 transform;
+    float4   rect;
+    uint     windData;
+    uint     leafCount;
+    uint     sprites[maxLeavesPerCard];
+};
+
+bool UseLeafCard(in float3x4 leafTransform)
+{
+    const float3 leafOrigin = float3(leafTransform._m03, leafTransform._m13, leafTransform._m23);
+
+    return (IvyFlags & IVY_FLAG_LEAF_CARDS) && (distance(leafOrigin, CameraPosition.xyz) > IvyLeafCardDistance);
+}
+
+// Packs offset (2x 8 bits) in the card plane, rotation (8 bits) & foreshortening (8 bits) of a leaf drawn on a card
+uint PackLeafCardSprite(float2 offset, float angle, float scale)
+{
+    const uint2 packedOffset = uint2(round((clamp(offset / ivyLeafCardOffsetRange, -1.f, 1.f) * 0.5f + 0.5f) * 255.f));
+    const uint  packedAngle  = uint(round(frac(angle / (2 * PI)) * 255.f));
+    const uint  packedScale  = uint(round(saturate(scale) * 255.f));
+
+    return packedOffset.x | (packedOffset.y << 8) | (packedAngle << 16) | (packedScale << 24);
+}
+
+void UnpackLeafCardSprite(uint sprite, out float2 offset, out float angle, out float scale)
+{
+    offset = (float2(sprite & 0xFF, (sprite >> 8) & 0xFF) / 255.f * 2.f - 1.f) * ivyLeafCardOffsetRange;
+    angle  = ((sprite >> 16) & 0xFF) / 255.f * 2 * PI;
+    scale  = (sprite >> 24) / 255.f;
+}
+
+// Adds a leaf to a card. The first leaf defines the card frame, which is aligned to the surface below its stem.
+void AddLeafToCard(inout IvyLeafCard card, in float4x4 stemTransform, in float3x4 leafTransform, uint windData)
+{
+    const float3 leafOrigin = float3(leafTransform._m03, leafTransform._m13, leafTransform._m23);
+    const float3 leafAxis   = float3(leafTransform._m00, leafTransform._m10, leafTransform._m20);
+
+    if (card.leafCount == 0)
+    {
+        const float3 forward = normalize(mul((float3x3)stemTransform, float3(1, 0, 0)));
+        const float3 side    = normalize(cross(forward, mul((float3x3)stemTransform, float3(0, 1, 0))));
+        const float3 normal  = cross(side, forward);
+
+        card.transform = float3x4(forward.x, normal.x, side.x, leafOrigin.x,
+                                  forward.y, normal.y, side.y, leafOrigin.y,
+                                  forward.z, normal.z, side.z, leafOrigin.z);
+        card.rect      = float4(1e9f, 1e9f, -1e9f, -1e9f);
+        card.windData  = windData;
+    }
+
+    const float3 axisX      = float3(card.transform._m00, card.transform._m10, card.transform._m20);
+    const float3 axisZ      = float3(card.transform._m02, card.transform._m12, card.transform._m22);
+    const float3 cardOrigin = float3(card.transform._m03, card.transform._m13, card.transform._m23);
+
+    // Leaves are projected onto the card plane, such that tilted leaves are foreshortened along their axis
+    const float2 offset        = float2(dot(leafOrigin - cardOrigin, axisX), dot(leafOrigin - cardOrigin, axisZ));
+    const float2 projectedAxis = float2(dot(leafAxis, axisX), dot(leafAxis, axisZ));
+    const float  angle         = atan2(projectedAxis.y, projectedAxis.x);
+    const float  scale         = length(projectedAxis) / length(leafAxis);
+
+    card.sprites[card.leafCount] = PackLeafCardSprite(offset, angle, scale);
+    card.leafCount += 1;
+
+    // Card rectangle covers the leaf mesh in any rotation
+    const float leafReach = length(abs(IvyLeafBoundsCenter.xz) + IvyLeafBoundsExtents.xz);
+    card.rect.xy          = min(card.rect.xy, offset - leafReach);
+    card.rect.zw          = max(card.rect.zw, offset + leafReach);
+}
+
+// Cards only bend with their branch, see GetWindOffset
+bool IsLeafCardVisible(in IvyLeafCard card)
+{
+    const float2 rectCenter  = 0.5f * (card.rect.xy + card.rect.zw);
+    const float2 rectExtents = 0.5f * (card.rect.zw - card.rect.xy);
+    const float  inflation   = (IvyFlags & IVY_FLAG_WIND) ? IvyWindStrength : 0.f;
+
+    return IsInstanceVisible(card.transform, float3(rectCenter.x, 0, rectCenter.y), float3(rectExtents.x, 0, rectExtents.y), inflation);
+}
+
+// ==================
+// Growth statistics
+
+RWStructuredBuffer<uint> g_ivy_statistics : DECLARE_UAV(IVY_STATISTICS);
+RWStructuredBuffer<uint> g_ivy_root_statistics : DECLARE_UAV(IVY_ROOT_STATISTICS);
+
+// Adds the values of all active lanes to a statistics counter, using a single atomic operation per wave
+void AddWaveStatistic(uint counter, uint value)
+{
+    if (IvyFlags & IVY_FLAG_STATISTICS)
+    {
+        const uint waveValue = WaveActiveSum(value);
+
+        if (WaveIsFirstLane() && (waveValue > 0))
+        {
+            InterlockedAdd(g_ivy_statistics[counter], waveValue);
+        }
+    }
+}
+
+// Adds the values of all active lanes to a per-root statistics counter. rootIndex has to be uniform across the wave.
+void AddWaveRootStatistic(uint rootIndex, uint counter, uint value)
+{
+    if (IvyFlags & IVY_FLAG_STATISTICS)
+    {
+        const uint waveValue = WaveActiveSum(value);
+
+        if (WaveIsFirstLane() && (waveValue > 0))
+        {
+            InterlockedAdd(g_ivy_root_statistics[rootIndex * IVY_ROOT_STATISTIC_COUNT + counter], waveValue);
+        }
+    }
+}
+
+// Sets a per-root statistics counter to the maximum of its value and the values of all active lanes.
+// rootIndex has to be uniform across the wave.
+void MaxWaveRootStatistic(uint rootIndex, uint counter, uint value)
+{
+    if (IvyFlags & IVY_FLAG_STATISTICS)
+    {
+        const uint waveValue = WaveActiveMax(value);
+
+        if (WaveIsFirstLane())
+        {
+            InterlockedMax(g_ivy_root_statistics[rootIndex * IVY_ROOT_STATISTIC_COUNT + counter], waveValue);
+        }
+    }
+}
+
+// ==================
+// Output digests
+
+RWStructuredBuffer<uint64_t> g_ivy_output_digests : DECLARE_UAV(IVY_OUTPUT_DIGESTS);
+
+// Returns the digest of a generated stem or leaf transform, or 0 if output digests are disabled.
+// outputType is IVY_OUTPUT_DIGEST_STEM or IVY_OUTPUT_DIGEST_LEAF. Same as GetOutputDigest in outputdigest.cpp.
+uint64_t GetOutputDigest(float3x4 transform, uint outputType)
+{
+    if ((IvyFlags & IVY_FLAG_OUTPUT_DIGEST) == 0)
+    {
+        return 0;
+    }
+
+    return Hash64(transform, outputType);
+}
+
+void AddOutputDigest(uint rootIndex, uint64_t digest)
+{
+    if ((IvyFlags & IVY_FLAG_OUTPUT_DIGEST) && (digest != 0))
+    {
+        InterlockedAdd(g_ivy_output_digests[rootIndex], digest);
+    }
+}
+
+// ==================
+// Lineage trace
+
+RWStructuredBuffer<uint> g_ivy_lineage_trace : DECLARE_UAV(IVY_LINEAGE_TRACE);
+
+// Appends an entry to the lineage trace. Returns the id of the entry, or 0 if tracing is disabled.
+uint AppendLineageTraceEntry(uint parentId, uint seed, uint rootIndex, uint flags)
+{
+    if ((IvyFlags & IVY_FLAG_LINEAGE_TRACE) == 0)
+    {
+        return 0;
+    }
+
+    uint entryIndex;
+    InterlockedAdd(g_ivy_lineage_trace[0], 1, entryIndex);
+
+    // Entries exceeding the capacity are dropped, but still get a unique id
+    if (entryIndex < IVY_LINEAGE_TRACE_CAPACITY)
+    {
+        const uint offset = IVY_LINEAGE_TRACE_HEADER_SIZE + entryIndex * IVY_LINEAGE_TRACE_ENTRY_SIZE;
+
+        g_ivy_lineage_trace[offset + 0] = parentId;
+        g_ivy_lineage_trace[offset + 1] = seed;
+        g_ivy_lineage_trace[offset + 2] = rootIndex;
+        g_ivy_lineage_trace[offset + 3] = flags;
+    }
+
+    return entryIndex + 1;
+}
+
+// ==================
+// Progressive growth & temporal regeneration
+
+RWStructuredBuffer<uint> g_ivy_frontiers[2] : DECLARE_UAV(IVY_FRONTIER);
+RWStructuredBuffer<uint> g_ivy_growth_caches[2] : DECLARE_UAV(IVY_GROWTH_CACHE);
+
+// Defers a branch record to the next frame. Records exceeding the frontier capacity are dropped.
+void AppendFrontierRecord(in IvyBranchRecord record)
+{
+    RWStructuredBuffer<uint> frontier = g_ivy_frontiers[IvyFrontierWriteIndex];
+
+    uint recordIndex;
+    InterlockedAdd(frontier[IVY_FRONTIER_APPEND_COUNTER], 1, recordIndex);
+
+    if (recordIndex >= IVY_FRONTIER_CAPACITY)
+    {
+        return;
+    }
+
+    const uint offset = IVY_FRONTIER_RECORDS + recordIndex * IVY_FRONTIER_RECORD_SIZE;
+
+    // Node records store matrices column-major, like entry records uploaded by the CPU
+    [unroll]
+    for (uint column = 0; column < 4; ++column)
+    {
+        [unroll]
+        for (uint row = 0; row < 4; ++row)
+        {
+            frontier[offset + column * 4 + row] = asuint(record.transform[row][column]);
+        }
+    }
+
+    frontier[offset + 16] = record.seed;
+    frontier[offset + 17] = record.rootIndex;
+    frontier[offset + 18] = record.parentId;
+    frontier[offset + 19] = record.coplanarRun;
+    frontier[offset + 20] = record.baseDepth;
+
+    // Records below the maximum are all written once the dispatch completed
+    InterlockedMax(frontier[IVY_FRONTIER_RECORD_COUNT], recordIndex + 1);
+}
+
+// Growth caches are used by progressive growth, temporal regeneration & ivy shadows
+bool UseGrowthCache()
+{
+    return (IvyFlags & IVY_FLAG_GROWTH_CACHE) != 0;
+}
+
+float3x4 LoadGrowthCacheTransform(RWStructuredBuffer<uint> cache, uint offset)
+{
+    float3x4 transform;
+
+    [unroll]
+    for (uint element = 0; element < 12; ++element)
+    {
+        transform[element / 4][element % 4] = asfloat(cache[offset + element]);
+    }
+
+    return transform;
+}
+
+// Appends an entry to the stem or leaf list of the growth cache written in this frame. Entries exceeding the capacity are dropped.
+void AppendGrowthCacheEntry(uint countOffset, uint entriesOffset, uint capacity, in float3x4 transform, uint windData, uint rootIndex, uint viewMask)
+{
+    RWStructuredBuffer<uint> cache = g_ivy_growth_caches[IvyGrowthCacheWriteIndex];
+
+    uint entryIndex;
+    InterlockedAdd(cache[countOffset], 1, entryIndex);
+
+    if (entryIndex >= capacity)
+    {
+        return;
+    }
+
+    const uint offset = entriesOffset + entryIndex * IVY_GROWTH_CACHE_ENTRY_SIZE;
+
+    [unroll]
+    for (uint element = 0; element < 12; ++element)
+    {
+        cache[offset + element] = asuint(transform[element / 4][element % 4]);
+    }
+
+    cache[offset + IVY_GROWTH_CACHE_ENTRY_WIND_DATA]  = windData;
+    cache[offset + IVY_GROWTH_CACHE_ENTRY_ROOT_INDEX] = rootIndex;
+    cache[offset + IVY_GROWTH_CACHE_ENTRY_VIEW_MASK]  = viewMask;
+}
+
+// Appends a stem transform & the views it may be visible in to the growth cache, if it is used
+void AppendGrowthCacheStem(in float3x4 transform, uint windData, uint rootIndex)
+{
+    if (UseGrowthCache())
+    {
+        AppendGrowthCacheEntry(
+            IVY_GROWTH_CACHE_STEM_COUNT, IVY_GROWTH_CACHE_STEMS, IVY_GROWTH_CACHE_STEM_CAPACITY, transform, windData, rootIndex, GetStemViewMask(transform));
+    }
+}
+
+// Appends a leaf transform & the views it may be visible in to the growth cache, if it is used
+void AppendGrowthCacheLeaf(in float3x4 transform, uint windData, uint rootIndex)
+{
+    if (UseGrowthCache())
+    {
+        AppendGrowthCacheEntry(
+            IVY_GROWTH_CACHE_LEAF_COUNT, IVY_GROWTH_CACHE_LEAVES, IVY_GROWTH_CACHE_LEAF_CAPACITY, transform, windData, rootIndex, GetLeafViewMask(transform));
+    }
+}
+
 // Output struct for deferred pixel shaders
 struct DeferredPixelShaderOutput {
     float4 albedo : SV_Target0;
@@ -0,0 +1,151 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "common.hlsl"
+#include "raytracing.hlsl"
+
+// ==================
+// Baked sparse distance field, see IVY_FLAG_SDF_QUERIES & distancefield.h
+
+StructuredBuffer<uint> g_sdf_brick_indices : DECLARE_SRV(IVY_SDF_BRICK_INDICES);
+StructuredBuffer<uint> g_sdf_bricks        : DECLARE_SRV(IVY_SDF_BRICKS);
+
+static const uint  sdfMaxSteps    = 64;
+// Sphere tracing reports a hit once closer than this to a surface
+static const float sdfHitDistance = 0.25f * IVY_SDF_VOXEL_SIZE;
+// Minimum step, as rays can move parallel to a surface within the hit distance
+static const float sdfMinStep     = 0.5f * sdfHitDistance;
+
+float LoadSdfSample(uint brickIndex, uint3 samplePosition)
+{
+    const uint sampleIndex = (samplePosition.z * IVY_SDF_BRICK_SAMPLES + samplePosition.y) * IVY_SDF_BRICK_SAMPLES + samplePosition.x;
+    const uint word        = g_sdf_bricks[brickIndex * IVY_SDF_BRICK_WORD_COUNT + sampleIndex / 4];
+
+    return ((word >> (8 * (sampleIndex % 4))) & 0xFF) * (IVY_SDF_MAX_DISTANCE / 255.f);
+}
+
+// Returns a conservative distance from position to the nearest surface
+float SampleSdf(float3 position)
+{
+    const float3 gridPosition = (position - SdfBoundsMin.xyz) / IVY_SDF_BRICK_EXTENT;
+    const float3 gridSize     = float3(SdfBrickGridSize);
+
+    // All surfaces are at least IVY_SDF_EMPTY_BRICK_MARGIN inside the bounds of the field
+    if (any(gridPosition < 0) || any(gridPosition >= gridSize))
+    {
+        const float3 outside = max(max(-gridPosition, gridPosition - gridSize), 0) * IVY_SDF_BRICK_EXTENT;
+
+        return length(outside) + IVY_SDF_EMPTY_BRICK_MARGIN;
+    }
+
+    const uint3 cell       = uint3(gridPosition);
+    const uint  brickIndex = g_sdf_brick_indices[(cell.z * SdfBrickGridSize.y + cell.y) * SdfBrickGridSize.x + cell.x];
+
+    if (brickIndex & IVY_SDF_EMPTY_BRICK)
+    {
+        const uint cellDistance = brickIndex & ~IVY_SDF_EMPTY_BRICK;
+
+        return max(IVY_SDF_EMPTY_BRICK_MARGIN, (cellDistance - 1) * IVY_SDF_BRICK_EXTENT);
+    }
+
+    // Trilinear interpolation of the eight surrounding samples
+    const float3 local  = (gridPosition - cell) * (IVY_SDF_BRICK_SAMPLES - 1);
+    const uint3  corner = min(uint3(local), IVY_SDF_BRICK_SAMPLES - 2);
+    const float3 weight = local - corner;
+
+    const float d000 = LoadSdfSample(brickIndex, corner + uint3(0, 0, 0));
+    const float d100 = LoadSdfSample(brickIndex, corner + uint3(1, 0, 0));
+    const float d010 = LoadSdfSample(brickIndex, corner + uint3(0, 1, 0));
+    const float d110 = LoadSdfSample(brickIndex, corner + uint3(1, 1, 0));
+    const float d001 = LoadSdfSample(brickIndex, corner + uint3(0, 0, 1));
+    const float d101 = LoadSdfSample(brickIndex, corner + uint3(1, 0, 1));
+    const float d011 = LoadSdfSample(brickIndex, corner + uint3(0, 1, 1));
+    const float d111 = LoadSdfSample(brickIndex, corner + uint3(1, 1, 1));
+
+    return lerp(lerp(lerp(d000, d100, weight.x), lerp(d010, d110, weight.x), weight.y),
+                lerp(lerp(d001, d101, weight.x), lerp(d011, d111, weight.x), weight.y),
+                weight.z);
+}
+
+// Gradient of the distance field with four samples on a tetrahedron
+float3 GetSdfGradient(float3 position)
+{
+    const float  h = 0.5f * IVY_SDF_VOXEL_SIZE;
+    const float2 k = float2(1, -1);
+
+    return k.xyy * SampleSdf(position + k.xyy * h) +  //
+           k.yyx * SampleSdf(position + k.yyx * h) +  //
+           k.yxy * SampleSdf(position + k.yxy * h) +  //
+           k.xxx * SampleSdf(position + k.xxx * h);
+}
+
+// Same interface as TraceRay, but sphere traces the baked distance field.
+// The field is unsigned, as scene meshes aren't closed. Thus only surfaces the ray approaches count as hits,
+// as the ray origin is usually close to the surface the branch is growing on.
+bool TraceSdf(in float3 origin, in float3 direction, in float tMin, in float tMax, out float3 hitPosition, out float3 hitNormal)
+{
+    float t                = tMin;
+    float previousDistance = SampleSdf(origin + direction * t);
+
+    for (uint step = 0; (step < sdfMaxSteps) && (t < tMax); ++step)
+    {
+        const float stepLength = max(previousDistance, sdfMinStep);
+
+        t = min(t + stepLength, tMax);
+
+        const float3 position = origin + direction * t;
+        const float  distance = SampleSdf(position);
+
+        if ((distance < sdfHitDistance) && (distance < previousDistance - 0.25f * stepLength))
+        {
+            const float3 gradient = GetSdfGradient(position);
+
+            hitPosition = position;
+            hitNormal   = (dot(gradient, gradient) > 0.f) ? normalize(gradient) : -direction;
+
+            return true;
+        }
+
+        previousDistance = distance;
+    }
+
+    hitPosition = origin + direction * tMax;
+    hitNormal   = float3(0, 1, 0);
+
+    return false;
+}
+
+// Growth query backend: baked distance field if enabled or if ray queries are unavailable, inline ray tracing otherwise
+bool TraceGrowthRay(in float3 origin, in float3 direction, in float tMin, in float tMax, out float3 hitPosition, out float3 hitNormal)
+{
+#if IVY_SDF_QUERIES_ONLY
+    return TraceSdf(origin, direction, tMin, tMax, hitPosition, hitNormal);
+#else
+    if (IvyFlags & IVY_FLAG_SDF_QUERIES)
+    {
+        return TraceSdf(origin, direction, tMin, tMax, hitPosition, hitNormal);
+    }
+
+    return TraceRay(origin, direction, tMin, tMax, hitPosition, hitNormal);
+#endif
+}
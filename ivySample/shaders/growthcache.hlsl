@@ -0,0 +1,183 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "common.hlsl"
+
+// Each thread group replays one draw record worth of stems & leaves from the growth cache
+static const uint ivyGrowthCacheDrawGroupCount = IVY_GROWTH_CACHE_LEAF_CAPACITY / maxLeavesPerRecord;
+
+groupshared uint keptStemCount;
+groupshared uint keptLeafCount;
+
+// Returns true if cached transforms of a root are kept, i.e. if the root still exists & isn't regenerated in this frame
+bool KeepGrowthCacheEntry(uint rootIndex)
+{
+    const bool regenerated = (IvyFlags & IVY_FLAG_TEMPORAL_REGENERATION) && (rootIndex >= IvyRegenerationStart) &&
+                             (rootIndex < IvyRegenerationStart + IvyRegenerationCount);
+
+    return (rootIndex < IvyRootCount) && !regenerated;
+}
+
+// Copies kept entries to the growth cache written in this frame. Each wave allocates all of its entries with a single atomic.
+// Views move in between frames, thus the view mask of the entry is replaced by the one of this frame.
+void CopyGrowthCacheEntry(RWStructuredBuffer<uint> readCache, uint readOffset, uint countOffset, uint entriesOffset, uint capacity, bool copy, uint viewMask)
+{
+    RWStructuredBuffer<uint> writeCache = g_ivy_growth_caches[IvyGrowthCacheWriteIndex];
+
+    const uint waveCopyCount = WaveActiveCountBits(copy);
+
+    uint waveEntryIndex = 0;
+    if (WaveIsFirstLane() && (waveCopyCount > 0))
+    {
+        InterlockedAdd(writeCache[countOffset], waveCopyCount, waveEntryIndex);
+    }
+
+    const uint entryIndex = WaveReadLaneFirst(waveEntryIndex) + WavePrefixCountBits(copy);
+
+    if (copy && (entryIndex < capacity))
+    {
+        const uint writeOffset = entriesOffset + entryIndex * IVY_GROWTH_CACHE_ENTRY_SIZE;
+
+        [unroll]
+        for (uint element = 0; element < IVY_GROWTH_CACHE_ENTRY_VIEW_MASK; ++element)
+        {
+            writeCache[writeOffset + element] = readCache[readOffset + element];
+        }
+
+        writeCache[writeOffset + IVY_GROWTH_CACHE_ENTRY_VIEW_MASK] = viewMask;
+    }
+}
+
+// Draws stems & leaves of the growth cache written in the previous frame and carries them over to the cache of this frame,
+// except for roots which are regenerated, see IVY_FLAG_PROGRESSIVE_GROWTH & IVY_FLAG_TEMPORAL_REGENERATION
+[Shader("node")]
+[NodeIsProgramEntry]
+[NodeLaunch("broadcasting")]
+[NodeDispatchGrid(ivyGrowthCacheDrawGroupCount, 1, 1)]
+[NumThreads(maxLeavesPerRecord, 1, 1)]
+void IvyGrowthCacheDraw(
+    uint gid  : SV_GroupID,
+    uint gtid : SV_GroupThreadID,
+
+    [MaxRecords(1)]
+    [NodeId("DrawIvyStem")]
+    NodeOutput<DrawIvyStemRecord> drawStemOutput,
+
+    [MaxRecords(1)]
+    [NodeId("DrawIvyLeaf")]
+    NodeOutput<DrawIvyLeafRecord> drawLeafOutput
+)
+{
+    RWStructuredBuffer<uint> readCache = g_ivy_growth_caches[1 - IvyGrowthCacheWriteIndex];
+
+    // Counters keep incrementing once the cache is full, thus counts are clamped to the capacity
+    const uint stemCount = min(readCache[IVY_GROWTH_CACHE_STEM_COUNT], IVY_GROWTH_CACHE_STEM_CAPACITY);
+    const uint leafCount = min(readCache[IVY_GROWTH_CACHE_LEAF_COUNT], IVY_GROWTH_CACHE_LEAF_CAPACITY);
+
+    if (gtid == 0)
+    {
+        keptStemCount = 0;
+        keptLeafCount = 0;
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    const uint stemIndex  = gid * maxStemsPerRecord + gtid;
+    const uint leafIndex  = gid * maxLeavesPerRecord + gtid;
+    const uint stemOffset = IVY_GROWTH_CACHE_STEMS + stemIndex * IVY_GROWTH_CACHE_ENTRY_SIZE;
+    const uint leafOffset = IVY_GROWTH_CACHE_LEAVES + leafIndex * IVY_GROWTH_CACHE_ENTRY_SIZE;
+
+    const bool keepStem = (gtid < maxStemsPerRecord) && (stemIndex < stemCount) &&
+                          KeepGrowthCacheEntry(readCache[stemOffset + IVY_GROWTH_CACHE_ENTRY_ROOT_INDEX]);
+    const bool keepLeaf = (leafIndex < leafCount) && KeepGrowthCacheEntry(readCache[leafOffset + IVY_GROWTH_CACHE_ENTRY_ROOT_INDEX]);
+
+    // Kept entries stay in the cache even if they are occluded this frame
+    const float3x4 stemTransform = LoadGrowthCacheTransform(readCache, stemOffset);
+    const float3x4 leafTransform = LoadGrowthCacheTransform(readCache, leafOffset);
+
+    // Kept entries are output of this frame like freshly generated ones, so the per-root digests cover roots outside the regeneration window
+    if (keepStem)
+    {
+        AddOutputDigest(readCache[stemOffset + IVY_GROWTH_CACHE_ENTRY_ROOT_INDEX], GetOutputDigest(stemTransform, IVY_OUTPUT_DIGEST_STEM));
+    }
+    if (keepLeaf)
+    {
+        AddOutputDigest(readCache[leafOffset + IVY_GROWTH_CACHE_ENTRY_ROOT_INDEX], GetOutputDigest(leafTransform, IVY_OUTPUT_DIGEST_LEAF));
+    }
+
+    const uint stemViewMask = keepStem ? GetStemViewMask(stemTransform) : 0;
+    const uint leafViewMask = keepLeaf ? GetLeafViewMask(leafTransform) : 0;
+
+    CopyGrowthCacheEntry(readCache, stemOffset, IVY_GROWTH_CACHE_STEM_COUNT, IVY_GROWTH_CACHE_STEMS, IVY_GROWTH_CACHE_STEM_CAPACITY, keepStem, stemViewMask);
+    CopyGrowthCacheEntry(readCache, leafOffset, IVY_GROWTH_CACHE_LEAF_COUNT, IVY_GROWTH_CACHE_LEAVES, IVY_GROWTH_CACHE_LEAF_CAPACITY, keepLeaf, leafViewMask);
+
+    const bool drawStem = keepStem && IsStemVisible(stemTransform);
+    const bool drawLeaf = keepLeaf && IsLeafVisible(leafTransform);
+
+    AddWaveStatistic(IVY_STATISTIC_CULLED_STEMS, keepStem && !drawStem);
+    AddWaveStatistic(IVY_STATISTIC_CULLED_LEAVES, keepLeaf && !drawLeaf);
+
+    // Compact drawn transforms of this group into the draw records
+    uint stemOutputIndex = 0;
+    uint leafOutputIndex = 0;
+
+    if (drawStem)
+    {
+        InterlockedAdd(keptStemCount, 1, stemOutputIndex);
+    }
+    if (drawLeaf)
+    {
+        InterlockedAdd(keptLeafCount, 1, leafOutputIndex);
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    const uint groupStemCount = keptStemCount;
+    const uint groupLeafCount = keptLeafCount;
+
+    GroupNodeOutputRecords<DrawIvyStemRecord> stemOutputRecord = drawStemOutput.GetGroupNodeOutputRecords(groupStemCount > 0);
+
+    if (drawStem)
+    {
+        stemOutputRecord.Get().transform[stemOutputIndex] = stemTransform;
+        stemOutputRecord.Get().windData[stemOutputIndex]  = readCache[stemOffset + IVY_GROWTH_CACHE_ENTRY_WIND_DATA];
+    }
+    if ((groupStemCount > 0) && (gtid == 0))
+    {
+        stemOutputRecord.Get().stemCount = groupStemCount;
+    }
+
+    stemOutputRecord.OutputComplete();
+
+    GroupNodeOutputRecords<DrawIvyLeafRecord> leafOutputRecord = drawLeafOutput.GetGroupNodeOutputRecords(groupLeafCount > 0);
+
+    if (drawLeaf)
+    {
+        leafOutputRecord.Get().transform[leafOutputIndex] = leafTransform;
+        leafOutputRecord.Get().windData[leafOutputIndex]  = readCache[leafOffset + IVY_GROWTH_CACHE_ENTRY_WIND_DATA];
+    }
+    if ((groupLeafCount > 0) && (gtid == 0))
+    {
+        leafOutputRecord.Get().leafCount = groupLeafCount;
+    }
+
+    leafOutputRecord.OutputComplete();
+}
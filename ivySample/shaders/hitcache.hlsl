@@ -0,0 +1,103 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "common.hlsl"
+#include "distancefield.hlsl"
+
+// ==================
+// Spatial hit cache, see IVY_FLAG_HIT_CACHE & hitcache.h
+
+RWStructuredBuffer<IvyHitCacheEntry> g_ivy_hit_cache : DECLARE_UAV(IVY_HIT_CACHE);
+
+uint GetHitCacheDirectionBin(float3 direction)
+{
+    // Octahedral mapping of direction to [-1; 1]^2
+    direction /= abs(direction.x) + abs(direction.y) + abs(direction.z);
+
+    float2 octahedron = direction.xy;
+
+    if (direction.z < 0)
+    {
+        octahedron = (1.f - abs(direction.yx)) * float2(direction.x >= 0 ? 1.f : -1.f, direction.y >= 0 ? 1.f : -1.f);
+    }
+
+    const uint2 bin = min(uint2((octahedron * 0.5f + 0.5f) * IVY_HIT_CACHE_DIRECTION_RESOLUTION), IVY_HIT_CACHE_DIRECTION_RESOLUTION - 1);
+
+    return bin.x + bin.y * IVY_HIT_CACHE_DIRECTION_RESOLUTION;
+}
+
+uint GetHitCacheKey(float3 origin, float3 direction, float tMax)
+{
+    const int3 cell = int3(floor(origin / IVY_HIT_CACHE_CELL_SIZE));
+    const uint key  = CombineSeed(CombineSeed(Hash(uint(cell.x)), uint(cell.y), uint(cell.z)), GetHitCacheDirectionBin(direction), asuint(tMax), IvyHitCacheEpoch);
+
+    // zero marks empty entries
+    return key | 1;
+}
+
+uint GetHitCacheChecksum(in IvyHitCacheEntry entry)
+{
+    return CombineSeed(entry.key, Hash(entry.position), Hash(entry.normal));
+}
+
+// Same as TraceGrowthRay, but answers the query from the hit cache if a ray with the same origin cell, direction bin & tMax was traced before.
+// Cached hits are positions found by that earlier ray, thus they approximate the hit of this ray within the size of a cell.
+// tMin is not part of the key and must be the same for all cached rays.
+bool TraceRayCached(in float3 origin, in float3 direction, in float tMin, in float tMax, out float3 hitPosition, out float3 hitNormal)
+{
+    if ((IvyFlags & IVY_FLAG_HIT_CACHE) == 0)
+    {
+        return TraceGrowthRay(origin, direction, tMin, tMax, hitPosition, hitNormal);
+    }
+
+    const uint key  = GetHitCacheKey(origin, direction, tMax);
+    const uint slot = Hash(key) & (IVY_HIT_CACHE_CAPACITY - 1);
+
+    const IvyHitCacheEntry cachedEntry = g_ivy_hit_cache[slot];
+    const bool             cacheHit    = (cachedEntry.key == key) && (cachedEntry.checksum == GetHitCacheChecksum(cachedEntry));
+
+    AddWaveStatistic(IVY_STATISTIC_HIT_CACHE_LOOKUPS, 1);
+    AddWaveStatistic(IVY_STATISTIC_HIT_CACHE_HITS, cacheHit);
+
+    if (cacheHit)
+    {
+        const bool hit = any(cachedEntry.normal != 0);
+
+        hitPosition = hit ? cachedEntry.position : origin + direction * tMax;
+        hitNormal   = hit ? cachedEntry.normal : float3(0, 1, 0);
+
+        return hit;
+    }
+
+    const bool hit = TraceGrowthRay(origin, direction, tMin, tMax, hitPosition, hitNormal);
+
+    IvyHitCacheEntry entry;
+    entry.key      = key;
+    entry.position = hitPosition;
+    entry.normal   = hit ? hitNormal : float3(0, 0, 0);
+    entry.checksum = GetHitCacheChecksum(entry);
+
+    g_ivy_hit_cache[slot] = entry;
+
+    return hit;
+}
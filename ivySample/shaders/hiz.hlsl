@@ -0,0 +1,65 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ivycommon.h"
+
+// Builds one mip of the HiZ pyramid of GBufferDepth per dispatch, see IVY_HIZ & hiz.h
+
+static const uint hizThreadGroupSize = 8;
+
+Texture2D<float>   g_depth : DECLARE_SRV(IVY_HIZ_BUILD_DEPTH);
+RWTexture2D<float> g_hiz_mips[IVY_HIZ_MAX_MIPS] : DECLARE_UAV(IVY_HIZ_BUILD_MIPS);
+
+float GetFarthestDepth(float a, float b)
+{
+    return InvertedDepth ? min(a, b) : max(a, b);
+}
+
+float LoadSourceDepth(uint2 texel)
+{
+    return (DestinationMip == 0) ? g_depth.Load(int3(texel, 0)) : g_hiz_mips[DestinationMip - 1][texel];
+}
+
+[numthreads(hizThreadGroupSize, hizThreadGroupSize, 1)]
+void DownsampleHiZ(uint2 dispatchThreadId : SV_DispatchThreadID)
+{
+    if (any(dispatchThreadId >= DestinationSize))
+    {
+        return;
+    }
+
+    // Last row & column also cover the remaining texel of an odd-sized source
+    const uint2 sourceBegin = dispatchThreadId * 2;
+    const uint2 sourceEnd   = uint2((dispatchThreadId.x == DestinationSize.x - 1) ? SourceSize.x : min(sourceBegin.x + 2, SourceSize.x),
+                                    (dispatchThreadId.y == DestinationSize.y - 1) ? SourceSize.y : min(sourceBegin.y + 2, SourceSize.y));
+
+    float depth = InvertedDepth ? 1.f : 0.f;
+
+    for (uint y = sourceBegin.y; y < sourceEnd.y; ++y)
+    {
+        for (uint x = sourceBegin.x; x < sourceEnd.x; ++x)
+        {
+            depth = GetFarthestDepth(depth, LoadSourceDepth(uint2(x, y)));
+        }
+    }
+
+    g_hiz_mips[DestinationMip][dispatchThreadId] = depth;
+}
@@ -20,15 +20,21 @@
 // THE SOFTWARE.
 
 #include "common.hlsl"
-#include "raytracing.hlsl"
+#include "hitcache.hlsl"
 
 static const uint ivyWaveSize = 32;
 
-static const uint ivyMaxRecursion      = 12;
+static const uint ivyMaxRecursion      = IVY_MAX_RECURSION;
 static const uint ivyForwardProbeCount = 8;
 
+// Number of consecutive coplanar iterations after which adaptive probing only traces confirm rays, see IVY_FLAG_ADAPTIVE_PROBING
+static const uint  ivyCoplanarRunLength    = 2;
+// Cosine of maximum angle between surface normal & branch up direction for a hit to continue a coplanar run (~5 degrees)
+static const float ivyCoplanarCosTolerance = 0.996f;
+
 groupshared uint outputStemCount;
 groupshared uint outputLeafCount;
+groupshared uint outputCardCount;
 
 [WaveSize(ivyWaveSize)]
 [Shader("node")]
@@ -49,6 +55,10 @@ void IvyBranch(
     [MaxRecords(1)]
     [NodeId("DrawIvyLeaf")]
     NodeOutput<DrawIvyLeafRecord> drawLeafOutput,
+
+    [MaxRecords(1)]
+    [NodeId("DrawIvyLeafCard")]
+    NodeOutput<DrawIvyLeafCardRecord> drawLeafCardOutput,
     
     // one continued output; one branch output (fork)
     [MaxRecords(2 * ivyThreadGroupCoalescing)]
@@ -58,9 +68,11 @@ void IvyBranch(
 {
     GroupNodeOutputRecords<DrawIvyStemRecord> ivyStemOutputRecord = drawStemOutput.GetGroupNodeOutputRecords(1);
     GroupNodeOutputRecords<DrawIvyLeafRecord> ivyLeafOutputRecord = drawLeafOutput.GetGroupNodeOutputRecords(1);
+    GroupNodeOutputRecords<DrawIvyLeafCardRecord> ivyLeafCardOutputRecord = drawLeafCardOutput.GetGroupNodeOutputRecords(1);
 
     outputStemCount = 0;
     outputLeafCount = 0;
+    outputCardCount = 0;
 
     GroupMemoryBarrierWithGroupSync();
 
@@ -75,12 +87,49 @@ void IvyBranch(
     float4x4 branchTransform = IdentityMatrix<float4x4>();
     bool     hasBranch       = false;
 
+    // Depth, iteration outcomes & branch decisions for lineage trace, see IVY_LINEAGE_*
+    uint lineageFlags = 0;
+
+    // Consecutive coplanar downward hits, carried over from parent branch, see IVY_FLAG_ADAPTIVE_PROBING
+    uint coplanarRun = 0;
+
+    // Recursion levels left, including levels grown in previous frames
+    uint remainingLevels = 0;
+
     if (inputRecordIndex < inputRecord.Count())
     {
         const uint seed = inputRecord.Get(inputRecordIndex).seed;
 
         transform = inputRecord.Get(inputRecordIndex).transform;
 
+        // Records deferred by progressive growth continue at the depth reached in previous frames
+        const uint depth = inputRecord.Get(inputRecordIndex).baseDepth + ivyMaxRecursion - GetRemainingRecursionLevels();
+        AddWaveStatistic(IVY_STATISTIC_DEPTH_HISTOGRAM + min(depth, IVY_STATISTIC_DEPTH_HISTOGRAM_SIZE - 1), writingThread);
+
+        // Per-root statistics of this record; stems & leaves are only counted by the writing thread
+        const uint rootIndex = inputRecord.Get(inputRecordIndex).rootIndex;
+        uint       rayCount  = 0;
+        uint       stemCount = 0;
+        uint       leafCount = 0;
+
+        // Stems & leaves of the writing thread rejected by IVY_FLAG_OCCLUSION_CULLING
+        uint culledStemCount = 0;
+        uint culledLeafCount = 0;
+
+        // Distant leaves of the writing thread, see IVY_FLAG_LEAF_CARDS
+        IvyLeafCard leafCard = (IvyLeafCard)0;
+
+        // All branches of a root share their wind phase, such that bending stays coherent across branch junctions, see IVY_FLAG_WIND
+        const float branchPhase = Random(rootIndex, 'W');
+
+        coplanarRun     = inputRecord.Get(inputRecordIndex).coplanarRun;
+        remainingLevels = ivyMaxRecursion - depth;
+
+        // Order independent digest of all stem & leaf transforms written by this thread
+        uint64_t outputDigest = 0;
+
+        lineageFlags = min(depth, IVY_LINEAGE_DEPTH_MASK);
+
         for (int iteration = 0; iteration < ivyThreadGroupIterations; ++iteration) 
         {
             const float3 origin  = mul(transform, float4(0, 0, 0, 1)).xyz;
@@ -98,9 +147,32 @@ void IvyBranch(
             float3 forwardHitNormal   = float3(0, 0, 0);
             bool   forwardHit         = false;
 
-            if (WaveGetLaneIndex() < ivyForwardProbeCount)
+            // On planar runs, a single forward ray confirms that there's no obstacle ahead
+            const bool planarRun         = (IvyFlags & IVY_FLAG_ADAPTIVE_PROBING) && (coplanarRun >= ivyCoplanarRunLength);
+            const uint forwardProbeCount = planarRun ? 1 : ivyForwardProbeCount;
+
+            AddWaveStatistic(IVY_STATISTIC_PLANAR_ITERATIONS, planarRun && writingThread);
+
+            if (WaveGetLaneIndex() < forwardProbeCount)
+            {
+                forwardHit = TraceRayCached(localOrigin, forward, 0.f, ivyStemLength, forwardHitPosition, forwardHitNormal);
+            }
+
+            AddWaveStatistic(IVY_STATISTIC_FORWARD_RAYS, WaveGetLaneIndex() < forwardProbeCount);
+            rayCount += WaveGetLaneIndex() < forwardProbeCount;
+
+            // Confirm ray hit an obstacle; trace the remaining fan to find the closest hit
+            if (planarRun && WaveActiveAnyTrue(forwardHit))
             {
-                forwardHit = TraceRay(localOrigin, forward, 0.f, ivyStemLength, forwardHitPosition, forwardHitNormal);
+                const bool fallbackLane = (WaveGetLaneIndex() >= forwardProbeCount) && (WaveGetLaneIndex() < ivyForwardProbeCount);
+
+                if (fallbackLane)
+                {
+                    forwardHit = TraceRayCached(localOrigin, forward, 0.f, ivyStemLength, forwardHitPosition, forwardHitNormal);
+                }
+
+                AddWaveStatistic(IVY_STATISTIC_FORWARD_RAYS, fallbackLane);
+                rayCount += fallbackLane;
             }
 
             const float forwardHitDistance     = distance(localOrigin, forwardHitPosition);
@@ -113,8 +185,13 @@ void IvyBranch(
             const float2 leafRotationOffset = float2(Random(seed, iteration, 456) * 2.0 - 1.0, Random(seed, iteration, 567) * 2.0 - 1.0);
             const float2 leafRotation       = float2(Random(seed, iteration, 478), Random(seed, iteration, 645));
 
+            const uint lineageOutcomeShift = IVY_LINEAGE_OUTCOME_SHIFT + 2 * iteration;
+
             if (forwardHit)
             {
+                lineageFlags |= IVY_LINEAGE_OUTCOME_FORWARD_HIT << lineageOutcomeShift;
+                coplanarRun = 0;
+
                 const bool isMinDistanceLane    = forwardHitDistance == waveForwardHitDistance;
                 const uint minDistanceLaneIndex = WaveActiveMin(isMinDistanceLane ? WaveGetLaneIndex() : WaveGetLaneCount() - 1);
 
@@ -126,34 +203,76 @@ void IvyBranch(
                 // Draw stem
                 if (writingThread)
                 {
-                    int stemOutputIndex;
-                    InterlockedAdd(outputStemCount, 1, stemOutputIndex);
+                    stemCount += 1;
 
-                    ivyStemOutputRecord.Get().transform[stemOutputIndex] = (float3x4)mmul(
+                    const float3x4 stemTransform = (float3x4)mmul(
                         transform,
                         RotateX(stemRotation),
                         Scale(stemScale, 1.f, 1.f)
                     );
+                    const uint stemWindData = PackWindData(depth, branchPhase, 0.f);
+                    outputDigest += GetOutputDigest(stemTransform, IVY_OUTPUT_DIGEST_STEM);
+                    AppendGrowthCacheStem(stemTransform, stemWindData, rootIndex);
+
+                    if (IsStemVisible(stemTransform))
+                    {
+                        int stemOutputIndex;
+                        InterlockedAdd(outputStemCount, 1, stemOutputIndex);
+
+                        ivyStemOutputRecord.Get().transform[stemOutputIndex] = stemTransform;
+                        ivyStemOutputRecord.Get().windData[stemOutputIndex]  = stemWindData;
+                    }
+                    else
+                    {
+                        culledStemCount += 1;
+                    }
                 }
 
                 // Draw two leafes if stem is long enough
                 if (writingThread && (stemScale > 0.5))
                 {
-                    int leafOutputIndex;
-                    InterlockedAdd(outputLeafCount, 2, leafOutputIndex);
-
-                    ivyLeafOutputRecord.Get().transform[leafOutputIndex + 0] = (float3x4)mmul(
-                        transform,
-                        Translate(leafOffset.x * stemScale * ivyStemLength, 0, 0),
-                        RotateY(0.5f * leafRotationOffset.x + PI / 2.f),
-                        RotateZ(0.5f * leafRotation.x)
-                    );
-                    ivyLeafOutputRecord.Get().transform[leafOutputIndex + 1] = (float3x4)mmul(
-                        transform,
-                        Translate(leafOffset.x * stemScale * ivyStemLength, 0, 0),
-                        RotateY(0.5f * leafRotationOffset.x - PI / 2.f),
-                        RotateZ(0.5f * leafRotation.x)
-                    );
+                    leafCount += 2;
+
+                    const float3x4 leafTransforms[2] = {
+                        (float3x4)mmul(
+                            transform,
+                            Translate(leafOffset.x * stemScale * ivyStemLength, 0, 0),
+                            RotateY(0.5f * leafRotationOffset.x + PI / 2.f),
+                            RotateZ(0.5f * leafRotation.x)
+                        ),
+                        (float3x4)mmul(
+                            transform,
+                            Translate(leafOffset.x * stemScale * ivyStemLength, 0, 0),
+                            RotateY(0.5f * leafRotationOffset.x - PI / 2.f),
+                            RotateZ(0.5f * leafRotation.x)
+                        ),
+                    };
+
+                    [unroll]
+                    for (uint leaf = 0; leaf < 2; ++leaf)
+                    {
+                        const float3x4 leafTransform = leafTransforms[leaf];
+                        const uint     leafWindData  = PackWindData(depth, branchPhase, Random(seed, iteration, 'L', leaf));
+                        outputDigest += GetOutputDigest(leafTransform, IVY_OUTPUT_DIGEST_LEAF);
+                        AppendGrowthCacheLeaf(leafTransform, leafWindData, rootIndex);
+
+                        if (UseLeafCard(leafTransform))
+                        {
+                            AddLeafToCard(leafCard, transform, leafTransform, leafWindData);
+                        }
+                        else if (IsLeafVisible(leafTransform))
+                        {
+                            int leafOutputIndex;
+                            InterlockedAdd(outputLeafCount, 1, leafOutputIndex);
+
+                            ivyLeafOutputRecord.Get().transform[leafOutputIndex] = leafTransform;
+                            ivyLeafOutputRecord.Get().windData[leafOutputIndex]  = leafWindData;
+                        }
+                        else
+                        {
+                            culledLeafCount += 1;
+                        }
+                    }
                 }
 
                 float3 side = normalize(cross(forward, waveForwardHitNormal));
@@ -177,30 +296,72 @@ void IvyBranch(
                 if (writingThread)
                 {
                     // Draw stem
-                    int stemOutputIndex;
-                    InterlockedAdd(outputStemCount, 1, stemOutputIndex);
+                    stemCount += 1;
 
-                    ivyStemOutputRecord.Get().transform[stemOutputIndex] = (float3x4)mmul(
+                    const float3x4 stemTransform = (float3x4)mmul(
                         transform,
                         RotateX(stemRotation)
                     );
+                    const uint stemWindData = PackWindData(depth, branchPhase, 0.f);
+                    outputDigest += GetOutputDigest(stemTransform, IVY_OUTPUT_DIGEST_STEM);
+                    AppendGrowthCacheStem(stemTransform, stemWindData, rootIndex);
 
-                    // Draw leafes
-                    int leafOutputIndex;
-                    InterlockedAdd(outputLeafCount, 2, leafOutputIndex);
+                    if (IsStemVisible(stemTransform))
+                    {
+                        int stemOutputIndex;
+                        InterlockedAdd(outputStemCount, 1, stemOutputIndex);
 
-                    ivyLeafOutputRecord.Get().transform[leafOutputIndex + 0] = (float3x4)mmul(
-                        transform,
-                        Translate(leafOffset.x * ivyStemLength, 0, 0),
-                        RotateY(0.5f * leafRotationOffset.x + PI / 2.f),
-                        RotateZ(0.5f * leafRotation.x)
-                    );
-                    ivyLeafOutputRecord.Get().transform[leafOutputIndex + 1] = (float3x4)mmul(
-                        transform,
-                        Translate(leafOffset.x * ivyStemLength, 0, 0),
-                        RotateY(0.5f * leafRotationOffset.x - PI / 2.f),
-                        RotateZ(0.5f * leafRotation.x)
-                    );
+                        ivyStemOutputRecord.Get().transform[stemOutputIndex] = stemTransform;
+                        ivyStemOutputRecord.Get().windData[stemOutputIndex]  = stemWindData;
+                    }
+                    else
+                    {
+                        culledStemCount += 1;
+                    }
+
+                    // Draw leafes
+                    leafCount += 2;
+
+                    const float3x4 leafTransforms[2] = {
+                        (float3x4)mmul(
+                            transform,
+                            Translate(leafOffset.x * ivyStemLength, 0, 0),
+                            RotateY(0.5f * leafRotationOffset.x + PI / 2.f),
+                            RotateZ(0.5f * leafRotation.x)
+                        ),
+                        (float3x4)mmul(
+                            transform,
+                            Translate(leafOffset.x * ivyStemLength, 0, 0),
+                            RotateY(0.5f * leafRotationOffset.x - PI / 2.f),
+                            RotateZ(0.5f * leafRotation.x)
+                        ),
+                    };
+
+                    [unroll]
+                    for (uint leaf = 0; leaf < 2; ++leaf)
+                    {
+                        const float3x4 leafTransform = leafTransforms[leaf];
+                        const uint     leafWindData  = PackWindData(depth, branchPhase, Random(seed, iteration, 'L', leaf));
+                        outputDigest += GetOutputDigest(leafTransform, IVY_OUTPUT_DIGEST_LEAF);
+                        AppendGrowthCacheLeaf(leafTransform, leafWindData, rootIndex);
+
+                        if (UseLeafCard(leafTransform))
+                        {
+                            AddLeafToCard(leafCard, transform, leafTransform, leafWindData);
+                        }
+                        else if (IsLeafVisible(leafTransform))
+                        {
+                            int leafOutputIndex;
+                            InterlockedAdd(outputLeafCount, 1, leafOutputIndex);
+
+                            ivyLeafOutputRecord.Get().transform[leafOutputIndex] = leafTransform;
+                            ivyLeafOutputRecord.Get().windData[leafOutputIndex]  = leafWindData;
+                        }
+                        else
+                        {
+                            culledLeafCount += 1;
+                        }
+                    }
                 }
 
                 const float3 nextOrigin = origin + forward * ivyStemLength;
@@ -213,8 +374,29 @@ void IvyBranch(
                 const float3 direction = writingThread ? -up : randomDirection;
                 const float  tMax      = writingThread ? 2 * ivyStemRadius : 2 * ivyStemLength;
 
-                float3 localHitPosition, localHitNormal;
-                const bool localHit = TraceRay(nextOrigin, direction, 0.f, tMax, localHitPosition, localHitNormal);
+                float3 localHitPosition = float3(0, 0, 0);
+                float3 localHitNormal   = float3(0, 0, 0);
+                bool   localHit         = false;
+
+                // On planar runs, the downward ray is traced first as confirm ray
+                if (writingThread || !planarRun)
+                {
+                    localHit = TraceRayCached(nextOrigin, direction, 0.f, tMax, localHitPosition, localHitNormal);
+                }
+
+                // Random rays are only needed if the confirm ray missed, i.e. at an edge of the plane
+                const bool randomFallback = planarRun && !WaveReadLaneFirst(localHit);
+
+                if (randomFallback && !writingThread)
+                {
+                    localHit = TraceRayCached(nextOrigin, direction, 0.f, tMax, localHitPosition, localHitNormal);
+                }
+
+                const bool tracedRandomRay = !writingThread && (!planarRun || randomFallback);
+
+                AddWaveStatistic(IVY_STATISTIC_DOWNWARD_RAYS, writingThread);
+                AddWaveStatistic(IVY_STATISTIC_RANDOM_RAYS, tracedRandomRay);
+                rayCount += writingThread || tracedRandomRay;
     
                 // Synchronize localHit across lanes
                 const bool downwardHit = WaveReadLaneFirst(localHit);
@@ -222,9 +404,14 @@ void IvyBranch(
             
                 if (downwardHit) {
                     // Downward surface was hit; continue on current surface.
+                    lineageFlags |= IVY_LINEAGE_OUTCOME_DOWNWARD_HIT << lineageOutcomeShift;
 
                     const float3 downwardHitPosition = WaveReadLaneFirst(localHitPosition);
                     const float3 downwardHitNormal   = WaveReadLaneFirst(localHitNormal);
+
+                    // Surface continues in the plane of the branch if its normal matches the up direction
+                    const bool coplanar = dot(normalize(downwardHitNormal), up) >= ivyCoplanarCosTolerance;
+                    coplanarRun         = coplanar ? coplanarRun + 1 : 0;
     
                     transform = mmul(
                         Translate(nextOrigin),
@@ -234,6 +421,8 @@ void IvyBranch(
                     );
                 } else if (anyHit) {
                     // No downward surface was hit, but we found another surface nearby.
+                    lineageFlags |= IVY_LINEAGE_OUTCOME_RANDOM_HIT << lineageOutcomeShift;
+                    coplanarRun = 0;
 
                     // find lane with most forward random direction
                     const float cosAngle    = dot(direction, forward);
@@ -253,6 +442,8 @@ void IvyBranch(
                     );
                 } else {
                     // No downward surface & no nearby surface. Slowly grow downward
+                    lineageFlags |= IVY_LINEAGE_OUTCOME_FREE_FALL << lineageOutcomeShift;
+                    coplanarRun = 0;
 
                     // Start with random direction
                     float3 nextForward = normalize(float3(Random(seed, iteration, 387),  //
@@ -281,6 +472,7 @@ void IvyBranch(
                 if (branch)
                 {
                     hasBranch = true;
+                    lineageFlags |= iteration << IVY_LINEAGE_BRANCH_ITERATION_SHIFT;
 
                     branchTransform = mmul(transform, RotateY(-0.5f));
                     transform       = mmul(transform, RotateY(0.5f));
@@ -290,31 +482,107 @@ void IvyBranch(
             stemRotation += 1;
         }
 
-        hasNext = (Random(seed, 3489) < 0.2f) || (GetRemainingRecursionLevels() > 6);
+        // Draw card of distant leaves
+        if (leafCard.leafCount > 0)
+        {
+            if (IsLeafCardVisible(leafCard))
+            {
+                int cardOutputIndex;
+                InterlockedAdd(outputCardCount, 1, cardOutputIndex);
+
+                ivyLeafCardOutputRecord.Get().transform[cardOutputIndex] = leafCard.transform;
+                ivyLeafCardOutputRecord.Get().rect[cardOutputIndex]      = leafCard.rect;
+                ivyLeafCardOutputRecord.Get().windData[cardOutputIndex]  = leafCard.windData;
+                ivyLeafCardOutputRecord.Get().leafCount[cardOutputIndex] = leafCard.leafCount;
+
+                for (uint sprite = 0; sprite < leafCard.leafCount; ++sprite)
+                {
+                    ivyLeafCardOutputRecord.Get().sprites[cardOutputIndex * maxLeavesPerCard + sprite] = leafCard.sprites[sprite];
+                }
+            }
+            else
+            {
+                culledLeafCount += leafCard.leafCount;
+            }
+        }
+
+        hasNext = (Random(seed, 3489) < 0.2f) || (remainingLevels > 6);
+
+        AddWaveRootStatistic(rootIndex, IVY_ROOT_STATISTIC_RAYS, rayCount);
+        AddWaveRootStatistic(rootIndex, IVY_ROOT_STATISTIC_STEMS, stemCount);
+        AddWaveRootStatistic(rootIndex, IVY_ROOT_STATISTIC_LEAVES, leafCount);
+        MaxWaveRootStatistic(rootIndex, IVY_ROOT_STATISTIC_MAX_DEPTH, depth);
+        AddWaveStatistic(IVY_STATISTIC_CULLED_STEMS, culledStemCount);
+        AddWaveStatistic(IVY_STATISTIC_CULLED_LEAVES, culledLeafCount);
+
+        AddOutputDigest(rootIndex, outputDigest);
     }
 
     // recursive output
-    hasNext                     = hasNext && (GetRemainingRecursionLevels() > 0);
-    hasBranch                   = hasBranch && (GetRemainingRecursionLevels() > 0);
+    hasNext                     = hasNext && (remainingLevels > 0);
+    hasBranch                   = hasBranch && (remainingLevels > 0);
     const int outputRecordCount = int(hasNext) + int(hasBranch);
 
+    // Progressive growth defers children beyond the levels of this frame to the frontier, which is dispatched next frame
+    const uint frameDepth      = ivyMaxRecursion - GetRemainingRecursionLevels();
+    const bool deferToFrontier = (IvyFlags & IVY_FLAG_PROGRESSIVE_GROWTH) && (frameDepth + 1 >= IvyProgressiveLevels);
+
+    // Record lineage of this invocation; children reference it as their parent
+    uint lineageId = 0;
+
+    if (writingThread && (inputRecordIndex < inputRecord.Count()))
+    {
+        lineageFlags |= (hasNext ? IVY_LINEAGE_HAS_NEXT : 0) | (hasBranch ? IVY_LINEAGE_HAS_BRANCH : 0);
+
+        lineageId = AppendLineageTraceEntry(inputRecord.Get(inputRecordIndex).parentId,
+                                            inputRecord.Get(inputRecordIndex).seed,
+                                            inputRecord.Get(inputRecordIndex).rootIndex,
+                                            lineageFlags);
+    }
+
     ThreadNodeOutputRecords<IvyBranchRecord> recursiveOutputRecord = 
-        recursiveOutput.GetThreadNodeOutputRecords(writingThread ? outputRecordCount : 0);
+        recursiveOutput.GetThreadNodeOutputRecords((writingThread && !deferToFrontier) ? outputRecordCount : 0);
 
     if (writingThread && (hasNext || hasBranch))
     {
-        const uint seed = inputRecord.Get(inputRecordIndex).seed;
-
-        if (hasNext)
+        const uint seed      = inputRecord.Get(inputRecordIndex).seed;
+        const uint rootIndex = inputRecord.Get(inputRecordIndex).rootIndex;
+        const uint baseDepth = inputRecord.Get(inputRecordIndex).baseDepth;
+
+        // Lineage ids are only valid within a frame, thus deferred records start a new lineage
+        IvyBranchRecord nextRecord;
+        nextRecord.transform   = transform;
+        nextRecord.seed        = CombineSeed(seed, 3487, Hash(transform));
+        nextRecord.rootIndex   = rootIndex;
+        nextRecord.parentId    = deferToFrontier ? 0 : lineageId;
+        nextRecord.coplanarRun = coplanarRun;
+        nextRecord.baseDepth   = deferToFrontier ? (baseDepth + frameDepth + 1) : baseDepth;
+
+        IvyBranchRecord branchRecord = nextRecord;
+        branchRecord.transform       = branchTransform;
+        branchRecord.seed            = CombineSeed(seed, 83497, Hash(branchTransform));
+
+        if (deferToFrontier)
         {
-            recursiveOutputRecord.Get(0).transform = transform;
-            recursiveOutputRecord.Get(0).seed      = CombineSeed(seed, 3487, Hash(transform));
+            if (hasNext)
+            {
+                AppendFrontierRecord(nextRecord);
+            }
+            if (hasBranch)
+            {
+                AppendFrontierRecord(branchRecord);
+            }
         }
-
-        if (hasBranch)
+        else
         {
-            recursiveOutputRecord.Get(hasNext).transform = branchTransform;
-            recursiveOutputRecord.Get(hasNext).seed      = CombineSeed(seed, 83497, Hash(branchTransform));
+            if (hasNext)
+            {
+                recursiveOutputRecord.Get(0) = nextRecord;
+            }
+            if (hasBranch)
+            {
+                recursiveOutputRecord.Get(hasNext) = branchRecord;
+            }
         }
     }
 
@@ -325,7 +593,11 @@ void IvyBranch(
     // sync groupshared counters to records
     ivyStemOutputRecord.Get().stemCount = outputStemCount;
     ivyLeafOutputRecord.Get().leafCount = outputLeafCount;
+    // Cards of all records fit into a single mesh node thread group
+    ivyLeafCardOutputRecord.Get().groupCount = (outputCardCount > 0) ? 1 : 0;
+    ivyLeafCardOutputRecord.Get().cardCount  = outputCardCount;
 
     ivyStemOutputRecord.OutputComplete();
     ivyLeafOutputRecord.OutputComplete();
+    ivyLeafCardOutputRecord.OutputComplete();
 }
\ No newline at end of file
@@ -25,16 +25,55 @@
 #include "misc/math.h"
 #endif  // __cplusplus
 
+// Maximum number of additional views, bounded by the number of viewports of a single draw, see WorkGraphCBData::IvyViewProjections
+#define IVY_MAX_VIEWS 16
+
 #if __cplusplus
 struct WorkGraphCBData
 {
-    Mat4 ViewProjection;
-    Mat4 PreviousViewProjection;
-    Mat4 InverseViewProjection;
-    Vec4 CameraPosition;
-    Vec4 PreviousCameraPosition;
-    int  IvyStemSurfaceIndex;
-    int  IvyLeafSurfaceIndex;
+    Mat4     ViewProjection;
+    Mat4     PreviousViewProjection;
+    Mat4     InverseViewProjection;
+    Vec4     CameraPosition;
+    Vec4     PreviousCameraPosition;
+    int      IvyStemSurfaceIndex;
+    int      IvyLeafSurfaceIndex;
+    uint32_t IvyFlags;
+    uint32_t IvyHitCacheEpoch;
+    // xyz: minimum of distance field bounds, w: unused
+    Vec4     SdfBoundsMin;
+    uint32_t SdfBrickGridSize[3];
+    // Recursion levels grown per frame, see IVY_FLAG_PROGRESSIVE_GROWTH
+    uint32_t IvyProgressiveLevels;
+    // Frontier progressive growth appends deferred records to, see IVY_FRONTIER
+    uint32_t IvyFrontierWriteIndex;
+    // Growth cache appended to in this frame, see IVY_GROWTH_CACHE
+    uint32_t IvyGrowthCacheWriteIndex;
+    // Number of entry records, cached transforms of other roots are dropped
+    uint32_t IvyRootCount;
+    // Roots in [IvyRegenerationStart; IvyRegenerationStart + IvyRegenerationCount) are regenerated in this frame, see IVY_FLAG_TEMPORAL_REGENERATION
+    uint32_t IvyRegenerationStart;
+    uint32_t IvyRegenerationCount;
+    // Animation time of this & the previous frame in seconds, see IVY_FLAG_WIND
+    float    IvyWindTime;
+    float    IvyPreviousWindTime;
+    // Bending amplitude at IVY_MAX_RECURSION in meters
+    float    IvyWindStrength;
+    // xyz: normalized wind direction, w: unused
+    Vec4     IvyWindDirection;
+    // xyz: center & half extents of the object-space bounding boxes of the stem & leaf meshes, w: unused
+    Vec4     IvyStemBoundsCenter;
+    Vec4     IvyStemBoundsExtents;
+    Vec4     IvyLeafBoundsCenter;
+    Vec4     IvyLeafBoundsExtents;
+    // Size of the GBufferDepth region, i.e. of the viewport, the HiZ pyramid was built from & its number of mips, see IVY_HIZ & IVY_FLAG_MESHLET_CULLING
+    uint32_t HiZDepthSize[2];
+    uint32_t HiZMipCount;
+    // Distance to the camera beyond which leaves are drawn as cards, see IVY_FLAG_LEAF_CARDS
+    float    IvyLeafCardDistance;
+    // Additional views drawn from the growth cache, e.g. shadow maps; growth tests each cached instance against all of them once, see IVY_MAX_VIEWS
+    Mat4     IvyViewProjections[IVY_MAX_VIEWS];
+    uint32_t IvyViewCount;
 };
 #else
 cbuffer WorkGraphCBData : register(b0)
@@ -46,18 +85,118 @@ cbuffer WorkGraphCBData : register(b0)
     float4 PreviousCameraPosition;
     int    IvyStemSurfaceIndex;
     int    IvyLeafSurfaceIndex;
+    uint   IvyFlags;
+    uint   IvyHitCacheEpoch;
+    float4 SdfBoundsMin;
+    uint3  SdfBrickGridSize;
+    uint   IvyProgressiveLevels;
+    uint   IvyFrontierWriteIndex;
+    uint   IvyGrowthCacheWriteIndex;
+    uint   IvyRootCount;
+    uint   IvyRegenerationStart;
+    uint   IvyRegenerationCount;
+    float  IvyWindTime;
+    float  IvyPreviousWindTime;
+    float  IvyWindStrength;
+    float4 IvyWindDirection;
+    float4 IvyStemBoundsCenter;
+    float4 IvyStemBoundsExtents;
+    float4 IvyLeafBoundsCenter;
+    float4 IvyLeafBoundsExtents;
+    uint2  HiZDepthSize;
+    uint   HiZMipCount;
+    float  IvyLeafCardDistance;
+    matrix IvyViewProjections[IVY_MAX_VIEWS];
+    uint   IvyViewCount;
+}
+#endif  // __cplusplus
+
+// Constants of a single shadow map render target, see IvyShadowCacheDraw
+#if __cplusplus
+struct IvyShadowCBData
+{
+    // Views of IvyViewProjections drawn into the render target; view v is drawn into viewport v
+    uint32_t ShadowViewMask;
+};
+#else
+cbuffer IvyShadowCBData : register(b1)
+{
+    uint ShadowViewMask;
 }
 #endif  // __cplusplus
 
+// Constants of a single mip of the HiZ pyramid builder, see hiz.hlsl
+#if __cplusplus
+struct HiZCBData
+{
+    // Size of the mip read, or of the GBufferDepth region for mip 0
+    uint32_t SourceSize[2];
+    uint32_t DestinationSize[2];
+    uint32_t DestinationMip;
+    uint32_t InvertedDepth;
+};
+#else
+cbuffer HiZCBData : register(b2)
+{
+    uint2 SourceSize;
+    uint2 DestinationSize;
+    uint  DestinationMip;
+    uint  InvertedDepth;
+}
+#endif  // __cplusplus
+
+// Bits for WorkGraphCBData::IvyFlags
+#define IVY_FLAG_POISSON_AREA_SAMPLING (1 << 0)
+#define IVY_FLAG_STATISTICS            (1 << 1)
+#define IVY_FLAG_LINEAGE_TRACE         (1 << 2)
+#define IVY_FLAG_OUTPUT_DIGEST         (1 << 3)
+#define IVY_FLAG_ADAPTIVE_PROBING      (1 << 4)
+#define IVY_FLAG_HIT_CACHE             (1 << 5)
+#define IVY_FLAG_SDF_QUERIES           (1 << 6)
+#define IVY_FLAG_PROGRESSIVE_GROWTH    (1 << 7)
+#define IVY_FLAG_TEMPORAL_REGENERATION (1 << 8)
+#define IVY_FLAG_WIND                  (1 << 9)
+// Growth appends stems & leaves to the growth cache; set by progressive growth, temporal regeneration & ivy shadows
+#define IVY_FLAG_GROWTH_CACHE          (1 << 10)
+// Stems & leaves outside the view or behind the HiZ pyramid aren't drawn into the GBuffer, see IVY_HIZ
+#define IVY_FLAG_OCCLUSION_CULLING     (1 << 11)
+// Depth buffer stores 1 at the near plane & 0 at the far plane
+#define IVY_FLAG_INVERTED_DEPTH        (1 << 12)
+// Distant leaves of an IvyBranch record collapse into a single textured card, see IVY_LEAF_CARD_MASK
+#define IVY_FLAG_LEAF_CARDS            (1 << 13)
+// Back-facing, off-screen & sub-pixel meshlets and triangles of stems & leaves aren't rasterized, see IVY_MESHLETS
+#define IVY_FLAG_MESHLET_CULLING       (1 << 14)
+
+// Maximum recursion depth of IvyBranch, including levels grown in previous frames
+#define IVY_MAX_RECURSION 12
+
+// Frequencies of branch bending & leaf flutter in Hz, see IVY_FLAG_WIND
+#define IVY_WIND_FREQUENCY         0.4f
+#define IVY_WIND_FLUTTER_FREQUENCY 2.2f
+// Wind time wraps after this many seconds; it's a multiple of both periods, thus the animation stays continuous
+#define IVY_WIND_TIME_PERIOD       500.f
+
 // Entry node records
 struct IvyBranchRecord
 {
 #if __cplusplus
     Mat4         transform;
     unsigned int seed;
+    // Index of entry record the branch originates from, see IVY_ROOT_STATISTICS
+    unsigned int rootIndex;
+    // Lineage trace id of parent IvyBranch invocation, 0 if seeded by an entry record or by an area
+    unsigned int parentId;
+    // Number of consecutive iterations which continued on the same plane, see IVY_FLAG_ADAPTIVE_PROBING
+    unsigned int coplanarRun;
+    // Recursion levels grown in previous frames, see IVY_FLAG_PROGRESSIVE_GROWTH
+    unsigned int baseDepth;
 #else
     float4x4     transform;
     unsigned int seed;
+    unsigned int rootIndex;
+    unsigned int parentId;
+    unsigned int coplanarRun;
+    unsigned int baseDepth;
 #endif  // __cplusplus
 };
 
@@ -67,10 +206,42 @@ struct IvyAreaRecord
     Mat4         transform;
     unsigned int seed;
     float        density;
+    // Triangles of surface sampling table in [surfaceTriangleOffset; surfaceTriangleOffset + surfaceTriangleCount)
+    // If surfaceTriangleCount is zero, the area is sampled by tracing rays downwards
+    unsigned int surfaceTriangleOffset;
+    unsigned int surfaceTriangleCount;
+    float        surfaceArea;
+    // Index of entry record, see IVY_ROOT_STATISTICS
+    unsigned int rootIndex;
 #else
     float4x4     transform;
     unsigned int seed;
     float        density;
+    unsigned int surfaceTriangleOffset;
+    unsigned int surfaceTriangleCount;
+    float        surfaceArea;
+    unsigned int rootIndex;
+#endif  // __cplusplus
+};
+
+// Alias table entry for sampling triangles proportional to their area.
+// cross(edge1, edge2) points along the surface normal.
+struct SurfaceSamplingTriangle
+{
+#if __cplusplus
+    float        vertex[3];
+    float        probability;
+    float        edge1[3];
+    unsigned int alias;
+    float        edge2[3];
+    float        padding;
+#else
+    float3       vertex;
+    float        probability;
+    float3       edge1;
+    unsigned int alias;
+    float3       edge2;
+    float        padding;
 #endif  // __cplusplus
 };
 
@@ -83,6 +254,214 @@ struct IvyAreaRecord
 #define RAYTRACING_INFO_SURFACE_ID 22
 #define RAYTRACING_INFO_SURFACE    23
 
+#define AREA_POISSON_DISK_POINTS      24
+#define AREA_POISSON_DISK_POINT_COUNT 4096
+
+#define AREA_SURFACE_SAMPLING_TRIANGLES 25
+
+// SRV slots of baked sparse distance field, only used if IVY_FLAG_SDF_QUERIES is set or ray queries are unavailable, see distancefield.h.
+// Brick indices hold one uint per brick grid cell: the index of its brick, or IVY_SDF_EMPTY_BRICK | chessboard distance (in cells) to the next brick.
+#define IVY_SDF_BRICK_INDICES      26
+#define IVY_SDF_BRICKS             27
+#define IVY_SDF_VOXEL_SIZE         0.04f
+// Samples per brick axis; bricks of adjacent cells duplicate their shared border samples
+#define IVY_SDF_BRICK_SAMPLES      8
+#define IVY_SDF_BRICK_EXTENT       ((IVY_SDF_BRICK_SAMPLES - 1) * IVY_SDF_VOXEL_SIZE)
+// Four 8-bit distances are packed into each uint
+#define IVY_SDF_BRICK_WORD_COUNT   (IVY_SDF_BRICK_SAMPLES * IVY_SDF_BRICK_SAMPLES * IVY_SDF_BRICK_SAMPLES / 4)
+// Distances inside bricks are quantized in [0; IVY_SDF_MAX_DISTANCE], rounding down
+#define IVY_SDF_MAX_DISTANCE       (4 * IVY_SDF_VOXEL_SIZE)
+// Minimum distance of all points in an empty brick to the nearest surface
+#define IVY_SDF_EMPTY_BRICK_MARGIN IVY_SDF_VOXEL_SIZE
+#define IVY_SDF_EMPTY_BRICK        0x80000000u
+
+#define IVY_STEM_RADIUS     0.01f
+// Maximum vertex displacement of simplified proxy geometry; stems can't follow detail finer than their diameter, see proxygeometry.h
+#define IVY_PROXY_TOLERANCE (2 * IVY_STEM_RADIUS)
+
+// SRV slots of flattened face normals, which spare TraceRay the index & vertex buffer fetches of committed hits.
+// Face normal offsets hold the first face normal of each surface, parallel to the surface ID table (RAYTRACING_INFO_SURFACE_ID).
+// Face normals hold one octahedral-encoded (16:16) object-space normal per triangle; 0 until the geometry was read back.
+#define IVY_FACE_NORMAL_OFFSETS 28
+#define IVY_FACE_NORMALS        29
+// Face normal offset of surfaces without face normals, i.e. ivy & translucent surfaces
+#define IVY_FACE_NORMAL_NONE    0xFFFFFFFFu
+
+// SRV slot of the HiZ pyramid of GBufferDepth, only read if IVY_FLAG_OCCLUSION_CULLING is set, see hiz.h.
+// Mip 0 has half the size of the depth region (rounded down); each texel holds the farthest depth of the 2x2 texels it covers,
+// and the last texel of a row or column also covers the remaining texel of an odd-sized source.
+#define IVY_HIZ          30
+#define IVY_HIZ_MAX_MIPS 16
+// Slots of the HiZ pyramid builder: GBufferDepth & one UAV per mip
+#define IVY_HIZ_BUILD_DEPTH 0
+#define IVY_HIZ_BUILD_MIPS  0
+
+// SRV & UAV slot of the leaf card mask, baked once from the leaf mesh by IvyLeafCardMaskBake.
+// Texels cover the xz bounding rectangle of the leaf mesh; xy: texture coordinate of the leaf surface, z: 1 if covered by the leaf, w: unused.
+#define IVY_LEAF_CARD_MASK      31
+#define IVY_LEAF_CARD_MASK_BAKE 9
+#define IVY_LEAF_CARD_MASK_SIZE 128
+
+// UAV slot of the meshlets of the stem & leaf mesh, baked once by IvyMeshletBake after both meshes were loaded.
+// Layout per mesh (in uints): meshlet count, IVY_MESHLET_MAX_COUNT meshlet headers, the mesh vertex indices of all meshlets
+// & their triangles, packed as three 8-bit meshlet-local vertex indices each.
+// Header: vertex offset, vertex count, triangle offset, triangle count, object-space bounding sphere (xyz: center, w: radius)
+// & normal cone (xyz: axis, w: sine of the cone angle, 1 if the cone can't cull).
+#define IVY_MESHLETS                   10
+#define IVY_MESHLET_MAX_VERTICES       64
+#define IVY_MESHLET_MAX_TRIANGLES      32
+#define IVY_MESHLET_MAX_COUNT          8
+// Vertices of all meshlets of a mesh, including vertices duplicated across meshlets
+#define IVY_MESHLET_MESH_MAX_VERTICES  256
+#define IVY_MESHLET_MESH_MAX_TRIANGLES (IVY_MESHLET_MAX_COUNT * IVY_MESHLET_MAX_TRIANGLES)
+#define IVY_MESHLET_HEADER_SIZE        12
+#define IVY_MESHLET_COUNT              0
+#define IVY_MESHLET_HEADERS            4
+#define IVY_MESHLET_VERTICES           (IVY_MESHLET_HEADERS + IVY_MESHLET_MAX_COUNT * IVY_MESHLET_HEADER_SIZE)
+#define IVY_MESHLET_TRIANGLES          (IVY_MESHLET_VERTICES + IVY_MESHLET_MESH_MAX_VERTICES)
+#define IVY_MESHLET_MESH_SIZE          (IVY_MESHLET_TRIANGLES + IVY_MESHLET_MESH_MAX_TRIANGLES)
+#define IVY_MESHLET_STEM               0
+#define IVY_MESHLET_LEAF               1
+#define IVY_MESHLETS_SIZE              (2 * IVY_MESHLET_MESH_SIZE)
+
+// UAV slot of growth statistics counters, only written if IVY_FLAG_STATISTICS is set
+#define IVY_STATISTICS 0
+
+// Indices of growth statistics counters
+#define IVY_STATISTIC_FORWARD_RAYS         0
+#define IVY_STATISTIC_DOWNWARD_RAYS        1
+#define IVY_STATISTIC_RANDOM_RAYS          2
+#define IVY_STATISTIC_AREA_RAYS            3
+#define IVY_STATISTIC_AREA_SEEDS           4
+#define IVY_STATISTIC_CLAMPED_AREA_SAMPLES 5
+#define IVY_STATISTIC_STEMS                6
+#define IVY_STATISTIC_LEAVES               7
+#define IVY_STATISTIC_PLANAR_ITERATIONS    8
+// Ray queries of IvyBranch looked up in & answered by the hit cache, see IVY_FLAG_HIT_CACHE
+#define IVY_STATISTIC_HIT_CACHE_LOOKUPS    9
+#define IVY_STATISTIC_HIT_CACHE_HITS       10
+// Stems & leaves not drawn into the GBuffer, see IVY_FLAG_OCCLUSION_CULLING
+#define IVY_STATISTIC_CULLED_STEMS         11
+#define IVY_STATISTIC_CULLED_LEAVES        12
+// Leaf cards drawn & leaves collapsed into them, see IVY_FLAG_LEAF_CARDS
+#define IVY_STATISTIC_LEAF_CARDS           13
+#define IVY_STATISTIC_CARD_LEAVES          14
+// Meshlets of drawn stems & leaves which weren't rasterized, see IVY_FLAG_MESHLET_CULLING
+#define IVY_STATISTIC_CULLED_MESHLETS      15
+// Number of IvyBranch records per recursion depth
+#define IVY_STATISTIC_DEPTH_HISTOGRAM      16
+#define IVY_STATISTIC_DEPTH_HISTOGRAM_SIZE 16
+#define IVY_STATISTIC_COUNT                32
+
+// UAV slot of per-root statistics counters, only written if IVY_FLAG_STATISTICS is set.
+// Ivy branches use root indices [0; branchCount), ivy areas [branchCount; branchCount + areaCount).
+#define IVY_ROOT_STATISTICS 1
+
+// Indices of per-root statistics counters
+#define IVY_ROOT_STATISTIC_RAYS      0
+#define IVY_ROOT_STATISTIC_STEMS     1
+#define IVY_ROOT_STATISTIC_LEAVES    2
+#define IVY_ROOT_STATISTIC_MAX_DEPTH 3
+#define IVY_ROOT_STATISTIC_COUNT     4
+
+// UAV slot of lineage trace, only written if IVY_FLAG_LINEAGE_TRACE is set.
+// Layout (in uints): IVY_LINEAGE_TRACE_HEADER_SIZE header, followed by IVY_LINEAGE_TRACE_CAPACITY IvyLineageTraceEntry.
+// The first header element counts all appended entries, including entries dropped because the capacity was exceeded.
+#define IVY_LINEAGE_TRACE             2
+#define IVY_LINEAGE_TRACE_HEADER_SIZE 4
+#define IVY_LINEAGE_TRACE_ENTRY_SIZE  4
+#define IVY_LINEAGE_TRACE_CAPACITY    (1 << 18)
+
+// Bits of IvyLineageTraceEntry::flags
+#define IVY_LINEAGE_DEPTH_MASK             0xF
+// Outcome of each iteration, two bits per iteration
+#define IVY_LINEAGE_OUTCOME_SHIFT          4
+#define IVY_LINEAGE_OUTCOME_MASK           0x3
+#define IVY_LINEAGE_OUTCOME_FORWARD_HIT    0
+#define IVY_LINEAGE_OUTCOME_DOWNWARD_HIT   1
+#define IVY_LINEAGE_OUTCOME_RANDOM_HIT     2
+#define IVY_LINEAGE_OUTCOME_FREE_FALL      3
+#define IVY_LINEAGE_MAX_ITERATIONS         4
+#define IVY_LINEAGE_HAS_NEXT               (1 << 12)
+#define IVY_LINEAGE_HAS_BRANCH             (1 << 13)
+// Iteration in which the branch forked
+#define IVY_LINEAGE_BRANCH_ITERATION_SHIFT 14
+#define IVY_LINEAGE_BRANCH_ITERATION_MASK  0x3
+
+// UAV slot of 64-bit output digests, one per root, only written if IVY_FLAG_OUTPUT_DIGEST is set.
+// The digest of a root is the wrapping sum of the hashes of all its stem & leaf transforms, thus it doesn't depend on output order.
+#define IVY_OUTPUT_DIGESTS 3
+
+// Seeds to distinguish stem & leaf transforms in output digests
+#define IVY_OUTPUT_DIGEST_STEM 1
+#define IVY_OUTPUT_DIGEST_LEAF 2
+
+// UAV slot of spatial hit cache, only accessed if IVY_FLAG_HIT_CACHE is set.
+// Direct-mapped hash grid of IVY_HIT_CACHE_CAPACITY IvyHitCacheEntry, keyed by ray origin cell, direction bin, tMax & IvyHitCacheEpoch.
+#define IVY_HIT_CACHE                      4
+#define IVY_HIT_CACHE_CAPACITY             (1 << 18)
+// Edge length of ray origin cells
+#define IVY_HIT_CACHE_CELL_SIZE            0.02f
+// Number of direction bins per axis of the octahedral direction mapping
+#define IVY_HIT_CACHE_DIRECTION_RESOLUTION 16
+
+// Cached result of a ray query. Normal is zero if the ray missed, key is zero if the entry is empty.
+// Entries are written without synchronization, thus the checksum is used to reject torn entries.
+struct IvyHitCacheEntry
+{
+#if __cplusplus
+    unsigned int key;
+    float        position[3];
+    float        normal[3];
+    unsigned int checksum;
+#else
+    unsigned int key;
+    float3       position;
+    float3       normal;
+    unsigned int checksum;
+#endif  // __cplusplus
+};
+
+// UAV slots of progressive growth & temporal regeneration, only accessed if either flag is set.
+// The frontier holds IvyBranch records deferred to the next frame. It starts with a D3D12_NODE_GPU_INPUT,
+// such that it can be passed to DispatchGraph directly, followed by an append counter. Offsets & sizes are in uints.
+// Two frontiers are bound as array; growth appends to the frontier at IvyFrontierWriteIndex, while the other one is dispatched.
+#define IVY_FRONTIER                       5
+#define IVY_FRONTIER_CAPACITY              (1 << 14)
+// D3D12_NODE_GPU_INPUT::NumRecords, only counts records below IVY_FRONTIER_CAPACITY
+#define IVY_FRONTIER_RECORD_COUNT          1
+#define IVY_FRONTIER_APPEND_COUNTER        6
+#define IVY_FRONTIER_RECORDS               64
+// Size of IvyBranchRecord in node records: transform (column-major), seed, rootIndex, parentId, coplanarRun & baseDepth
+#define IVY_FRONTIER_RECORD_SIZE           21
+// The growth cache holds stem & leaf transforms grown in previous frames, used by IVY_FLAG_PROGRESSIVE_GROWTH & IVY_FLAG_TEMPORAL_REGENERATION.
+// Two caches are bound as array: each frame draws the cache of the previous frame, copies transforms of roots which aren't regenerated
+// to the cache at IvyGrowthCacheWriteIndex, and growth appends newly generated transforms to it.
+// Once growth completed, the cache at IvyGrowthCacheWriteIndex holds all ivy of the frame & is drawn into the shadow maps.
+#define IVY_GROWTH_CACHE                   7
+#define IVY_GROWTH_CACHE_STEM_CAPACITY     (1 << 17)
+#define IVY_GROWTH_CACHE_LEAF_CAPACITY     (1 << 18)
+// Counts include transforms dropped at capacity
+#define IVY_GROWTH_CACHE_STEM_COUNT        0
+#define IVY_GROWTH_CACHE_LEAF_COUNT        1
+#define IVY_GROWTH_CACHE_STEMS             4
+// Size of a cache entry: transform (row-major float3x4), wind data, root index & the views of this frame the entry may be visible in
+#define IVY_GROWTH_CACHE_ENTRY_SIZE        15
+#define IVY_GROWTH_CACHE_ENTRY_WIND_DATA   12
+#define IVY_GROWTH_CACHE_ENTRY_ROOT_INDEX  13
+#define IVY_GROWTH_CACHE_ENTRY_VIEW_MASK   14
+#define IVY_GROWTH_CACHE_LEAVES            (IVY_GROWTH_CACHE_STEMS + IVY_GROWTH_CACHE_STEM_CAPACITY * IVY_GROWTH_CACHE_ENTRY_SIZE)
+#define IVY_GROWTH_CACHE_SIZE              (IVY_GROWTH_CACHE_LEAVES + IVY_GROWTH_CACHE_LEAF_CAPACITY * IVY_GROWTH_CACHE_ENTRY_SIZE)
+
+// Lineage of a single IvyBranch invocation. Its id is 1 + index of the entry in the trace.
+struct IvyLineageTraceEntry
+{
+    unsigned int parentId;
+    unsigned int seed;
+    unsigned int rootIndex;
+    unsigned int flags;
+};
+
 #define TEXTURE_BEGIN_SLOT 50
 #define SAMPLER_BEGIN_SLOT    10
 
@@ -92,9 +471,11 @@ struct IvyAreaRecord
 #define MAX_BUFFER_COUNT 20000
 
 #define DECLARE_SRV_REGISTER(regIndex)     t##regIndex
+#define DECLARE_UAV_REGISTER(regIndex)     u##regIndex
 #define DECLARE_SAMPLER_REGISTER(regIndex) s##regIndex
 
 #define DECLARE_SRV(regIndex)     register(DECLARE_SRV_REGISTER(regIndex))
+#define DECLARE_UAV(regIndex)     register(DECLARE_UAV_REGISTER(regIndex))
 #define DECLARE_SAMPLER(regIndex) register(DECLARE_SAMPLER_REGISTER(regIndex))
 
 #define SURFACE_INFO_INDEX_TYPE_U32 0
@@ -0,0 +1,246 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "common.hlsl"
+#include "raytracing.hlsl"
+
+// Distant leaves collapsed into cards, see IVY_FLAG_LEAF_CARDS.
+// A card is a single quad in the surface plane of its branch; its pixels look up every leaf sprite of the card in the leaf card mask.
+
+Texture2D<float4>   g_ivy_leaf_card_mask : DECLARE_SRV(IVY_LEAF_CARD_MASK);
+RWTexture2D<float4> g_ivy_leaf_card_mask_bake : DECLARE_UAV(IVY_LEAF_CARD_MASK_BAKE);
+
+static const uint leafCardMaskBakeGroupSize = 8;
+
+// Returns the texture coordinate of the leaf mesh triangle covering a position in the xz plane of the leaf, if any
+bool GetLeafTexCoord(in Surface_Info sinfo, float2 position, out float2 texCoord)
+{
+    texCoord = 0.f;
+
+    const int triangleCount = sinfo.num_indices / 3;
+
+    for (int triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+    {
+        const uint3 indices = (sinfo.index_type == SURFACE_INFO_INDEX_TYPE_U16) ? FetchIndicesU16(sinfo.index_offset, triangleIndex)
+                                                                                 : FetchIndicesU32(sinfo.index_offset, triangleIndex);
+
+        const float2 p0 = FetchFloat3(sinfo.position_attribute_offset, indices.x).xz;
+        const float2 p1 = FetchFloat3(sinfo.position_attribute_offset, indices.y).xz;
+        const float2 p2 = FetchFloat3(sinfo.position_attribute_offset, indices.z).xz;
+
+        // Barycentric coordinates, independent of triangle winding
+        const float area = (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+        if (abs(area) < 1e-12f)
+        {
+            continue;
+        }
+
+        const float b1 = ((position.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (position.y - p0.y)) / area;
+        const float b2 = ((p1.x - p0.x) * (position.y - p0.y) - (position.x - p0.x) * (p1.y - p0.y)) / area;
+        const float b0 = 1.f - b1 - b2;
+
+        if ((b0 >= 0.f) && (b1 >= 0.f) && (b2 >= 0.f))
+        {
+            texCoord = b0 * FetchFloat2(sinfo.texcoord0_attribute_offset, indices.x) +  //
+                       b1 * FetchFloat2(sinfo.texcoord0_attribute_offset, indices.y) +  //
+                       b2 * FetchFloat2(sinfo.texcoord0_attribute_offset, indices.z);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Bakes the leaf card mask from the leaf mesh. Dispatched once after the leaf mesh was loaded.
+[Shader("node")]
+[NodeIsProgramEntry]
+[NodeLaunch("broadcasting")]
+[NodeDispatchGrid(IVY_LEAF_CARD_MASK_SIZE / leafCardMaskBakeGroupSize, IVY_LEAF_CARD_MASK_SIZE / leafCardMaskBakeGroupSize, 1)]
+[NumThreads(leafCardMaskBakeGroupSize, leafCardMaskBakeGroupSize, 1)]
+void IvyLeafCardMaskBake(uint2 dispatchThreadId : SV_DispatchThreadID)
+{
+    const float2 maskUv   = (dispatchThreadId + 0.5f) / IVY_LEAF_CARD_MASK_SIZE;
+    const float2 position = IvyLeafBoundsCenter.xz + (maskUv * 2.f - 1.f) * IvyLeafBoundsExtents.xz;
+
+    float4 texel = 0.f;
+
+    if (IvyLeafSurfaceIndex >= 0)
+    {
+        float2 texCoord;
+        if (GetLeafTexCoord(g_surface_info.Load(IvyLeafSurfaceIndex), position, texCoord))
+        {
+            texel = float4(texCoord, 1.f, 0.f);
+        }
+    }
+
+    g_ivy_leaf_card_mask_bake[dispatchThreadId] = texel;
+}
+
+// Vertex output struct for mesh shader
+struct LeafCardVertexOutputAttributes
+{
+    float4                 clipSpacePosition : SV_Position;
+    // Position in the card plane, relative to the card origin
+    float2                 cardPosition : TEXCOORD0;
+    float2                 clipSpaceMotion : TEXCOORD1;
+    nointerpolation float3 normal : NORMAL0;
+    nointerpolation uint4  sprites0 : TEXCOORD2;
+    nointerpolation uint4  sprites1 : TEXCOORD3;
+    nointerpolation uint   leafCount : TEXCOORD4;
+    nointerpolation int    materialId : BLENDINDICES0;
+};
+
+static const uint leafCardThreadGroupSize = 4 * maxCardsPerRecord;
+static const uint numCardOutputVertices   = 4 * maxCardsPerRecord;
+static const uint numCardOutputTriangles  = 2 * maxCardsPerRecord;
+
+[Shader("node")]
+[NodeLaunch("mesh")]
+[NodeId("DrawIvyLeafCard", 0)]
+[NodeMaxDispatchGrid(1, 1, 1)]
+[NumThreads(leafCardThreadGroupSize, 1, 1)]
+[OutputTopology("triangle")]
+void IvyLeafCardMeshShader(
+    uint threadIndex : SV_GroupThreadId,
+    DispatchNodeInputRecord<DrawIvyLeafCardRecord> inputRecord,
+    out indices uint3 tris[numCardOutputTriangles],
+    out vertices LeafCardVertexOutputAttributes verts[numCardOutputVertices])
+{
+    const uint cardCount = inputRecord.Get().cardCount;
+
+    SetMeshOutputCounts(4 * cardCount, 2 * cardCount);
+
+    AddWaveStatistic(IVY_STATISTIC_LEAF_CARDS, threadIndex < cardCount);
+    AddWaveStatistic(IVY_STATISTIC_CARD_LEAVES, (threadIndex < cardCount) ? inputRecord.Get().leafCount[threadIndex] : 0);
+
+    // Four threads per card, one per corner
+    const uint card   = threadIndex / 4;
+    const uint corner = threadIndex % 4;
+
+    if (card < cardCount)
+    {
+        const float4x4 transform = ToFloat4x4(inputRecord.Get().transform[card]);
+        const float4   rect      = inputRecord.Get().rect[card];
+        const uint     windData  = inputRecord.Get().windData[card];
+
+        const float2 cardPosition               = float2((corner & 1) ? rect.z : rect.x, (corner & 2) ? rect.w : rect.y);
+        float4       worldSpacePosition         = mul(transform, float4(cardPosition.x, 0, cardPosition.y, 1));
+        float4       previousWorldSpacePosition = worldSpacePosition;
+
+        if (IvyFlags & IVY_FLAG_WIND)
+        {
+            worldSpacePosition.xyz += GetWindOffset(windData, IvyWindTime);
+            previousWorldSpacePosition.xyz += GetWindOffset(windData, IvyPreviousWindTime);
+        }
+
+        const uint spriteOffset = card * maxLeavesPerCard;
+
+        LeafCardVertexOutputAttributes vertex;
+        vertex.clipSpacePosition = mul(ViewProjection, worldSpacePosition);
+        vertex.cardPosition      = cardPosition;
+        vertex.normal            = mul((float3x3)transform, float3(0, 1, 0));
+        vertex.sprites0          = uint4(inputRecord.Get().sprites[spriteOffset + 0],
+                                         inputRecord.Get().sprites[spriteOffset + 1],
+                                         inputRecord.Get().sprites[spriteOffset + 2],
+                                         inputRecord.Get().sprites[spriteOffset + 3]);
+        vertex.sprites1          = uint4(inputRecord.Get().sprites[spriteOffset + 4],
+                                         inputRecord.Get().sprites[spriteOffset + 5],
+                                         inputRecord.Get().sprites[spriteOffset + 6],
+                                         inputRecord.Get().sprites[spriteOffset + 7]);
+        vertex.leafCount         = inputRecord.Get().leafCount[card];
+        vertex.materialId        = (IvyLeafSurfaceIndex >= 0) ? g_surface_info.Load(IvyLeafSurfaceIndex).material_id : 0;
+
+        const float4 previousClipSpacePosition = mul(PreviousViewProjection, previousWorldSpacePosition);
+        vertex.clipSpaceMotion = (previousClipSpacePosition.xy / previousClipSpacePosition.w) - (vertex.clipSpacePosition.xy / vertex.clipSpacePosition.w);
+
+        verts[threadIndex] = vertex;
+    }
+
+    if (threadIndex < 2 * cardCount)
+    {
+        // Two threads per card, one per triangle
+        const uint firstVertex    = (threadIndex / 2) * 4;
+        const uint secondTriangle = threadIndex & 1;
+
+        tris[threadIndex] = firstVertex + uint3(secondTriangle, 1 + 2 * secondTriangle, 2);
+    }
+}
+
+DeferredPixelShaderOutput PixelShader(in LeafCardVertexOutputAttributes input)
+{
+    // Later leaves of a card are drawn on top of earlier ones
+    float2 texCoord = 0.f;
+    bool   covered  = false;
+
+    for (uint sprite = 0; sprite < input.leafCount; ++sprite)
+    {
+        const uint packedSprite = (sprite < 4) ? input.sprites0[sprite] : input.sprites1[sprite - 4];
+
+        float2 offset;
+        float  angle;
+        float  scale;
+        UnpackLeafCardSprite(packedSprite, offset, angle, scale);
+
+        // Undo sprite rotation & foreshortening to get the position in the xz plane of the leaf
+        float sinAngle, cosAngle;
+        sincos(angle, sinAngle, cosAngle);
+
+        const float2 relativePosition = input.cardPosition - offset;
+        const float2 leafPosition     = float2((cosAngle * relativePosition.x + sinAngle * relativePosition.y) / max(scale, 1e-3f),
+                                               -sinAngle * relativePosition.x + cosAngle * relativePosition.y);
+
+        const float2 maskUv = (leafPosition - IvyLeafBoundsCenter.xz) / (2.f * IvyLeafBoundsExtents.xz) + 0.5f;
+
+        if (all(maskUv >= 0.f) && all(maskUv < 1.f))
+        {
+            const float4 mask = g_ivy_leaf_card_mask.Load(int3(maskUv * IVY_LEAF_CARD_MASK_SIZE, 0));
+
+            if (mask.z > 0.5f)
+            {
+                texCoord = mask.xy;
+                covered  = true;
+            }
+        }
+    }
+
+    if (!covered)
+    {
+        discard;
+    }
+
+    DeferredPixelShaderOutput output;
+
+    Material_Info material = g_material_info.Load(input.materialId);
+
+    output.albedo = 1.f;
+
+    if (material.albedo_tex_id >= 0)
+    {
+        output.albedo = output.albedo * g_textures[material.albedo_tex_id].Sample(g_samplers[material.albedo_tex_sampler_id], texCoord);
+    }
+
+    output.normal.xyz          = input.normal;
+    output.normal.a            = 1;
+    output.aoMetallicRoughness = float4(material.arm_factor_x, material.arm_factor_y, material.arm_factor_z, 0);
+    output.motion              = input.clipSpaceMotion;
+
+    return output;
+}
@@ -0,0 +1,326 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "common.hlsl"
+
+// Depth-only work graph drawing the growth cache written in this frame into all shadow maps of a render target.
+// Stems & leaves are drawn as simplified LODs derived from the bounding boxes of their meshes,
+// and many instances share a thread group, as each LOD only has a few vertices.
+// Growth already tested each cache entry against all views, thus the draw nodes only read the view masks of the entries:
+// the second dimension of their dispatch grid enumerates the views of a record, each drawn into its own viewport.
+
+// Each thread group of IvyShadowCacheDraw emits one record worth of stems & leaves
+static const uint ivyShadowCacheDrawGroupCount = IVY_GROWTH_CACHE_LEAF_CAPACITY / maxLeavesPerRecord;
+
+static const uint ivyShadowThreadGroupSize = 128;
+// Stems are drawn as boxes
+static const uint ivyShadowStemVertices   = 8;
+static const uint ivyShadowStemTriangles  = 12;
+static const uint ivyShadowStemsPerGroup  = ivyShadowThreadGroupSize / ivyShadowStemVertices;
+// Leaves are drawn as diamonds spanning their bounding box in the leaf plane
+static const uint ivyShadowLeafVertices   = 4;
+static const uint ivyShadowLeafTriangles  = 2;
+static const uint ivyShadowLeavesPerGroup = ivyShadowThreadGroupSize / ivyShadowLeafVertices;
+
+// Box corners are indexed by their sign bits (x: bit 0, y: bit 1, z: bit 2)
+static const uint3 ivyShadowBoxTriangles[ivyShadowStemTriangles] = {
+    uint3(0, 4, 6), uint3(0, 6, 2),  // -x
+    uint3(1, 3, 7), uint3(1, 7, 5),  // +x
+    uint3(0, 1, 5), uint3(0, 5, 4),  // -y
+    uint3(2, 6, 7), uint3(2, 7, 3),  // +y
+    uint3(0, 2, 3), uint3(0, 3, 1),  // -z
+    uint3(4, 5, 7), uint3(4, 7, 6),  // +z
+};
+
+// Diamond corners in the xz plane of the leaf, relative to the half extents of its bounding box
+static const float2 ivyShadowLeafCorners[ivyShadowLeafVertices] = {float2(-1, 0), float2(0, -1), float2(1, 0), float2(0, 1)};
+static const uint3  ivyShadowLeafIndices[ivyShadowLeafTriangles] = {uint3(0, 1, 2), uint3(0, 2, 3)};
+
+struct DrawIvyStemShadowRecord
+{
+    // x: groups per view, y: views of the record
+    uint2    groupCount : SV_DispatchGrid;
+    uint     stemCount;
+    // Views any stem of the record is drawn into
+    uint     viewMask;
+    float3x4 transform[maxStemsPerRecord];
+    uint     windData[maxStemsPerRecord];
+    uint     viewMasks[maxStemsPerRecord];
+};
+
+struct DrawIvyLeafShadowRecord
+{
+    // x: groups per view, y: views of the record
+    uint2    groupCount : SV_DispatchGrid;
+    uint     leafCount;
+    // Views any leaf of the record is drawn into
+    uint     viewMask;
+    float3x4 transform[maxLeavesPerRecord];
+    uint     windData[maxLeavesPerRecord];
+    uint     viewMasks[maxLeavesPerRecord];
+};
+
+struct ShadowVertexAttributes
+{
+    float4 clipSpacePosition : SV_Position;
+};
+
+struct ShadowPrimitiveAttributes
+{
+    uint viewportIndex : SV_ViewportArrayIndex;
+};
+
+groupshared uint shadowStemViewMask;
+groupshared uint shadowLeafViewMask;
+
+// Returns the index of the n-th view of a view mask
+uint GetShadowView(uint viewMask, uint n)
+{
+    for (uint i = 0; i < n; ++i)
+    {
+        viewMask &= viewMask - 1;
+    }
+
+    return firstbitlow(viewMask);
+}
+
+// Instances of the thread group drawn into its view
+groupshared uint shadowInstanceCount;
+groupshared uint shadowInstances[ivyShadowLeavesPerGroup];
+
+// Collects the instances in [firstInstance; firstInstance + instanceCount) of a record which are drawn into a view. Returns their count.
+uint GetShadowInstances(uint threadIndex, uint firstInstance, uint instanceCount, uint view, uint viewMask)
+{
+    if (threadIndex == 0)
+    {
+        shadowInstanceCount = 0;
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    if ((threadIndex < instanceCount) && (viewMask & (1u << view)))
+    {
+        uint instanceIndex;
+        InterlockedAdd(shadowInstanceCount, 1, instanceIndex);
+
+        shadowInstances[instanceIndex] = firstInstance + threadIndex;
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    return shadowInstanceCount;
+}
+
+// Draws all stems & leaves of the growth cache written in this frame. Growth appends densely, thus each group emits a prefix of its entries.
+[Shader("node")]
+[NodeIsProgramEntry]
+[NodeLaunch("broadcasting")]
+[NodeDispatchGrid(ivyShadowCacheDrawGroupCount, 1, 1)]
+[NumThreads(maxLeavesPerRecord, 1, 1)]
+void IvyShadowCacheDraw(
+    uint gid  : SV_GroupID,
+    uint gtid : SV_GroupThreadID,
+
+    [MaxRecords(1)]
+    [NodeId("DrawIvyStemShadow")]
+    NodeOutput<DrawIvyStemShadowRecord> drawStemOutput,
+
+    [MaxRecords(1)]
+    [NodeId("DrawIvyLeafShadow")]
+    NodeOutput<DrawIvyLeafShadowRecord> drawLeafOutput
+)
+{
+    RWStructuredBuffer<uint> cache = g_ivy_growth_caches[IvyGrowthCacheWriteIndex];
+
+    // Counters keep incrementing once the cache is full, thus counts are clamped to the capacity
+    const uint stemCount = min(cache[IVY_GROWTH_CACHE_STEM_COUNT], IVY_GROWTH_CACHE_STEM_CAPACITY);
+    const uint leafCount = min(cache[IVY_GROWTH_CACHE_LEAF_COUNT], IVY_GROWTH_CACHE_LEAF_CAPACITY);
+
+    const uint groupStemCount = min(stemCount - min(stemCount, gid * maxStemsPerRecord), maxStemsPerRecord);
+    const uint groupLeafCount = min(leafCount - min(leafCount, gid * maxLeavesPerRecord), maxLeavesPerRecord);
+
+    const uint stemOffset = IVY_GROWTH_CACHE_STEMS + (gid * maxStemsPerRecord + gtid) * IVY_GROWTH_CACHE_ENTRY_SIZE;
+    const uint leafOffset = IVY_GROWTH_CACHE_LEAVES + (gid * maxLeavesPerRecord + gtid) * IVY_GROWTH_CACHE_ENTRY_SIZE;
+
+    // Views of the render target each entry is drawn into
+    const uint stemViewMask = (gtid < groupStemCount) ? (cache[stemOffset + IVY_GROWTH_CACHE_ENTRY_VIEW_MASK] & ShadowViewMask) : 0;
+    const uint leafViewMask = (gtid < groupLeafCount) ? (cache[leafOffset + IVY_GROWTH_CACHE_ENTRY_VIEW_MASK] & ShadowViewMask) : 0;
+
+    if (gtid == 0)
+    {
+        shadowStemViewMask = 0;
+        shadowLeafViewMask = 0;
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    InterlockedOr(shadowStemViewMask, stemViewMask);
+    InterlockedOr(shadowLeafViewMask, leafViewMask);
+
+    GroupMemoryBarrierWithGroupSync();
+
+    // Records without any entry in a view of the render target are dropped
+    const uint groupStemViewMask = shadowStemViewMask;
+    const uint groupLeafViewMask = shadowLeafViewMask;
+
+    GroupNodeOutputRecords<DrawIvyStemShadowRecord> stemOutputRecord = drawStemOutput.GetGroupNodeOutputRecords(groupStemViewMask != 0);
+
+    if ((groupStemViewMask != 0) && (gtid < groupStemCount))
+    {
+        stemOutputRecord.Get().transform[gtid] = LoadGrowthCacheTransform(cache, stemOffset);
+        stemOutputRecord.Get().windData[gtid]  = cache[stemOffset + IVY_GROWTH_CACHE_ENTRY_WIND_DATA];
+        stemOutputRecord.Get().viewMasks[gtid] = stemViewMask;
+    }
+    if ((groupStemViewMask != 0) && (gtid == 0))
+    {
+        stemOutputRecord.Get().groupCount = uint2((groupStemCount + ivyShadowStemsPerGroup - 1) / ivyShadowStemsPerGroup, countbits(groupStemViewMask));
+        stemOutputRecord.Get().stemCount  = groupStemCount;
+        stemOutputRecord.Get().viewMask   = groupStemViewMask;
+    }
+
+    stemOutputRecord.OutputComplete();
+
+    GroupNodeOutputRecords<DrawIvyLeafShadowRecord> leafOutputRecord = drawLeafOutput.GetGroupNodeOutputRecords(groupLeafViewMask != 0);
+
+    if ((groupLeafViewMask != 0) && (gtid < groupLeafCount))
+    {
+        leafOutputRecord.Get().transform[gtid] = LoadGrowthCacheTransform(cache, leafOffset);
+        leafOutputRecord.Get().windData[gtid]  = cache[leafOffset + IVY_GROWTH_CACHE_ENTRY_WIND_DATA];
+        leafOutputRecord.Get().viewMasks[gtid] = leafViewMask;
+    }
+    if ((groupLeafViewMask != 0) && (gtid == 0))
+    {
+        leafOutputRecord.Get().groupCount = uint2((groupLeafCount + ivyShadowLeavesPerGroup - 1) / ivyShadowLeavesPerGroup, countbits(groupLeafViewMask));
+        leafOutputRecord.Get().leafCount  = groupLeafCount;
+        leafOutputRecord.Get().viewMask   = groupLeafViewMask;
+    }
+
+    leafOutputRecord.OutputComplete();
+}
+
+[Shader("node")]
+[NodeLaunch("mesh")]
+[NodeId("DrawIvyStemShadow", 0)]
+[NodeMaxDispatchGrid(maxStemsPerRecord / ivyShadowStemsPerGroup, IVY_MAX_VIEWS, 1)]
+[NumThreads(ivyShadowThreadGroupSize, 1, 1)]
+[OutputTopology("triangle")]
+void IvyStemShadowMeshShader(
+    uint threadIndex : SV_GroupThreadId,
+    uint2 groupIndex : SV_GroupId,
+    DispatchNodeInputRecord<DrawIvyStemShadowRecord> inputRecord,
+    out indices uint3 tris[ivyShadowStemsPerGroup * ivyShadowStemTriangles],
+    out primitives ShadowPrimitiveAttributes prims[ivyShadowStemsPerGroup * ivyShadowStemTriangles],
+    out vertices ShadowVertexAttributes verts[ivyShadowStemsPerGroup * ivyShadowStemVertices])
+{
+    const uint firstStem      = groupIndex.x * ivyShadowStemsPerGroup;
+    const uint groupStemCount = min(inputRecord.Get().stemCount - firstStem, ivyShadowStemsPerGroup);
+    const uint view           = GetShadowView(inputRecord.Get().viewMask, groupIndex.y);
+    const uint stemViewMask   = (threadIndex < groupStemCount) ? inputRecord.Get().viewMasks[firstStem + threadIndex] : 0;
+    const uint stemCount      = GetShadowInstances(threadIndex, firstStem, groupStemCount, view, stemViewMask);
+
+    SetMeshOutputCounts(stemCount * ivyShadowStemVertices, stemCount * ivyShadowStemTriangles);
+
+    // Each thread transforms one box corner
+    const uint stem = threadIndex / ivyShadowStemVertices;
+
+    if (stem < stemCount)
+    {
+        const uint   stemIndex     = shadowInstances[stem];
+        const uint   corner        = threadIndex % ivyShadowStemVertices;
+        const float3 cornerSign    = float3(corner & 1, (corner >> 1) & 1, corner >> 2) * 2.f - 1.f;
+        const float3 localPosition = IvyStemBoundsCenter.xyz + IvyStemBoundsExtents.xyz * cornerSign;
+
+        float4 worldSpacePosition = mul(ToFloat4x4(inputRecord.Get().transform[stemIndex]), float4(localPosition, 1));
+
+        if (IvyFlags & IVY_FLAG_WIND)
+        {
+            worldSpacePosition.xyz += GetWindOffset(inputRecord.Get().windData[stemIndex], IvyWindTime);
+        }
+
+        verts[threadIndex].clipSpacePosition = mul(IvyViewProjections[view], worldSpacePosition);
+    }
+
+    [[unroll]]
+    for (uint i = 0; i < (ivyShadowStemsPerGroup * ivyShadowStemTriangles + ivyShadowThreadGroupSize - 1) / ivyShadowThreadGroupSize; ++i)
+    {
+        const uint triId = threadIndex + ivyShadowThreadGroupSize * i;
+
+        if (triId < stemCount * ivyShadowStemTriangles)
+        {
+            tris[triId]                = (triId / ivyShadowStemTriangles) * ivyShadowStemVertices + ivyShadowBoxTriangles[triId % ivyShadowStemTriangles];
+            prims[triId].viewportIndex = view;
+        }
+    }
+}
+
+[Shader("node")]
+[NodeLaunch("mesh")]
+[NodeId("DrawIvyLeafShadow", 0)]
+[NodeMaxDispatchGrid(maxLeavesPerRecord / ivyShadowLeavesPerGroup, IVY_MAX_VIEWS, 1)]
+[NumThreads(ivyShadowThreadGroupSize, 1, 1)]
+[OutputTopology("triangle")]
+void IvyLeafShadowMeshShader(
+    uint threadIndex : SV_GroupThreadId,
+    uint2 groupIndex : SV_GroupId,
+    DispatchNodeInputRecord<DrawIvyLeafShadowRecord> inputRecord,
+    out indices uint3 tris[ivyShadowLeavesPerGroup * ivyShadowLeafTriangles],
+    out primitives ShadowPrimitiveAttributes prims[ivyShadowLeavesPerGroup * ivyShadowLeafTriangles],
+    out vertices ShadowVertexAttributes verts[ivyShadowLeavesPerGroup * ivyShadowLeafVertices])
+{
+    const uint firstLeaf      = groupIndex.x * ivyShadowLeavesPerGroup;
+    const uint groupLeafCount = min(inputRecord.Get().leafCount - firstLeaf, ivyShadowLeavesPerGroup);
+    const uint view           = GetShadowView(inputRecord.Get().viewMask, groupIndex.y);
+    const uint leafViewMask   = (threadIndex < groupLeafCount) ? inputRecord.Get().viewMasks[firstLeaf + threadIndex] : 0;
+    const uint leafCount      = GetShadowInstances(threadIndex, firstLeaf, groupLeafCount, view, leafViewMask);
+
+    SetMeshOutputCounts(leafCount * ivyShadowLeafVertices, leafCount * ivyShadowLeafTriangles);
+
+    // Each thread transforms one diamond corner
+    const uint leaf = threadIndex / ivyShadowLeafVertices;
+
+    if (leaf < leafCount)
+    {
+        const uint     leafIndex     = shadowInstances[leaf];
+        const float4x4 transform     = ToFloat4x4(inputRecord.Get().transform[leafIndex]);
+        const float2   corner        = ivyShadowLeafCorners[threadIndex % ivyShadowLeafVertices];
+        const float3   localPosition = IvyLeafBoundsCenter.xyz + IvyLeafBoundsExtents.xyz * float3(corner.x, 0, corner.y);
+
+        float4 worldSpacePosition = mul(transform, float4(localPosition, 1));
+
+        if (IvyFlags & IVY_FLAG_WIND)
+        {
+            const uint   windData   = inputRecord.Get().windData[leafIndex];
+            const float3 leafNormal = normalize(mul((float3x3)transform, float3(0, 1, 0)));
+
+            worldSpacePosition.xyz += GetWindOffset(windData, IvyWindTime) + GetLeafFlutterOffset(windData, localPosition, leafNormal, IvyWindTime);
+        }
+
+        verts[threadIndex].clipSpacePosition = mul(IvyViewProjections[view], worldSpacePosition);
+    }
+
+    if (threadIndex < leafCount * ivyShadowLeafTriangles)
+    {
+        const uint firstVertex = (threadIndex / ivyShadowLeafTriangles) * ivyShadowLeafVertices;
+
+        tris[threadIndex]                = firstVertex + ivyShadowLeafIndices[threadIndex % ivyShadowLeafTriangles];
+        prims[threadIndex].viewportIndex = view;
+    }
+}
@@ -20,6 +20,7 @@
 // THE SOFTWARE.
 
 #include "common.hlsl"
+#include "meshlet.hlsl"
 #include "raytracing.hlsl"
 
 // Vertex output struct for mesh shader
@@ -33,7 +34,8 @@ struct VertexOutputAttributes {
 };
 
 static const uint threadGroupSize      = 128;
-static const uint numOutputVertices    = 134;
+// Meshlets duplicate vertices on their borders
+static const uint numOutputVertices    = IVY_MESHLET_MESH_MAX_VERTICES;
 static const uint numOutputTriangles   = 124;
 
 static const int numOutputVertexIterations   = (numOutputVertices + (threadGroupSize - 1)) / threadGroupSize;
@@ -50,9 +52,12 @@ void IvyStemMeshShader(
     uint groupIndex : SV_GroupId,
     DispatchNodeInputRecord<DrawIvyStemRecord> inputRecord,
     out indices uint3 tris[numOutputTriangles],
+    out primitives MeshletPrimitiveOutputAttributes prims[numOutputTriangles],
     out vertices VertexOutputAttributes verts[numOutputVertices])
 {
-    const float4x4 transform = ToFloat4x4(inputRecord.Get().transform[groupIndex]);
+    const float3x4 instanceTransform = inputRecord.Get().transform[groupIndex];
+    const float4x4 transform         = ToFloat4x4(instanceTransform);
+    const uint     windData          = inputRecord.Get().windData[groupIndex];
 
     Surface_Info sinfo = {
         -1,  // material_id
@@ -76,20 +81,35 @@ void IvyStemMeshShader(
         sinfo = g_surface_info.Load(IvyStemSurfaceIndex);
     }
 
-    const int vertexCount   = clamp(sinfo.num_vertices, 0, numOutputVertices);
-    const int triangleCount = clamp(sinfo.num_indices / 3, 0, numOutputTriangles);
+    // Stems only move with the wind offset of the whole instance
+    const float3 windOffset   = (IvyFlags & IVY_FLAG_WIND) ? GetWindOffset(windData, IvyWindTime) : 0.f;
+    const uint2  outputCounts = CullMeshlets(threadIndex, IVY_MESHLET_STEM, instanceTransform, windOffset, 0.f);
+
+    const uint vertexCount   = min(outputCounts.x, numOutputVertices);
+    const uint triangleCount = min(outputCounts.y, numOutputTriangles);
 
     SetMeshOutputCounts(vertexCount, triangleCount);
 
+    // Each thread group draws one instance
+    AddWaveStatistic(IVY_STATISTIC_STEMS, threadIndex == 0);
+
     [[unroll]]
     for (int i = 0; i < numOutputVertexIterations; ++i)
     {
-        const int vertId = threadIndex + threadGroupSize * i;
+        const uint outputVertex = threadIndex + threadGroupSize * i;
 
-        if (vertId < vertexCount)
+        if (outputVertex < vertexCount)
         {
-            const float3 vertexPosition     = FetchFloat3(sinfo.position_attribute_offset, vertId);
-            const float4 worldSpacePosition = mul(transform, float4(vertexPosition, 1));
+            const uint   vertId                     = GetMeshletOutputVertex(IVY_MESHLET_STEM, outputVertex);
+            const float3 vertexPosition             = FetchFloat3(sinfo.position_attribute_offset, vertId);
+            float4       worldSpacePosition         = mul(transform, float4(vertexPosition, 1));
+            float4       previousWorldSpacePosition = worldSpacePosition;
+
+            if (IvyFlags & IVY_FLAG_WIND)
+            {
+                worldSpacePosition.xyz         += GetWindOffset(windData, IvyWindTime);
+                previousWorldSpacePosition.xyz += GetWindOffset(windData, IvyPreviousWindTime);
+            }
 
             VertexOutputAttributes vertex;
             vertex.clipSpacePosition = mul(ViewProjection, worldSpacePosition);
@@ -103,24 +123,27 @@ void IvyStemMeshShader(
             vertex.texCoord   = FetchFloat2(sinfo.texcoord0_attribute_offset, vertId);
             vertex.materialId = sinfo.material_id;
 
-            const float4 previousClipSpacePosition = mul(PreviousViewProjection, worldSpacePosition);
+            const float4 previousClipSpacePosition = mul(PreviousViewProjection, previousWorldSpacePosition);
             vertex.clipSpaceMotion = (previousClipSpacePosition.xy / previousClipSpacePosition.w) - (vertex.clipSpacePosition.xy / vertex.clipSpacePosition.w);
 
-            verts[vertId] = vertex;
+            verts[outputVertex] = vertex;
+            StoreMeshletScreenPosition(outputVertex, vertex.clipSpacePosition);
         }
     }
 
+    GroupMemoryBarrierWithGroupSync();
+
     [[unroll]]
     for (int i = 0; i < numOutputTriangleIterations; ++i)
     {
-        const int triId = threadIndex + threadGroupSize * i;
+        const uint triId = threadIndex + threadGroupSize * i;
 
         if (triId < triangleCount)
         {
-            const uint3 indices =
-                (sinfo.index_type == SURFACE_INFO_INDEX_TYPE_U16) ? FetchIndicesU16(sinfo.index_offset, triId) : FetchIndicesU32(sinfo.index_offset, triId);
+            const uint3 indices = min(GetMeshletOutputTriangle(IVY_MESHLET_STEM, triId), vertexCount - 1);
 
-            tris[triId] = min(indices, vertexCount);
+            tris[triId]       = indices;
+            prims[triId].cull = IsMeshletTriangleCulled(indices);
         }
     }
 }
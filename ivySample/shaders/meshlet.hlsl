@@ -0,0 +1,329 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "common.hlsl"
+
+// Meshlets of the stem & leaf mesh, see IVY_MESHLETS & IVY_FLAG_MESHLET_CULLING.
+// A mesh node thread group draws one instance. It culls whole meshlets before SetMeshOutputCounts, such that only the vertices & triangles
+// of visible meshlets are output, and marks the remaining triangles which can't cover a pixel center as culled.
+
+RWStructuredBuffer<uint> g_ivy_meshlets : DECLARE_UAV(IVY_MESHLETS);
+
+struct IvyMeshlet
+{
+    uint   vertexOffset;
+    uint   vertexCount;
+    uint   triangleOffset;
+    uint   triangleCount;
+    // xyz: object-space center, w: radius
+    float4 sphere;
+    // xyz: axis, w: sine of the cone angle, 1 if the cone can't cull
+    float4 cone;
+};
+
+// Primitive output struct for mesh shaders drawing meshlets
+struct MeshletPrimitiveOutputAttributes
+{
+    bool cull : SV_CullPrimitive;
+};
+
+// Returns the index of a uint in the meshlet buffer, given its offset inside the meshlets of a mesh
+uint GetMeshletAddress(uint mesh, uint offset)
+{
+    return mesh * IVY_MESHLET_MESH_SIZE + offset;
+}
+
+uint GetMeshletHeaderAddress(uint mesh, uint meshletIndex)
+{
+    return GetMeshletAddress(mesh, IVY_MESHLET_HEADERS + meshletIndex * IVY_MESHLET_HEADER_SIZE);
+}
+
+uint GetMeshletCount(uint mesh)
+{
+    return min(g_ivy_meshlets[GetMeshletAddress(mesh, IVY_MESHLET_COUNT)], IVY_MESHLET_MAX_COUNT);
+}
+
+IvyMeshlet LoadMeshlet(uint mesh, uint meshletIndex)
+{
+    const uint header = GetMeshletHeaderAddress(mesh, meshletIndex);
+
+    IvyMeshlet meshlet;
+    meshlet.vertexOffset   = g_ivy_meshlets[header + 0];
+    meshlet.vertexCount    = g_ivy_meshlets[header + 1];
+    meshlet.triangleOffset = g_ivy_meshlets[header + 2];
+    meshlet.triangleCount  = g_ivy_meshlets[header + 3];
+    meshlet.sphere         = asfloat(uint4(g_ivy_meshlets[header + 4], g_ivy_meshlets[header + 5], g_ivy_meshlets[header + 6], g_ivy_meshlets[header + 7]));
+    meshlet.cone           = asfloat(uint4(g_ivy_meshlets[header + 8], g_ivy_meshlets[header + 9], g_ivy_meshlets[header + 10], g_ivy_meshlets[header + 11]));
+
+    return meshlet;
+}
+
+void StoreMeshlet(uint mesh, uint meshletIndex, in IvyMeshlet meshlet)
+{
+    const uint header = GetMeshletHeaderAddress(mesh, meshletIndex);
+
+    g_ivy_meshlets[header + 0] = meshlet.vertexOffset;
+    g_ivy_meshlets[header + 1] = meshlet.vertexCount;
+    g_ivy_meshlets[header + 2] = meshlet.triangleOffset;
+    g_ivy_meshlets[header + 3] = meshlet.triangleCount;
+
+    [unroll]
+    for (uint i = 0; i < 4; ++i)
+    {
+        g_ivy_meshlets[header + 4 + i] = asuint(meshlet.sphere[i]);
+        g_ivy_meshlets[header + 8 + i] = asuint(meshlet.cone[i]);
+    }
+}
+
+// ==================
+// Meshlet culling
+
+// Returns the object-space position of a world-space position. The transform has to be affine & invertible.
+float3 InverseTransformPoint(in float3x4 transform, float3 position)
+{
+    const float3 column0 = float3(transform._11, transform._21, transform._31);
+    const float3 column1 = float3(transform._12, transform._22, transform._32);
+    const float3 column2 = float3(transform._13, transform._23, transform._33);
+    const float3 offset  = position - float3(transform._14, transform._24, transform._34);
+
+    // Rows of the inverse are the cross products of the columns, divided by the determinant
+    const float3 row0 = cross(column1, column2);
+    const float3 row1 = cross(column2, column0);
+    const float3 row2 = cross(column0, column1);
+
+    return float3(dot(row0, offset), dot(row1, offset), dot(row2, offset)) / dot(column0, row0);
+}
+
+// Returns whether a rectangle in normalized device coordinates contains the center of any pixel of the view
+bool CoversPixelCenter(float2 ndcMin, float2 ndcMax)
+{
+    const float2 viewSize = float2(HiZDepthSize);
+    const float2 pixelMin = (ndcMin * 0.5f + 0.5f) * viewSize;
+    const float2 pixelMax = (ndcMax * 0.5f + 0.5f) * viewSize;
+
+    // Pixel centers lie at half-integer coordinates, which are exactly the points round() steps at
+    return all(round(pixelMin) != round(pixelMax));
+}
+
+// Returns whether a meshlet of an instance may cover a pixel, i.e. whether it's neither back-facing, outside the view nor in between pixel centers.
+// windOffset moves the whole instance; flutter moves each vertex by at most flutter times its distance to the object-space origin.
+bool IsMeshletVisible(in IvyMeshlet meshlet, in float3x4 transform, float3 windOffset, float flutter)
+{
+    const float3 column0 = float3(transform._11, transform._21, transform._31);
+    const float3 column1 = float3(transform._12, transform._22, transform._32);
+    const float3 column2 = float3(transform._13, transform._23, transform._33);
+    const float  maxScale = sqrt(max(max(dot(column0, column0), dot(column1, column1)), dot(column2, column2)));
+    const float  minScale = sqrt(min(min(dot(column0, column0), dot(column1, column1)), dot(column2, column2)));
+
+    const float inflation   = flutter * (length(meshlet.sphere.xyz) + meshlet.sphere.w);
+    const float worldRadius = meshlet.sphere.w * maxScale + inflation;
+
+    // Back-facing: whether a triangle faces a point is preserved by affine transforms, thus the normal cone is tested in object space
+    const float3 eye          = InverseTransformPoint(transform, CameraPosition.xyz - windOffset);
+    const float3 toCenter     = meshlet.sphere.xyz - eye;
+    const float  objectRadius = meshlet.sphere.w + inflation / max(minScale, 1e-6f);
+
+    if (dot(toCenter, meshlet.cone.xyz) >= meshlet.cone.w * length(toCenter) + objectRadius)
+    {
+        return false;
+    }
+
+    const float3 center = mul(transform, float4(meshlet.sphere.xyz, 1.f)) + windOffset;
+
+    // Outside the view: side planes of the view frustum are w = +-x & w = +-y in clip space
+    const float4 planes[4] = {
+        ViewProjection[3] + ViewProjection[0],
+        ViewProjection[3] - ViewProjection[0],
+        ViewProjection[3] + ViewProjection[1],
+        ViewProjection[3] - ViewProjection[1],
+    };
+
+    [unroll]
+    for (int plane = 0; plane < 4; ++plane)
+    {
+        if (dot(planes[plane], float4(center, 1.f)) < -worldRadius * length(planes[plane].xyz))
+        {
+            return false;
+        }
+    }
+
+    // In between pixel centers: conservative screen-space bounds of the bounding sphere, unless it reaches behind the camera
+    const float4 clipSpaceCenter = mul(ViewProjection, float4(center, 1.f));
+
+    if (clipSpaceCenter.w > worldRadius)
+    {
+        const float2 clipSpaceExtents = worldRadius * float2(length(ViewProjection[0].xyz), length(ViewProjection[1].xyz));
+        const float2 clipSpaceMin     = clipSpaceCenter.xy - clipSpaceExtents;
+        const float2 clipSpaceMax     = clipSpaceCenter.xy + clipSpaceExtents;
+
+        const float2 ndcMin = min(clipSpaceMin / (clipSpaceCenter.w - worldRadius), clipSpaceMin / (clipSpaceCenter.w + worldRadius));
+        const float2 ndcMax = max(clipSpaceMax / (clipSpaceCenter.w - worldRadius), clipSpaceMax / (clipSpaceCenter.w + worldRadius));
+
+        if (!CoversPixelCenter(ndcMin, ndcMax))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Visible meshlets of the instance drawn by the thread group & the offsets of their output vertices & triangles
+groupshared uint meshletVisibility;
+groupshared uint visibleMeshletCount;
+groupshared uint visibleMeshlets[IVY_MESHLET_MAX_COUNT];
+groupshared uint meshletOutputVertexOffsets[IVY_MESHLET_MAX_COUNT + 1];
+groupshared uint meshletOutputTriangleOffsets[IVY_MESHLET_MAX_COUNT + 1];
+
+// Culls the meshlets of an instance. Returns the number of output vertices & triangles of the visible meshlets.
+uint2 CullMeshlets(uint threadIndex, uint mesh, in float3x4 transform, float3 windOffset, float flutter)
+{
+    const uint meshletCount = GetMeshletCount(mesh);
+
+    if (threadIndex == 0)
+    {
+        meshletVisibility = 0;
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    // One thread per meshlet
+    if (threadIndex < meshletCount)
+    {
+        if (!(IvyFlags & IVY_FLAG_MESHLET_CULLING) || IsMeshletVisible(LoadMeshlet(mesh, threadIndex), transform, windOffset, flutter))
+        {
+            InterlockedOr(meshletVisibility, 1u << threadIndex);
+        }
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    if (threadIndex == 0)
+    {
+        uint visibleCount   = 0;
+        uint vertexOffset   = 0;
+        uint triangleOffset = 0;
+
+        for (uint meshletIndex = 0; meshletIndex < meshletCount; ++meshletIndex)
+        {
+            if (meshletVisibility & (1u << meshletIndex))
+            {
+                const uint header = GetMeshletHeaderAddress(mesh, meshletIndex);
+
+                visibleMeshlets[visibleCount]              = meshletIndex;
+                meshletOutputVertexOffsets[visibleCount]   = vertexOffset;
+                meshletOutputTriangleOffsets[visibleCount] = triangleOffset;
+
+                vertexOffset += g_ivy_meshlets[header + 1];
+                triangleOffset += g_ivy_meshlets[header + 3];
+                visibleCount += 1;
+            }
+        }
+
+        meshletOutputVertexOffsets[visibleCount]   = vertexOffset;
+        meshletOutputTriangleOffsets[visibleCount] = triangleOffset;
+        visibleMeshletCount                        = visibleCount;
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    AddWaveStatistic(IVY_STATISTIC_CULLED_MESHLETS, (threadIndex == 0) ? meshletCount - visibleMeshletCount : 0);
+
+    return uint2(meshletOutputVertexOffsets[visibleMeshletCount], meshletOutputTriangleOffsets[visibleMeshletCount]);
+}
+
+// Returns the visible meshlet slot an output vertex or triangle belongs to, given the output offsets of all visible meshlets
+uint FindVisibleMeshletSlot(uint outputIndex, bool triangles)
+{
+    uint slot = 0;
+
+    while ((slot + 1 < visibleMeshletCount) && ((triangles ? meshletOutputTriangleOffsets[slot + 1] : meshletOutputVertexOffsets[slot + 1]) <= outputIndex))
+    {
+        ++slot;
+    }
+
+    return slot;
+}
+
+// Returns the mesh vertex index of an output vertex, see CullMeshlets
+uint GetMeshletOutputVertex(uint mesh, uint outputVertex)
+{
+    const uint slot         = FindVisibleMeshletSlot(outputVertex, false);
+    const uint vertexOffset = g_ivy_meshlets[GetMeshletHeaderAddress(mesh, visibleMeshlets[slot]) + 0];
+
+    return g_ivy_meshlets[GetMeshletAddress(mesh, IVY_MESHLET_VERTICES + vertexOffset + outputVertex - meshletOutputVertexOffsets[slot])];
+}
+
+// Returns the output vertices of an output triangle, see CullMeshlets
+uint3 GetMeshletOutputTriangle(uint mesh, uint outputTriangle)
+{
+    const uint slot           = FindVisibleMeshletSlot(outputTriangle, true);
+    const uint triangleOffset = g_ivy_meshlets[GetMeshletHeaderAddress(mesh, visibleMeshlets[slot]) + 2];
+    const uint packedIndices =
+        g_ivy_meshlets[GetMeshletAddress(mesh, IVY_MESHLET_TRIANGLES + triangleOffset + outputTriangle - meshletOutputTriangleOffsets[slot])];
+
+    return meshletOutputVertexOffsets[slot] + uint3(packedIndices & 0xFF, (packedIndices >> 8) & 0xFF, (packedIndices >> 16) & 0xFF);
+}
+
+// ==================
+// Triangle culling
+
+// xy: position in pixels, z: clip-space w of the output vertices, see IsMeshletTriangleCulled
+groupshared float3 meshletScreenPositions[IVY_MESHLET_MESH_MAX_VERTICES];
+
+void StoreMeshletScreenPosition(uint outputVertex, float4 clipSpacePosition)
+{
+    const float2 ndc = clipSpacePosition.xy / clipSpacePosition.w;
+
+    meshletScreenPositions[outputVertex] = float3((ndc * 0.5f + 0.5f) * float2(HiZDepthSize), clipSpacePosition.w);
+}
+
+// Returns whether the rasterizer can skip a triangle of output vertices, as it's degenerate or doesn't cover any pixel center.
+// Screen positions of all output vertices have to be stored & synchronized first. Back-facing triangles are left to the rasterizer.
+bool IsMeshletTriangleCulled(uint3 outputVertices)
+{
+    if (!(IvyFlags & IVY_FLAG_MESHLET_CULLING))
+    {
+        return false;
+    }
+
+    const float3 a = meshletScreenPositions[outputVertices.x];
+    const float3 b = meshletScreenPositions[outputVertices.y];
+    const float3 c = meshletScreenPositions[outputVertices.z];
+
+    // Triangles reaching behind the camera are clipped by the rasterizer
+    if (min(a.z, min(b.z, c.z)) <= 0.f)
+    {
+        return false;
+    }
+
+    const float2 ab   = b.xy - a.xy;
+    const float2 ac   = c.xy - a.xy;
+    const float  area = ab.x * ac.y - ab.y * ac.x;
+
+    const float2 pixelMin = min(a.xy, min(b.xy, c.xy));
+    const float2 pixelMax = max(a.xy, max(b.xy, c.xy));
+
+    // Pixel centers lie at half-integer coordinates, see CoversPixelCenter
+    return (area == 0.f) || any(round(pixelMin) == round(pixelMax));
+}
@@ -0,0 +1,225 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "meshlet.hlsl"
+#include "raytracing.hlsl"
+
+uint3 FetchTriangleIndices(in Surface_Info sinfo, uint triangleIndex)
+{
+    return (sinfo.index_type == SURFACE_INFO_INDEX_TYPE_U16) ? FetchIndicesU16(sinfo.index_offset, triangleIndex)
+                                                             : FetchIndicesU32(sinfo.index_offset, triangleIndex);
+}
+
+// Returns the unnormalized face normal of a triangle, following its winding
+float3 GetFaceNormal(in Surface_Info sinfo, uint3 indices)
+{
+    const float3 p0 = FetchFloat3(sinfo.position_attribute_offset, indices.x);
+    const float3 p1 = FetchFloat3(sinfo.position_attribute_offset, indices.y);
+    const float3 p2 = FetchFloat3(sinfo.position_attribute_offset, indices.z);
+
+    return cross(p1 - p0, p2 - p0);
+}
+
+// Returns 1 if the winding of most triangles agrees with their vertex normals, -1 otherwise.
+// The rasterizer culls by winding, thus normal cones are built from face normals, which are flipped to point to the front side of the mesh.
+float GetMeshOrientation(in Surface_Info sinfo, uint triangleCount)
+{
+    float orientation = 0.f;
+
+    for (uint triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+    {
+        const uint3  indices      = FetchTriangleIndices(sinfo, triangleIndex);
+        const float3 vertexNormal = FetchFloat3(sinfo.normal_attribute_offset, indices.x) + FetchFloat3(sinfo.normal_attribute_offset, indices.y) +
+                                    FetchFloat3(sinfo.normal_attribute_offset, indices.z);
+
+        orientation += sign(dot(GetFaceNormal(sinfo, indices), vertexNormal));
+    }
+
+    return (orientation >= 0.f) ? 1.f : -1.f;
+}
+
+// Returns the meshlet-local index of a mesh vertex, or the vertex count of the meshlet if it doesn't hold the vertex yet
+uint FindMeshletVertex(uint mesh, in IvyMeshlet meshlet, uint vertexIndex)
+{
+    for (uint localIndex = 0; localIndex < meshlet.vertexCount; ++localIndex)
+    {
+        if (g_ivy_meshlets[GetMeshletAddress(mesh, IVY_MESHLET_VERTICES + meshlet.vertexOffset + localIndex)] == vertexIndex)
+        {
+            return localIndex;
+        }
+    }
+
+    return meshlet.vertexCount;
+}
+
+// Returns the meshlet-local index of a mesh vertex, appending it to the meshlet if it doesn't hold the vertex yet
+uint AddMeshletVertex(uint mesh, inout IvyMeshlet meshlet, uint vertexIndex)
+{
+    const uint localIndex = FindMeshletVertex(mesh, meshlet, vertexIndex);
+
+    if (localIndex == meshlet.vertexCount)
+    {
+        g_ivy_meshlets[GetMeshletAddress(mesh, IVY_MESHLET_VERTICES + meshlet.vertexOffset + localIndex)] = vertexIndex;
+        meshlet.vertexCount += 1;
+    }
+
+    return localIndex;
+}
+
+// Computes the bounding sphere & normal cone of a meshlet, stores it & starts the next meshlet behind it
+void FinishMeshlet(uint mesh, in Surface_Info sinfo, float orientation, inout uint meshletCount, inout IvyMeshlet meshlet)
+{
+    float3 boundsMin = 1e30f;
+    float3 boundsMax = -1e30f;
+
+    for (uint localIndex = 0; localIndex < meshlet.vertexCount; ++localIndex)
+    {
+        const uint   vertexIndex = g_ivy_meshlets[GetMeshletAddress(mesh, IVY_MESHLET_VERTICES + meshlet.vertexOffset + localIndex)];
+        const float3 position    = FetchFloat3(sinfo.position_attribute_offset, vertexIndex);
+
+        boundsMin = min(boundsMin, position);
+        boundsMax = max(boundsMax, position);
+    }
+
+    const float3 center = 0.5f * (boundsMin + boundsMax);
+    float        radius = 0.f;
+    float3       axis   = 0.f;
+
+    for (uint localIndex = 0; localIndex < meshlet.vertexCount; ++localIndex)
+    {
+        const uint vertexIndex = g_ivy_meshlets[GetMeshletAddress(mesh, IVY_MESHLET_VERTICES + meshlet.vertexOffset + localIndex)];
+
+        radius = max(radius, length(FetchFloat3(sinfo.position_attribute_offset, vertexIndex) - center));
+    }
+
+    // Degenerate triangles are never rasterized & thus don't widen the cone
+    for (uint triangleIndex = 0; triangleIndex < meshlet.triangleCount; ++triangleIndex)
+    {
+        const float3 faceNormal = GetFaceNormal(sinfo, FetchTriangleIndices(sinfo, meshlet.triangleOffset + triangleIndex));
+
+        if (dot(faceNormal, faceNormal) > 0.f)
+        {
+            axis += orientation * normalize(faceNormal);
+        }
+    }
+
+    float coneSine = 1.f;
+
+    if (dot(axis, axis) > 0.f)
+    {
+        axis = normalize(axis);
+
+        float minDot = 1.f;
+
+        for (uint triangleIndex = 0; triangleIndex < meshlet.triangleCount; ++triangleIndex)
+        {
+            const float3 faceNormal = GetFaceNormal(sinfo, FetchTriangleIndices(sinfo, meshlet.triangleOffset + triangleIndex));
+
+            if (dot(faceNormal, faceNormal) > 0.f)
+            {
+                minDot = min(minDot, dot(axis, orientation * normalize(faceNormal)));
+            }
+        }
+
+        // Cones of a hemisphere or wider contain front-facing triangles from any view direction
+        if (minDot > 0.f)
+        {
+            coneSine = sqrt(1.f - minDot * minDot);
+        }
+    }
+
+    meshlet.sphere = float4(center, radius);
+    meshlet.cone   = float4(axis, coneSine);
+
+    StoreMeshlet(mesh, meshletCount, meshlet);
+    meshletCount += 1;
+
+    IvyMeshlet nextMeshlet     = (IvyMeshlet)0;
+    nextMeshlet.vertexOffset   = meshlet.vertexOffset + meshlet.vertexCount;
+    nextMeshlet.triangleOffset = meshlet.triangleOffset + meshlet.triangleCount;
+
+    meshlet = nextMeshlet;
+}
+
+// Splits the stem & leaf mesh into meshlets, one thread per mesh. Dispatched once after both meshes were loaded.
+// Triangles are assigned in index buffer order; meshlets stay within IVY_MESHLET_MAX_VERTICES & IVY_MESHLET_MAX_TRIANGLES.
+[Shader("node")]
+[NodeIsProgramEntry]
+[NodeLaunch("broadcasting")]
+[NodeDispatchGrid(1, 1, 1)]
+[NumThreads(2, 1, 1)]
+void IvyMeshletBake(uint mesh : SV_GroupThreadID)
+{
+    const int surfaceIndex = (mesh == IVY_MESHLET_STEM) ? IvyStemSurfaceIndex : IvyLeafSurfaceIndex;
+
+    uint meshletCount = 0;
+
+    if (surfaceIndex >= 0)
+    {
+        const Surface_Info sinfo         = g_surface_info.Load(surfaceIndex);
+        const uint         triangleCount = min(sinfo.num_indices / 3, IVY_MESHLET_MESH_MAX_TRIANGLES);
+        const float        orientation   = GetMeshOrientation(sinfo, triangleCount);
+
+        IvyMeshlet meshlet = (IvyMeshlet)0;
+
+        for (uint triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+        {
+            const uint3 indices = FetchTriangleIndices(sinfo, triangleIndex);
+
+            // Vertices of the triangle the meshlet doesn't hold yet
+            const uint newVertexCount = uint(FindMeshletVertex(mesh, meshlet, indices.x) == meshlet.vertexCount) +
+                                        uint((FindMeshletVertex(mesh, meshlet, indices.y) == meshlet.vertexCount) && (indices.y != indices.x)) +
+                                        uint((FindMeshletVertex(mesh, meshlet, indices.z) == meshlet.vertexCount) && (indices.z != indices.x) &&
+                                             (indices.z != indices.y));
+
+            if ((meshlet.triangleCount == IVY_MESHLET_MAX_TRIANGLES) || (meshlet.vertexCount + newVertexCount > IVY_MESHLET_MAX_VERTICES))
+            {
+                FinishMeshlet(mesh, sinfo, orientation, meshletCount, meshlet);
+
+                if (meshletCount == IVY_MESHLET_MAX_COUNT)
+                {
+                    break;
+                }
+            }
+
+            // All meshlets of a mesh share IVY_MESHLET_MESH_MAX_VERTICES; remaining triangles are dropped
+            if (meshlet.vertexOffset + meshlet.vertexCount + 3 > IVY_MESHLET_MESH_MAX_VERTICES)
+            {
+                break;
+            }
+
+            const uint localIndex0 = AddMeshletVertex(mesh, meshlet, indices.x);
+            const uint localIndex1 = AddMeshletVertex(mesh, meshlet, indices.y);
+            const uint localIndex2 = AddMeshletVertex(mesh, meshlet, indices.z);
+
+            g_ivy_meshlets[GetMeshletAddress(mesh, IVY_MESHLET_TRIANGLES + meshlet.triangleOffset + meshlet.triangleCount)] =
+                localIndex0 | (localIndex1 << 8) | (localIndex2 << 16);
+            meshlet.triangleCount += 1;
+        }
+
+        if ((meshlet.triangleCount > 0) && (meshletCount < IVY_MESHLET_MAX_COUNT))
+        {
+            FinishMeshlet(mesh, sinfo, orientation, meshletCount, meshlet);
+        }
+    }
+
+    g_ivy_meshlets[GetMeshletAddress(mesh, IVY_MESHLET_COUNT)] = meshletCount;
+}
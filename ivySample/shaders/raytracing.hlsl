@@ -28,6 +28,9 @@ StructuredBuffer<Instance_Info> g_instance_info : DECLARE_SRV(RAYTRACING_INFO_IN
 StructuredBuffer<uint>          g_surface_id : DECLARE_SRV(RAYTRACING_INFO_SURFACE_ID);
 StructuredBuffer<Surface_Info>  g_surface_info : DECLARE_SRV(RAYTRACING_INFO_SURFACE);
 
+StructuredBuffer<uint> g_face_normal_offsets : DECLARE_SRV(IVY_FACE_NORMAL_OFFSETS);
+StructuredBuffer<uint> g_face_normals : DECLARE_SRV(IVY_FACE_NORMALS);
+
 Texture2D g_textures[MAX_TEXTURES_COUNT] : DECLARE_SRV(TEXTURE_BEGIN_SLOT);
 SamplerState g_samplers[MAX_SAMPLERS_COUNT] : DECLARE_SAMPLER(SAMPLER_BEGIN_SLOT);
 
@@ -101,7 +104,23 @@ float3 FetchNormal(in Surface_Info sinfo, in uint3 face3, in float2 bary)
     return normal1 * bary.x + normal2 * bary.y + normal0 * (1.0 - bary.x - bary.y);
 }
 
+// Inverse of EncodeFaceNormal in ivyrendermodule.cpp
+float3 DecodeFaceNormal(in uint encodedNormal)
+{
+    const float2 octahedron = (float2(encodedNormal & 0xFFFFu, encodedNormal >> 16) - 32768.f) / 32767.f;
+
+    float3 normal = float3(octahedron, 1.f - abs(octahedron.x) - abs(octahedron.y));
+
+    // Unfold lower hemisphere
+    const float fold = saturate(-normal.z);
+    normal.x += (normal.x >= 0.f) ? -fold : fold;
+    normal.y += (normal.y >= 0.f) ? -fold : fold;
+
+    return normalize(normal);
+}
 
+// Ray queries are compiled out if the device doesn't support them, see TraceGrowthRay
+#if !IVY_SDF_QUERIES_ONLY
 bool TraceRay(in float3 origin, 
               in float3 direction,
               in float tMin,
@@ -133,16 +152,31 @@ bool TraceRay(in float3 origin,
     const uint geometry_id  = q.CommittedGeometryIndex();
 
     const Instance_Info iinfo      = g_instance_info.Load(instance_id);
-    const uint          surface_id = g_surface_id.Load((iinfo.surface_id_table_offset + geometry_id));
-    const Surface_Info  sinfo      = g_surface_info.Load(surface_id);
+    const uint          triangleId = q.CommittedPrimitiveIndex();
 
-    const uint  triangleId = q.CommittedPrimitiveIndex();
-    const uint3 indices =
-        (sinfo.index_type == SURFACE_INFO_INDEX_TYPE_U16) ? FetchIndicesU16(sinfo.index_offset, triangleId) : FetchIndicesU32(sinfo.index_offset, triangleId);
+    // Growth only needs a stable surface normal, thus the flattened face normal is used if the geometry was read back already
+    const uint faceNormalOffset  = g_face_normal_offsets.Load(iinfo.surface_id_table_offset + geometry_id);
+    const uint encodedFaceNormal = (faceNormalOffset != IVY_FACE_NORMAL_NONE) ? g_face_normals.Load(faceNormalOffset + triangleId) : 0;
 
-    const float3 normal = FetchNormal(sinfo, indices, q.CommittedTriangleBarycentrics());
+    float3 normal;
+
+    if (encodedFaceNormal != 0)
+    {
+        normal = DecodeFaceNormal(encodedFaceNormal);
+    }
+    else
+    {
+        const uint         surface_id = g_surface_id.Load((iinfo.surface_id_table_offset + geometry_id));
+        const Surface_Info sinfo      = g_surface_info.Load(surface_id);
+
+        const uint3 indices =
+            (sinfo.index_type == SURFACE_INFO_INDEX_TYPE_U16) ? FetchIndicesU16(sinfo.index_offset, triangleId) : FetchIndicesU32(sinfo.index_offset, triangleId);
+
+        normal = FetchNormal(sinfo, indices, q.CommittedTriangleBarycentrics());
+    }
 
     hitNormal = normalize(mul((float3x3)q.CommittedObjectToWorld3x4(), normal));
 
     return true;
-}
\ No newline at end of file
+}
+#endif  // !IVY_SDF_QUERIES_ONLY
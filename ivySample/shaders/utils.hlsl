@@ -84,6 +84,31 @@ uint Hash(in float4x4 mat)
     return CombineSeed(Hash(mat[0]), Hash(mat[1]), Hash(mat[2]), Hash(mat[3]));
 }
 
+// 64-bit hash finalizer of splitmix64
+uint64_t Hash64(uint64_t value)
+{
+    value = (value ^ (value >> 30)) * ((uint64_t(0xbf58476du) << 32) | 0x1ce4e5b9u);
+    value = (value ^ (value >> 27)) * ((uint64_t(0x94d049bbu) << 32) | 0x133111ebu);
+    return value ^ (value >> 31);
+}
+
+uint64_t Hash64(in float3x4 mat, uint seed)
+{
+    uint64_t hash = seed;
+
+    [[unroll]]
+    for (int row = 0; row < 3; ++row)
+    {
+        [[unroll]]
+        for (int column = 0; column < 4; ++column)
+        {
+            hash = Hash64(hash ^ asuint(mat[row][column]));
+        }
+    }
+
+    return hash;
+}
+
 float Random(uint seed)
 {
     return Hash(seed) / float(~0u);
@@ -0,0 +1,211 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "uploadring.h"
+
+#include "misc/assert.h"
+#include "render/device.h"
+
+#include "render/dx12/device_dx12.h"
+
+#include "d3dx12/d3dx12.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace cauldron;
+
+UploadRing::UploadRing(size_t sizeInBytes)
+    : m_SizeInBytes(sizeInBytes)
+    , m_Allocator(sizeInBytes)
+{
+    ID3D12Device* pDevice = GetDevice()->GetImpl()->DX12Device();
+
+    const CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_UPLOAD);
+    const CD3DX12_RESOURCE_DESC   resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(m_SizeInBytes);
+
+    CauldronThrowOnFail(pDevice->CreateCommittedResource(
+        &heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&m_pRingResource)));
+    m_pRingResource->SetName(L"IvySample_UploadRing");
+
+    // Upload heaps stay mapped for their whole lifetime
+    const D3D12_RANGE readRange = {0, 0};
+    CauldronThrowOnFail(m_pRingResource->Map(0, &readRange, reinterpret_cast<void**>(&m_pRingData)));
+
+    D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+    queueDesc.Type                     = D3D12_COMMAND_LIST_TYPE_COPY;
+    queueDesc.Priority                 = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+    CauldronThrowOnFail(pDevice->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_pQueue)));
+    m_pQueue->SetName(L"IvySample_UploadRingQueue");
+
+    CauldronThrowOnFail(pDevice->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_pFence)));
+}
+
+UploadRing::~UploadRing()
+{
+    // Destination buffers are destroyed by their owners, thus pending copies are flushed first
+    Submit();
+
+    while (!m_Submissions.empty())
+    {
+        WaitForOldestSubmission();
+    }
+
+    for (auto* pAllocator : m_FreeAllocators)
+    {
+        pAllocator->Release();
+    }
+
+    if (m_pCommandList)
+        m_pCommandList->Release();
+    if (m_pFence)
+        m_pFence->Release();
+    if (m_pQueue)
+        m_pQueue->Release();
+    if (m_pRingResource)
+        m_pRingResource->Release();
+}
+
+void UploadRing::BeginRecording()
+{
+    if (m_pAllocator)
+    {
+        return;
+    }
+
+    if (m_FreeAllocators.empty())
+    {
+        CauldronThrowOnFail(GetDevice()->GetImpl()->DX12Device()->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&m_pAllocator)));
+    }
+    else
+    {
+        m_pAllocator = m_FreeAllocators.back();
+        m_FreeAllocators.pop_back();
+        CauldronThrowOnFail(m_pAllocator->Reset());
+    }
+
+    if (m_pCommandList)
+    {
+        CauldronThrowOnFail(m_pCommandList->Reset(m_pAllocator, nullptr));
+    }
+    else
+    {
+        CauldronThrowOnFail(GetDevice()->GetImpl()->DX12Device()->CreateCommandList(
+            0, D3D12_COMMAND_LIST_TYPE_COPY, m_pAllocator, nullptr, IID_PPV_ARGS(&m_pCommandList)));
+        m_pCommandList->SetName(L"IvySample_UploadRingCommandList");
+    }
+}
+
+void UploadRing::WaitForOldestSubmission()
+{
+    const Submission submission = m_Submissions.front();
+    m_Submissions.erase(m_Submissions.begin());
+
+    // A null event blocks until the fence reaches the value
+    if (m_pFence->GetCompletedValue() < submission.fenceValue)
+    {
+        CauldronThrowOnFail(m_pFence->SetEventOnCompletion(submission.fenceValue, nullptr));
+    }
+
+    m_Allocator.Free(submission.sizeInBytes);
+    m_FreeAllocators.push_back(submission.pAllocator);
+}
+
+size_t UploadRing::Allocate(size_t sizeInBytes)
+{
+    CauldronAssert(ASSERT_CRITICAL, sizeInBytes <= m_Allocator.GetMaxAllocationSize(), L"Upload exceeds half the upload ring.");
+
+    for (;;)
+    {
+        size_t offset, usedBytes;
+        if (m_Allocator.Allocate(sizeInBytes, offset, usedBytes))
+        {
+            m_RecordedBytes += usedBytes;
+            return offset;
+        }
+
+        // Copies recorded from the ring have to be submitted before their bytes can be reclaimed
+        if (m_RecordedCopies > 0)
+        {
+            Submit();
+        }
+
+        // A drained ring fits any allocation up to the maximum size, thus bytes are always in flight here
+        CauldronAssert(ASSERT_CRITICAL, !m_Submissions.empty(), L"Upload ring is full without any copies in flight.");
+        WaitForOldestSubmission();
+    }
+}
+
+void UploadRing::Upload(ID3D12Resource* pDestination, uint64_t destinationOffset, const void* pData, size_t sizeInBytes)
+{
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+
+    while (sizeInBytes > 0)
+    {
+        const size_t chunkSize = std::min(sizeInBytes, m_Allocator.GetMaxAllocationSize());
+        const size_t offset    = Allocate(chunkSize);
+
+        memcpy(m_pRingData + offset, pBytes, chunkSize);
+
+        BeginRecording();
+        m_pCommandList->CopyBufferRegion(pDestination, destinationOffset, m_pRingResource, offset, chunkSize);
+        ++m_RecordedCopies;
+
+        pBytes            += chunkSize;
+        destinationOffset += chunkSize;
+        sizeInBytes       -= chunkSize;
+    }
+}
+
+void UploadRing::Copy(ID3D12Resource* pDestination, uint64_t destinationOffset, ID3D12Resource* pSource, uint64_t sourceOffset, size_t sizeInBytes)
+{
+    BeginRecording();
+    m_pCommandList->CopyBufferRegion(pDestination, destinationOffset, pSource, sourceOffset, sizeInBytes);
+    ++m_RecordedCopies;
+}
+
+uint64_t UploadRing::Submit()
+{
+    if (m_RecordedCopies == 0)
+    {
+        // Ring bytes skipped without any copy are reclaimed together with the next submission
+        return m_FenceValue;
+    }
+
+    CauldronThrowOnFail(m_pCommandList->Close());
+
+    ID3D12CommandList* pCommandLists[] = {m_pCommandList};
+    m_pQueue->ExecuteCommandLists(1, pCommandLists);
+    CauldronThrowOnFail(m_pQueue->Signal(m_pFence, ++m_FenceValue));
+
+    m_Submissions.push_back({m_FenceValue, m_RecordedBytes, m_pAllocator});
+
+    m_pAllocator     = nullptr;
+    m_RecordedBytes  = 0;
+    m_RecordedCopies = 0;
+
+    return m_FenceValue;
+}
+
+bool UploadRing::IsComplete(uint64_t fenceValue) const
+{
+    return m_pFence->GetCompletedValue() >= fenceValue;
+}
@@ -0,0 +1,104 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "ringallocator.h"
+
+#include <cstdint>
+#include <vector>
+
+struct ID3D12CommandAllocator;
+struct ID3D12CommandQueue;
+struct ID3D12Fence;
+struct ID3D12GraphicsCommandList;
+struct ID3D12Resource;
+
+/**
+ * @brief   Persistent staging ring for uploading buffer data on a dedicated copy queue without stalling the render thread.
+ *          Copies are recorded into the ring until Submit, whose fence value tells when the destination buffers may be used.
+ *          Destination buffers have to be in common state; copy queues promote them to copy destination & decay them afterwards.
+ *          Copies may be recorded from any single thread at a time, while IsComplete may be polled from other threads.
+ */
+class UploadRing
+{
+public:
+    UploadRing(size_t sizeInBytes);
+    ~UploadRing();
+
+    /**
+     * @brief   Records a copy of sizeInBytes from pData to pDestination at destinationOffset. Data larger than half the ring is split.
+     *          Waits for the oldest submissions to complete if the ring is full.
+     */
+    void Upload(ID3D12Resource* pDestination, uint64_t destinationOffset, const void* pData, size_t sizeInBytes);
+
+    /**
+     * @brief   Records a GPU copy in between two buffers, e.g. of unchanged data into a reallocated buffer.
+     */
+    void Copy(ID3D12Resource* pDestination, uint64_t destinationOffset, ID3D12Resource* pSource, uint64_t sourceOffset, size_t sizeInBytes);
+
+    /**
+     * @brief   Submits all recorded copies to the copy queue. Returns the fence value signaled once they & all previous copies completed.
+     */
+    uint64_t Submit();
+
+    /**
+     * @brief   Returns true if the submission with fenceValue completed. Never waits.
+     */
+    bool IsComplete(uint64_t fenceValue) const;
+
+private:
+    /**
+     * @brief   Returns the ring offset of sizeInBytes free bytes, submitting recorded copies & waiting for submissions as needed.
+     */
+    size_t Allocate(size_t sizeInBytes);
+    void   BeginRecording();
+    void   WaitForOldestSubmission();
+
+    struct Submission
+    {
+        uint64_t                fenceValue  = 0;
+        // Ring bytes used by the copies of this submission, including padding at the end of the ring
+        size_t                  sizeInBytes = 0;
+        ID3D12CommandAllocator* pAllocator  = nullptr;
+    };
+
+    size_t          m_SizeInBytes   = 0;
+    ID3D12Resource* m_pRingResource = nullptr;
+    uint8_t*        m_pRingData     = nullptr;
+    // Bytes in use by recorded & in-flight copies
+    RingAllocator   m_Allocator;
+
+    ID3D12CommandQueue*        m_pQueue         = nullptr;
+    ID3D12Fence*               m_pFence         = nullptr;
+    // Last signaled fence value
+    uint64_t                   m_FenceValue     = 0;
+    ID3D12GraphicsCommandList* m_pCommandList   = nullptr;
+    // Allocator of the copies recorded since the last submission, nullptr if none were recorded
+    ID3D12CommandAllocator*    m_pAllocator     = nullptr;
+    // Ring bytes & number of copies recorded since the last submission
+    size_t                     m_RecordedBytes  = 0;
+    uint32_t                   m_RecordedCopies = 0;
+
+    // Submissions in flight, oldest first
+    std::vector<Submission>              m_Submissions;
+    std::vector<ID3D12CommandAllocator*> m_FreeAllocators;
+};
@@ -0,0 +1,174 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "check.h"
+#include "hitcache.h"
+
+#include <vector>
+
+// Ray of the golden entry below
+static const Vec3     RayOrigin    = Vec3(1.01f, 2.01f, 3.01f);
+static const Vec3     RayDirection = Vec3(0.f, -1.f, 0.f);
+static const float    RayTMax      = 0.5f;
+static const uint32_t RayEpoch     = 7;
+// Hit of the ray
+static const Vec3 HitPosition = Vec3(1.01f, 1.76f, 3.01f);
+static const Vec3 HitNormal   = Vec3(0.f, 1.f, 0.f);
+
+// Entry of the ray in a cache with GoldenCapacity entries; hitcache.hlsl computes the same key, slot & checksum
+static const uint32_t         GoldenCapacity = 8;
+static const uint32_t         GoldenSlot     = 3;
+static const IvyHitCacheEntry GoldenEntry    = {0x87760637u, {1.01f, 1.76f, 3.01f}, {0.f, 1.f, 0.f}, 0x59731383u};
+
+static bool Equals(const Vec3& a, const Vec3& b)
+{
+    return (a.getX() == b.getX()) && (a.getY() == b.getY()) && (a.getZ() == b.getZ());
+}
+
+static bool Lookup(HitCache& cache, const Vec3& origin, const Vec3& direction, float tMax, uint32_t epoch)
+{
+    bool hit;
+    Vec3 hitPosition, hitNormal;
+    return cache.Lookup(origin, direction, tMax, epoch, hit, hitPosition, hitNormal);
+}
+
+static void TestGoldenEntry()
+{
+    // Key, slot & checksum have to match the GPU, such that the CPU cache can inspect a cache read back from the GPU
+    std::vector<IvyHitCacheEntry> entries(GoldenCapacity, IvyHitCacheEntry{});
+    entries[GoldenSlot] = GoldenEntry;
+
+    HitCache cache(GoldenCapacity);
+    cache.Load(entries.data(), entries.size());
+
+    bool hit = false;
+    Vec3 hitPosition, hitNormal;
+    CHECK(cache.Lookup(RayOrigin, RayDirection, RayTMax, RayEpoch, hit, hitPosition, hitNormal));
+    CHECK(hit);
+    CHECK(Equals(hitPosition, HitPosition));
+    CHECK(Equals(hitNormal, HitNormal));
+
+    // Same entry in any other slot isn't found
+    std::swap(entries[GoldenSlot], entries[(GoldenSlot + 1) % GoldenCapacity]);
+    cache.Load(entries.data(), entries.size());
+    CHECK(!Lookup(cache, RayOrigin, RayDirection, RayTMax, RayEpoch));
+}
+
+static void TestInsertLookup()
+{
+    HitCache cache(GoldenCapacity);
+
+    CHECK(!Lookup(cache, RayOrigin, RayDirection, RayTMax, RayEpoch));
+
+    cache.Insert(RayOrigin, RayDirection, RayTMax, RayEpoch, true, HitPosition, HitNormal);
+
+    bool hit = false;
+    Vec3 hitPosition, hitNormal;
+    CHECK(cache.Lookup(RayOrigin, RayDirection, RayTMax, RayEpoch, hit, hitPosition, hitNormal));
+    CHECK(hit && Equals(hitPosition, HitPosition) && Equals(hitNormal, HitNormal));
+
+    // Origins in the same cell & directions in the same bin share the entry
+    CHECK(Lookup(cache, RayOrigin + Vec3(0.005f, -0.005f, 0.005f), RayDirection, RayTMax, RayEpoch));
+    CHECK(Lookup(cache, RayOrigin, Vec3(0.01f, -2.f, 0.f), RayTMax, RayEpoch));
+
+    // Other cells, direction bins, ray lengths & epochs have other keys
+    CHECK(!Lookup(cache, RayOrigin + Vec3(IVY_HIT_CACHE_CELL_SIZE, 0.f, 0.f), RayDirection, RayTMax, RayEpoch));
+    CHECK(!Lookup(cache, RayOrigin, Vec3(0.f, 1.f, 0.f), RayTMax, RayEpoch));
+    CHECK(!Lookup(cache, RayOrigin, Vec3(1.f, -1.f, 0.f), RayTMax, RayEpoch));
+    CHECK(!Lookup(cache, RayOrigin, RayDirection, RayTMax * 2.f, RayEpoch));
+    CHECK(!Lookup(cache, RayOrigin, RayDirection, RayTMax, RayEpoch + 1));
+
+    CHECK(cache.GetLookupCount() == 9);
+    CHECK(cache.GetHitCount() == 3);
+
+    const HitCacheOccupancy occupancy = cache.GetOccupancy();
+    CHECK(occupancy.hitEntryCount == 1);
+    CHECK(occupancy.emptyEntryCount == GoldenCapacity - 1);
+}
+
+static void TestMiss()
+{
+    HitCache cache(GoldenCapacity);
+
+    cache.Insert(RayOrigin, RayDirection, RayTMax, RayEpoch, false, RayOrigin + RayDirection * RayTMax, HitNormal);
+
+    // Misses return the end of the ray & an up normal
+    bool hit = true;
+    Vec3 hitPosition, hitNormal;
+    CHECK(cache.Lookup(RayOrigin, RayDirection, RayTMax, RayEpoch, hit, hitPosition, hitNormal));
+    CHECK(!hit);
+    CHECK(Equals(hitPosition, RayOrigin + RayDirection * RayTMax));
+    CHECK(Equals(hitNormal, Vec3(0.f, 1.f, 0.f)));
+
+    const HitCacheOccupancy occupancy = cache.GetOccupancy();
+    CHECK(occupancy.missEntryCount == 1);
+    CHECK(occupancy.hitEntryCount == 0);
+}
+
+static void TestChecksum()
+{
+    // Entry torn by concurrent GPU writes, e.g. the position of another ray with the same key
+    std::vector<IvyHitCacheEntry> entries(GoldenCapacity, IvyHitCacheEntry{});
+    entries[GoldenSlot]             = GoldenEntry;
+    entries[GoldenSlot].position[1] = 1.5f;
+
+    HitCache cache(GoldenCapacity);
+    cache.Load(entries.data(), entries.size());
+
+    CHECK(!Lookup(cache, RayOrigin, RayDirection, RayTMax, RayEpoch));
+
+    const HitCacheOccupancy occupancy = cache.GetOccupancy();
+    CHECK(occupancy.tornEntryCount == 1);
+    CHECK(occupancy.hitEntryCount == 0);
+    CHECK(occupancy.emptyEntryCount == GoldenCapacity - 1);
+
+    // Torn checksum
+    entries[GoldenSlot] = GoldenEntry;
+    entries[GoldenSlot].checksum ^= 1;
+    cache.Load(entries.data(), entries.size());
+
+    CHECK(!Lookup(cache, RayOrigin, RayDirection, RayTMax, RayEpoch));
+    CHECK(cache.GetOccupancy().tornEntryCount == 1);
+}
+
+static void TestSlotReplacement()
+{
+    // Single slot cache: every insert replaces the previous entry
+    HitCache cache(1);
+
+    cache.Insert(RayOrigin, RayDirection, RayTMax, RayEpoch, true, HitPosition, HitNormal);
+    cache.Insert(RayOrigin, RayDirection, RayTMax, RayEpoch + 1, true, HitPosition, HitNormal);
+
+    CHECK(!Lookup(cache, RayOrigin, RayDirection, RayTMax, RayEpoch));
+    CHECK(Lookup(cache, RayOrigin, RayDirection, RayTMax, RayEpoch + 1));
+    CHECK(cache.GetOccupancy().hitEntryCount == 1);
+}
+
+int main()
+{
+    TestGoldenEntry();
+    TestInsertLookup();
+    TestMiss();
+    TestChecksum();
+    TestSlotReplacement();
+
+    return ReportChecks();
+}
@@ -0,0 +1,178 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "check.h"
+#include "hiz.h"
+
+#include <vector>
+
+// Depth of the background behind all geometry
+static const float FarDepth = 1.f;
+// Depth of the geometry covering most of the test depth buffers
+static const float GeometryDepth = 0.5f;
+
+// Returns a row-major depth region filled with depth, except for the given texel which holds texelDepth
+static std::vector<float> CreateDepth(uint32_t width, uint32_t height, float depth, uint32_t texelX, uint32_t texelY, float texelDepth)
+{
+    std::vector<float> depths(width * height, depth);
+    depths[texelY * width + texelX] = texelDepth;
+    return depths;
+}
+
+static void TestMipSizes()
+{
+    uint32_t width, height;
+
+    // Mip 0 has half the resolution of the depth region
+    HiZPyramid::GetMipSize(8, 8, 0, width, height);
+    CHECK((width == 4) && (height == 4));
+    CHECK(HiZPyramid::GetMipCount(8, 8) == 3);
+
+    HiZPyramid::GetMipSize(5, 3, 0, width, height);
+    CHECK((width == 2) && (height == 1));
+    HiZPyramid::GetMipSize(5, 3, 1, width, height);
+    CHECK((width == 1) && (height == 1));
+    CHECK(HiZPyramid::GetMipCount(5, 3) == 2);
+
+    HiZPyramid::GetMipSize(7, 1, 0, width, height);
+    CHECK((width == 3) && (height == 1));
+    CHECK(HiZPyramid::GetMipCount(7, 1) == 2);
+
+    HiZPyramid::GetMipSize(1, 1, 0, width, height);
+    CHECK((width == 1) && (height == 1));
+    CHECK(HiZPyramid::GetMipCount(1, 1) == 1);
+}
+
+static void TestBuild()
+{
+    // 4x4 region with distinct depths, each mip keeps the farthest (largest) depth
+    std::vector<float> depths(16);
+    for (uint32_t i = 0; i < depths.size(); ++i)
+    {
+        depths[i] = static_cast<float>(i) / 16.f;
+    }
+
+    HiZPyramid pyramid;
+    pyramid.Build(depths.data(), 4, 4, false);
+
+    CHECK(pyramid.GetMipCount() == 2);
+    CHECK(pyramid.GetDepth(0, 0, 0) == 5.f / 16.f);
+    CHECK(pyramid.GetDepth(0, 1, 0) == 7.f / 16.f);
+    CHECK(pyramid.GetDepth(0, 0, 1) == 13.f / 16.f);
+    CHECK(pyramid.GetDepth(0, 1, 1) == 15.f / 16.f);
+    CHECK(pyramid.GetDepth(1, 0, 0) == 15.f / 16.f);
+
+    // Inverted depth keeps the smallest depth
+    pyramid.Build(depths.data(), 4, 4, true);
+
+    CHECK(pyramid.GetDepth(0, 0, 0) == 0.f);
+    CHECK(pyramid.GetDepth(0, 1, 0) == 2.f / 16.f);
+    CHECK(pyramid.GetDepth(0, 0, 1) == 8.f / 16.f);
+    CHECK(pyramid.GetDepth(0, 1, 1) == 10.f / 16.f);
+    CHECK(pyramid.GetDepth(1, 0, 0) == 0.f);
+}
+
+static void TestBuildOddSize()
+{
+    // Last column & row of an odd-sized region are covered by the last texel of mip 0
+    const std::vector<float> lastColumn = CreateDepth(5, 3, GeometryDepth, 4, 1, FarDepth);
+
+    HiZPyramid pyramid;
+    pyramid.Build(lastColumn.data(), 5, 3, false);
+
+    CHECK(pyramid.GetMipCount() == 2);
+    CHECK(pyramid.GetDepth(0, 0, 0) == GeometryDepth);
+    CHECK(pyramid.GetDepth(0, 1, 0) == FarDepth);
+    CHECK(pyramid.GetDepth(1, 0, 0) == FarDepth);
+
+    const std::vector<float> lastRow = CreateDepth(5, 3, GeometryDepth, 0, 2, FarDepth);
+    pyramid.Build(lastRow.data(), 5, 3, false);
+
+    CHECK(pyramid.GetDepth(0, 0, 0) == FarDepth);
+    CHECK(pyramid.GetDepth(0, 1, 0) == GeometryDepth);
+
+    // Odd-sized mips propagate the remaining texel as well
+    const std::vector<float> corner = CreateDepth(7, 7, GeometryDepth, 6, 6, FarDepth);
+    pyramid.Build(corner.data(), 7, 7, false);
+
+    CHECK(pyramid.GetMipCount() == 2);
+    CHECK(pyramid.GetDepth(0, 2, 2) == FarDepth);
+    CHECK(pyramid.GetDepth(0, 1, 1) == GeometryDepth);
+    CHECK(pyramid.GetDepth(1, 0, 0) == FarDepth);
+}
+
+static void TestIsOccluded()
+{
+    // Geometry covers the whole 8x8 region except for background in its bottom right texel
+    const std::vector<float> depths = CreateDepth(8, 8, GeometryDepth, 7, 7, FarDepth);
+
+    HiZPyramid pyramid;
+    CHECK(!pyramid.IsOccluded(0.f, 0.f, 1.f, 1.f, FarDepth));
+
+    pyramid.Build(depths.data(), 8, 8, false);
+
+    // Rectangles behind the geometry are occluded, rectangles in front of it or overlapping the background are not
+    CHECK(pyramid.IsOccluded(0.f, 0.f, 0.25f, 0.25f, 0.6f));
+    CHECK(!pyramid.IsOccluded(0.f, 0.f, 0.25f, 0.25f, 0.4f));
+    CHECK(!pyramid.IsOccluded(0.f, 0.f, 1.f, 1.f, 0.6f));
+    CHECK(!pyramid.IsOccluded(0.9f, 0.9f, 0.95f, 0.95f, 0.6f));
+    CHECK(pyramid.IsOccluded(0.3f, 0.3f, 0.45f, 0.45f, 0.6f));
+
+    // Larger rectangles select a coarser mip, whose texels may also cover the background
+    CHECK(!pyramid.IsOccluded(0.3f, 0.3f, 0.6f, 0.6f, 0.6f));
+
+    // Rectangles outside of the screen are clamped to its border
+    CHECK(!pyramid.IsOccluded(1.1f, 1.1f, 1.2f, 1.2f, 0.6f));
+    CHECK(pyramid.IsOccluded(-0.2f, -0.2f, -0.1f, -0.1f, 0.6f));
+
+    // Same scene with inverted depth
+    const std::vector<float> invertedDepths = CreateDepth(8, 8, 1.f - GeometryDepth, 7, 7, 1.f - FarDepth);
+    pyramid.Build(invertedDepths.data(), 8, 8, true);
+
+    CHECK(pyramid.IsOccluded(0.f, 0.f, 0.25f, 0.25f, 0.4f));
+    CHECK(!pyramid.IsOccluded(0.f, 0.f, 0.25f, 0.25f, 0.6f));
+    CHECK(!pyramid.IsOccluded(0.f, 0.f, 1.f, 1.f, 0.4f));
+    CHECK(!pyramid.IsOccluded(0.9f, 0.9f, 0.95f, 0.95f, 0.4f));
+}
+
+static void TestIsOccludedOddSize()
+{
+    // Background in the last column of a 5x3 region is only covered by the enlarged last texel of mip 0
+    const std::vector<float> depths = CreateDepth(5, 3, GeometryDepth, 4, 1, FarDepth);
+
+    HiZPyramid pyramid;
+    pyramid.Build(depths.data(), 5, 3, false);
+
+    CHECK(!pyramid.IsOccluded(0.85f, 0.f, 1.f, 0.3f, 0.6f));
+    CHECK(pyramid.IsOccluded(0.f, 0.f, 0.3f, 0.3f, 0.6f));
+    CHECK(!pyramid.IsOccluded(0.f, 0.f, 1.f, 1.f, 0.6f));
+}
+
+int main()
+{
+    TestMipSizes();
+    TestBuild();
+    TestBuildOddSize();
+    TestIsOccluded();
+    TestIsOccludedOddSize();
+
+    return ReportChecks();
+}
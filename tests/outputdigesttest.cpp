@@ -0,0 +1,210 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "check.h"
+#include "outputdigest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+// Seeds of IVY_OUTPUT_DIGEST_STEM & IVY_OUTPUT_DIGEST_LEAF
+static const uint32_t OutputDigestStem = 1;
+static const uint32_t OutputDigestLeaf = 2;
+
+// Rows of known stem & leaf transforms: identity, translation, rotation about y with translation, stem scale
+static const float IdentityTransform[3][4]    = {{1.f, 0.f, 0.f, 0.f}, {0.f, 1.f, 0.f, 0.f}, {0.f, 0.f, 1.f, 0.f}};
+static const float TranslationTransform[3][4] = {{1.f, 0.f, 0.f, 1.f}, {0.f, 1.f, 0.f, 2.f}, {0.f, 0.f, 1.f, 3.f}};
+static const float RotationTransform[3][4]    = {{0.f, 0.f, 1.f, 0.5f}, {0.f, 1.f, 0.f, -1.25f}, {-1.f, 0.f, 0.f, 4.f}};
+static const float ScaleTransform[3][4]       = {{0.75f, 0.f, 0.f, 0.f}, {0.f, 1.f, 0.f, 0.f}, {0.f, 0.f, 1.f, 0.f}};
+
+// Root digests of the roots built by GetRootDigests, as stored in the golden file passed as first argument
+static const std::vector<uint64_t> GoldenRootDigests = {
+    0xe963498d195eb91cull, 0x8d35cb780a126c92ull, 0ull, 0x5daa7dd995becd7aull, 0x4659db9e7eb69994ull};
+// Frame digest of GoldenRootDigests
+static const uint64_t GoldenFrameDigest = 0x2c84cac7c3b4f311ull;
+
+// Sums the transform digests of each root, same as AddOutputDigest in common.hlsl
+static std::vector<uint64_t> GetRootDigests()
+{
+    return {
+        // Single stem & single leaf with the same transform
+        GetOutputDigest(IdentityTransform, OutputDigestStem),
+        GetOutputDigest(IdentityTransform, OutputDigestLeaf),
+        // Root without any output
+        0,
+        GetOutputDigest(TranslationTransform, OutputDigestStem) + GetOutputDigest(RotationTransform, OutputDigestLeaf),
+        GetOutputDigest(RotationTransform, OutputDigestStem) + GetOutputDigest(ScaleTransform, OutputDigestStem) +
+            GetOutputDigest(TranslationTransform, OutputDigestLeaf),
+    };
+}
+
+static std::string ReadFile(const std::string& fileName)
+{
+    std::ifstream     file(fileName, std::ios::in);
+    std::stringstream stream;
+    stream << file.rdbuf();
+    return stream.str();
+}
+
+static void WriteFile(const std::string& fileName, const std::string& contents)
+{
+    std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+    file << contents;
+}
+
+static void TestGetOutputDigest()
+{
+    // Digests of single transforms, as computed by GetOutputDigest in common.hlsl
+    CHECK(GetOutputDigest(IdentityTransform, OutputDigestStem) == 0xe963498d195eb91cull);
+    CHECK(GetOutputDigest(IdentityTransform, OutputDigestLeaf) == 0x8d35cb780a126c92ull);
+    CHECK(GetOutputDigest(TranslationTransform, OutputDigestStem) == 0xc8142b43f15aec39ull);
+
+    CHECK(GetRootDigests() == GoldenRootDigests);
+
+    // Root digests don't depend on output order
+    CHECK(GetOutputDigest(ScaleTransform, OutputDigestStem) + GetOutputDigest(TranslationTransform, OutputDigestLeaf) +
+              GetOutputDigest(RotationTransform, OutputDigestStem) ==
+          GoldenRootDigests[4]);
+
+    // Every matrix element contributes to the digest, including the sign of zero
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int column = 0; column < 4; ++column)
+        {
+            float transform[3][4];
+            memcpy(transform, IdentityTransform, sizeof(transform));
+            transform[row][column] = (transform[row][column] == 0.f) ? -0.f : 0.999f;
+
+            CHECK(GetOutputDigest(transform, OutputDigestStem) != GoldenRootDigests[0]);
+        }
+    }
+}
+
+static void TestCombineOutputDigests()
+{
+    CHECK(CombineOutputDigests({}) == 0);
+    CHECK(CombineOutputDigests(GoldenRootDigests) == GoldenFrameDigest);
+
+    // Frame digest depends on root order & root count
+    CHECK(CombineOutputDigests({1, 2}) != CombineOutputDigests({2, 1}));
+    CHECK(CombineOutputDigests({0}) != CombineOutputDigests({0, 0}));
+    CHECK(CombineOutputDigests({0}) != CombineOutputDigests({}));
+}
+
+static void TestReadGolden(const std::string& goldenFileName)
+{
+    std::vector<uint64_t> rootDigests;
+    CHECK(ReadOutputDigests(goldenFileName, rootDigests));
+    CHECK(rootDigests == GoldenRootDigests);
+}
+
+static void TestRoundTrip(const std::string& goldenFileName)
+{
+    const std::string fileName = "OutputDigestTest_RoundTrip.txt";
+
+    // Written file has to match the golden file byte by byte, such that golden files stay valid
+    CHECK(WriteOutputDigests(fileName, GoldenRootDigests));
+    CHECK(ReadFile(fileName) == ReadFile(goldenFileName));
+
+    std::vector<uint64_t> rootDigests;
+    CHECK(ReadOutputDigests(fileName, rootDigests));
+    CHECK(rootDigests == GoldenRootDigests);
+
+    // Empty digest sets round-trip as well
+    CHECK(WriteOutputDigests(fileName, {}));
+    CHECK(ReadOutputDigests(fileName, rootDigests));
+    CHECK(rootDigests.empty());
+
+    std::remove(fileName.c_str());
+}
+
+static void TestReadInvalid()
+{
+    const std::string fileName = "OutputDigestTest_Invalid.txt";
+
+    CHECK(WriteOutputDigests(fileName, GoldenRootDigests));
+
+    const std::string valid           = ReadFile(fileName);
+    const size_t      lastDigestStart = valid.rfind('\n', valid.size() - 2) + 1;
+
+    // Failed reads leave the digests untouched
+    const std::vector<uint64_t> previousDigests = {7};
+    std::vector<uint64_t>       rootDigests     = previousDigests;
+
+    CHECK(!ReadOutputDigests("OutputDigestTest_Missing.txt", rootDigests));
+    CHECK(rootDigests == previousDigests);
+
+    // Wrong header
+    WriteFile(fileName, "IvyOutputDigests 0" + valid.substr(valid.find('\n')));
+    CHECK(!ReadOutputDigests(fileName, rootDigests));
+    CHECK(rootDigests == previousDigests);
+
+    // Modified root digest no longer matches the frame digest
+    std::string modified      = valid;
+    modified[lastDigestStart] = (modified[lastDigestStart] == '3') ? '4' : '3';
+    WriteFile(fileName, modified);
+    CHECK(!ReadOutputDigests(fileName, rootDigests));
+    CHECK(rootDigests == previousDigests);
+
+    // Truncated root digests
+    WriteFile(fileName, valid.substr(0, lastDigestStart));
+    CHECK(!ReadOutputDigests(fileName, rootDigests));
+    CHECK(rootDigests == previousDigests);
+
+    std::remove(fileName.c_str());
+}
+
+static void TestCompareOutputDigests()
+{
+    CHECK(CompareOutputDigests(GoldenRootDigests, GoldenRootDigests).empty());
+    CHECK(CompareOutputDigests({}, {}).empty());
+
+    std::vector<uint64_t> rootDigests = GoldenRootDigests;
+    rootDigests[1] += 1;
+    rootDigests[4] += 1;
+    CHECK(CompareOutputDigests(rootDigests, GoldenRootDigests) == std::vector<uint32_t>({1, 4}));
+
+    // Roots which only exist in one of both sets are mismatches
+    CHECK(CompareOutputDigests({GoldenRootDigests[0]}, GoldenRootDigests) == std::vector<uint32_t>({1, 2, 3, 4}));
+    CHECK(CompareOutputDigests(GoldenRootDigests, {GoldenRootDigests[0], GoldenRootDigests[1]}) == std::vector<uint32_t>({2, 3, 4}));
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 2)
+    {
+        std::printf("Usage: OutputDigestTest <golden digest file>\n");
+        return 1;
+    }
+
+    const std::string goldenFileName = argv[1];
+
+    TestGetOutputDigest();
+    TestCombineOutputDigests();
+    TestReadGolden(goldenFileName);
+    TestRoundTrip(goldenFileName);
+    TestReadInvalid();
+    TestCompareOutputDigests();
+
+    return ReportChecks();
+}
@@ -0,0 +1,222 @@
+// This file is part of the AMD Work Graph Ivy Generation Sample.
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "check.h"
+#include "ringallocator.h"
+
+#include <cstring>
+#include <deque>
+#include <vector>
+
+// Ring of the same size as the RT info upload ring, scaled down
+static const size_t RingSize = 1024;
+
+// Ring allocator driven the same way as by UploadRing: uploads are split into chunks of at most the maximum allocation size,
+// and the oldest submission is waited for whenever the ring is full. Tracks which ring bytes are in flight to detect overlaps.
+class UploadRingModel
+{
+public:
+    UploadRingModel()
+        : m_Allocator(RingSize)
+        , m_InFlight(RingSize, false)
+    {
+    }
+
+    void Upload(size_t sizeInBytes)
+    {
+        while (sizeInBytes > 0)
+        {
+            const size_t chunkSize = std::min(sizeInBytes, m_Allocator.GetMaxAllocationSize());
+
+            size_t offset, usedBytes;
+            while (!m_Allocator.Allocate(chunkSize, offset, usedBytes))
+            {
+                if (m_Recorded.usedBytes > 0)
+                {
+                    Submit();
+                }
+
+                // UploadRing asserts instead of waiting on an empty submission list
+                CHECK(!m_Submissions.empty());
+                if (m_Submissions.empty())
+                {
+                    return;
+                }
+
+                WaitForOldestSubmission();
+            }
+
+            CHECK(offset + chunkSize <= RingSize);
+            for (size_t i = offset; i < offset + chunkSize; ++i)
+            {
+                CHECK(!m_InFlight[i]);
+                m_InFlight[i] = true;
+            }
+
+            m_Recorded.usedBytes += usedBytes;
+            m_Recorded.ranges.push_back({offset, chunkSize});
+            ++m_ChunkCount;
+
+            sizeInBytes -= chunkSize;
+        }
+    }
+
+    void Submit()
+    {
+        if (m_Recorded.usedBytes > 0)
+        {
+            m_Submissions.push_back(m_Recorded);
+            m_Recorded = {};
+        }
+    }
+
+    void WaitForOldestSubmission()
+    {
+        const Submission submission = m_Submissions.front();
+        m_Submissions.pop_front();
+
+        for (const auto& range : submission.ranges)
+        {
+            std::fill(m_InFlight.begin() + range.first, m_InFlight.begin() + range.first + range.second, false);
+        }
+
+        m_Allocator.Free(submission.usedBytes);
+    }
+
+    void Drain()
+    {
+        Submit();
+        while (!m_Submissions.empty())
+        {
+            WaitForOldestSubmission();
+        }
+    }
+
+    const RingAllocator& GetAllocator() const { return m_Allocator; }
+    size_t               GetChunkCount() const { return m_ChunkCount; }
+
+private:
+    struct Submission
+    {
+        size_t                                 usedBytes = 0;
+        std::vector<std::pair<size_t, size_t>> ranges;
+    };
+
+    RingAllocator          m_Allocator;
+    std::vector<bool>      m_InFlight;
+    Submission             m_Recorded;
+    std::deque<Submission> m_Submissions;
+    size_t                 m_ChunkCount = 0;
+};
+
+static void TestAllocate()
+{
+    RingAllocator allocator(RingSize);
+    CHECK(allocator.GetMaxAllocationSize() == RingSize / 2);
+
+    size_t offset, usedBytes;
+    CHECK(allocator.Allocate(100, offset, usedBytes));
+    CHECK((offset == 0) && (usedBytes == 100));
+    CHECK(allocator.Allocate(400, offset, usedBytes));
+    CHECK((offset == 100) && (usedBytes == 400));
+
+    CHECK(allocator.Allocate(512, offset, usedBytes));
+    CHECK((offset == 500) && (usedBytes == 512));
+
+    // 100 bytes don't fit in front of the remaining 12 bytes at the end of the ring, nor in front of the first allocation
+    CHECK(!allocator.Allocate(100, offset, usedBytes));
+    CHECK(allocator.GetUsedBytes() == 1012);
+
+    // Wrapping allocations are accounted the skipped bytes at the end of the ring
+    allocator.Free(100);
+    CHECK(allocator.Allocate(100, offset, usedBytes));
+    CHECK((offset == 0) && (usedBytes == 112));
+    CHECK(allocator.GetUsedBytes() == RingSize);
+    CHECK(!allocator.Allocate(1, offset, usedBytes));
+
+    // Freed bytes of the second allocation are reused behind the wrapped allocation
+    allocator.Free(400);
+    CHECK(allocator.Allocate(300, offset, usedBytes));
+    CHECK((offset == 100) && (usedBytes == 300));
+}
+
+static void TestDrainedRingRestarts()
+{
+    RingAllocator allocator(RingSize);
+
+    size_t offset, usedBytes;
+    CHECK(allocator.Allocate(300, offset, usedBytes));
+    CHECK(allocator.Allocate(300, offset, usedBytes));
+    allocator.Free(600);
+
+    // Once drained, the ring starts over, thus a maximum size allocation fits without skipping bytes
+    CHECK(allocator.GetUsedBytes() == 0);
+    CHECK(allocator.Allocate(allocator.GetMaxAllocationSize(), offset, usedBytes));
+    CHECK((offset == 0) && (usedBytes == allocator.GetMaxAllocationSize()));
+}
+
+static void TestUploadsLargerThanRing()
+{
+    UploadRingModel ring;
+
+    // Small upload in flight, followed by two uploads larger than the whole ring
+    ring.Upload(100);
+    ring.Submit();
+    ring.Upload(RingSize + 300);
+    ring.Upload(RingSize * 3);
+    ring.Drain();
+
+    CHECK(ring.GetChunkCount() == 1 + 3 + 6);
+    CHECK(ring.GetAllocator().GetUsedBytes() == 0);
+
+    // Same after the ring drained completely
+    ring.Upload(RingSize * 2);
+    ring.Upload(RingSize * 2);
+    ring.Drain();
+
+    CHECK(ring.GetChunkCount() == 1 + 3 + 6 + 4 + 4);
+    CHECK(ring.GetAllocator().GetUsedBytes() == 0);
+}
+
+static void TestUploadsOfMaximumSize()
+{
+    UploadRingModel ring;
+
+    // Uploads of odd sizes leave the head at arbitrary positions, which never blocks a maximum size upload
+    for (size_t size = 1; size < RingSize; size += 37)
+    {
+        ring.Upload(size);
+        ring.Upload(ring.GetAllocator().GetMaxAllocationSize());
+    }
+
+    ring.Drain();
+    CHECK(ring.GetAllocator().GetUsedBytes() == 0);
+}
+
+int main()
+{
+    TestAllocate();
+    TestDrainedRingRestarts();
+    TestUploadsLargerThanRing();
+    TestUploadsOfMaximumSize();
+
+    return ReportChecks();
+}